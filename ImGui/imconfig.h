@@ -55,6 +55,14 @@
 //---- Use 32-bit for ImWchar (default is 16-bit) to support unicode planes 1-16. (e.g. point beyond 0xFFFF like emoticons, dingbats, symbols, shapes, ancient languages, etc...)
 //#define IMGUI_USE_WCHAR32
 
+//---- Use a faster hash for IDs (ImHashData/ImHashStr) instead of CRC32. IDs will differ from the default ones, e.g. [Table] settings saved in .ini files by other builds won't be found.
+// The default CRC32 uses the ARMv8 CRC32 instructions when enabled by the compiler (e.g. -march=armv8-a+crc), lookup tables otherwise.
+//#define IMGUI_USE_FAST_HASH
+
+//---- Override the ImVector<> growth policy: capacity to grow to when a vector of capacity _CAP is full (default: x1.5, starting at 8).
+// Larger factors reallocate less often while buffers settle, at the cost of more unused memory. Use the Metrics window "Memory" section to see how often buffers reallocate.
+//#define IM_VECTOR_GROW_CAPACITY(_CAP)   ((_CAP) ? (_CAP) * 2 : 16)
+
 //---- Avoid multiple STB libraries implementations, or redefine path/filenames to prioritize another version
 // By default the embedded implementations are declared static and not available outside of Dear ImGui sources files.
 //#define IMGUI_STB_TRUETYPE_FILENAME   "my_folder/stb_truetype.h"
@@ -75,6 +83,9 @@
 // The only purpose of this define is if you want force compilation of the stb_truetype backend ALONG with the FreeType backend.
 //#define IMGUI_ENABLE_STB_TRUETYPE
 
+//---- Allow ImFontAtlas::Build() to rasterize glyphs on multiple threads (see ImFontAtlas::BuildThreadsCount). Uses std::thread.
+//#define IMGUI_ENABLE_FONT_BUILD_THREADS
+
 //---- Define constructor and implicit cast operators to convert back<>forth between your math types and ImVec2/ImVec4.
 // This will be inlined as part of ImVec2 and ImVec4 class declarations.
 /*
@@ -90,7 +101,7 @@
 //---- Use 32-bit vertex indices (default is 16-bit) is one way to allow large meshes with more than 64K vertices.
 // Your renderer backend will need to support it (most example renderer backends support both 16/32-bit indices).
 // Another way to allow large meshes while keeping 16-bit indices is to handle ImDrawCmd::VtxOffset in your renderer.
-// Read about ImGuiBackendFlags_RendererHasVtxOffset for details.
+// Read about ImGuiBackendFlags_RendererHasVtxOffset for details: all backends in this tree support it, so 16-bit indices only cost one extra draw call every 64K vertices.
 //#define ImDrawIdx unsigned int
 
 //---- Override ImDrawCallback signature (will need to modify renderer backends accordingly)
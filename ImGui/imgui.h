@@ -140,9 +140,11 @@ struct ImDrawListSplitter;          // Helper to split a draw list into differen
 struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
+struct ImFontAtlasDynamicData;      // Opaque storage used to rasterize glyphs on demand (ImFontAtlasFlags_DynamicGlyphs)
 struct ImFontBuilderIO;             // Opaque interface to a font builder (stb_truetype or FreeType).
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
+struct ImFontKerningPair;           // Distance adjustment between two glyphs of a font
 struct ImFontGlyphRangesBuilder;    // Helper to build glyph ranges from text/string data
 struct ImColor;                     // Helper functions to create a color that can be converted to either u32 or float4 (*OBSOLETE* please avoid using)
 struct ImGuiContext;                // Dear ImGui context (opaque structure, unless including imgui_internal.h)
@@ -1405,7 +1407,9 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasGamepad            = 1 << 0,   // Backend Platform supports gamepad and currently has one connected.
     ImGuiBackendFlags_HasMouseCursors       = 1 << 1,   // Backend Platform supports honoring GetMouseCursor() value to change the OS cursor shape.
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if ImGuiConfigFlags_NavEnableSetMousePos is set).
-    ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3    // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasSdfFonts   = 1 << 4,   // Backend Renderer draws the font texture of an atlas built with ImFontAtlasFlags_SDF as distance fields.
+    ImGuiBackendFlags_RendererHasTexUpdates = 1 << 5    // Backend Renderer uploads the sub-rectangles listed in ImFontAtlas::TexUpdates[] before rendering. Needed by ImFontAtlasFlags_DynamicGlyphs.
 };
 
 // Enumeration for PushStyleColor() / PopStyleColor()
@@ -1647,8 +1651,13 @@ template<typename T> void IM_DELETE(T* p)   { if (p) { p->~T(); ImGui::MemFree(p
 // - Important: clear() frees memory, resize(0) keep the allocated buffer. We use resize(0) a lot to intentionally recycle allocated buffers across frames and amortize our costs.
 // - Important: our implementation does NOT call C++ constructors/destructors, we treat everything as raw data! This is intentional but be extra mindful of that,
 //   Do NOT use this class as a std::vector replacement in your own code! Many of the structures used by dear imgui can be safely initialized by a zero-memset.
+// - The growth policy can be overridden by defining IM_VECTOR_GROW_CAPACITY() in imconfig.h.
 //-----------------------------------------------------------------------------
 
+#ifndef IM_VECTOR_GROW_CAPACITY
+#define IM_VECTOR_GROW_CAPACITY(_CAP)       ((_CAP) ? ((_CAP) + (_CAP) / 2) : 8)
+#endif
+
 IM_MSVC_RUNTIME_CHECKS_OFF
 template<typename T>
 struct ImVector
@@ -1687,7 +1696,7 @@ struct ImVector
     inline const T&     back() const                        { IM_ASSERT(Size > 0); return Data[Size - 1]; }
     inline void         swap(ImVector<T>& rhs)              { int rhs_size = rhs.Size; rhs.Size = Size; Size = rhs_size; int rhs_cap = rhs.Capacity; rhs.Capacity = Capacity; Capacity = rhs_cap; T* rhs_data = rhs.Data; rhs.Data = Data; Data = rhs_data; }
 
-    inline int          _grow_capacity(int sz) const        { int new_capacity = Capacity ? (Capacity + Capacity / 2) : 8; return new_capacity > sz ? new_capacity : sz; }
+    inline int          _grow_capacity(int sz) const        { int new_capacity = IM_VECTOR_GROW_CAPACITY(Capacity); return new_capacity > sz ? new_capacity : sz; }
     inline void         resize(int new_size)                { if (new_size > Capacity) reserve(_grow_capacity(new_size)); Size = new_size; }
     inline void         resize(int new_size, const T& v)    { if (new_size > Capacity) reserve(_grow_capacity(new_size)); if (new_size > Size) for (int n = Size; n < new_size; n++) memcpy(&Data[n], &v, sizeof(v)); Size = new_size; }
     inline void         shrink(int new_size)                { IM_ASSERT(new_size <= Size); Size = new_size; } // Resize a vector to a smaller size, guaranteed not to cause a reallocation
@@ -1807,6 +1816,9 @@ struct ImGuiIO
     bool        ConfigWindowsResizeFromEdges;   // = true           // Enable resizing of windows from their edges and from the lower-left corner. This requires (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors) because it needs mouse cursor feedback. (This used to be a per-window ImGuiWindowFlags_ResizeFromAnySide flag)
     bool        ConfigWindowsMoveFromTitleBarOnly; // = false       // Enable allowing to move windows only when clicking on their title bar. Does not apply to windows without a title bar.
     float       ConfigMemoryCompactTimer;       // = 60.0f          // Timer (in seconds) to free transient windows/tables memory buffers when unused. Set to -1.0f to disable.
+    bool        ConfigMemoryCompactHysteresis;  // = true           // Double the timer of a window (up to x8) each time it reappears less than ConfigMemoryCompactTimer seconds after being compacted, halve it when it reappears later. Avoids freeing and reallocating the buffers of windows which come and go.
+    int         ConfigMemoryCompactMinBytes;    // = 0              // Windows keep their draw list buffers when compacted if they use less than this amount of memory. Freeing small buffers saves little and costs reallocations when the window reappears.
+    bool        ConfigTextLayoutCache;          // = false          // Remember the size and glyph quads of short strings drawn again with the same font, size and wrap width, so that repeated labels are copied instead of laid out again. Unused entries are dropped after a few frames.
 
     //------------------------------------------------------------------
     // Platform Functions
@@ -1870,7 +1882,9 @@ struct ImGuiIO
     int         MetricsRenderIndices;           // Indices output during last call to Render() = number of triangles * 3
     int         MetricsRenderWindows;           // Number of visible windows
     int         MetricsActiveWindows;           // Number of active windows
-    int         MetricsActiveAllocations;       // Number of active allocations, updated by MemAlloc/MemFree based on current context. May be off if you have multiple imgui contexts.
+    int         MetricsActiveAllocations;       // Number of active allocations, updated (atomically) by MemAlloc/MemFree based on current context. May be off if you have multiple imgui contexts.
+    int         MetricsFrameAllocations;        // Number of MemAlloc() calls during the previous frame (from one NewFrame() to the next), based on current context. A static UI should settle at 0.
+    int         MetricsFrameFrees;              // Number of MemFree() calls during the previous frame, based on current context.
     ImVec2      MouseDelta;                     // Mouse delta. Note that this is zero if either current or previous position are invalid (-FLT_MAX,-FLT_MAX), so a disappearing/reappearing mouse won't have a huge delta.
 
     //------------------------------------------------------------------
@@ -2031,6 +2045,7 @@ struct ImGuiTextFilter
     bool                IsActive() const { return !Filters.empty(); }
 
     // [Internal]
+    void                BuildMatcher();
     struct ImGuiTextRange
     {
         const char*     b;
@@ -2044,6 +2059,15 @@ struct ImGuiTextFilter
     char                    InputBuf[256];
     ImVector<ImGuiTextRange>Filters;
     int                     CountGrep;
+
+    // [Internal] Multi-pattern matcher (Aho-Corasick automaton on case folded bytes), built when there are more than a few terms so that PassFilter() reads the text once.
+    // One block, empty when not built:
+    // - unsigned char Class[256]: byte -> class (0 for bytes which are not part of any term)
+    // - int Next[MatcherStatesCount * MatcherClassCount]: [state * MatcherClassCount + class] -> (next_state * MatcherClassCount) << 1, | 1 if First[next_state] != -1
+    // - ImS16 First[MatcherStatesCount]: [state] -> index of the first term of Filters[] found when reaching this state, or -1
+    ImVector<unsigned char> Matcher;
+    int                     MatcherClassCount;      // 0 when not built
+    int                     MatcherStatesCount;
 };
 
 // Helper: Growable text buffer for logging/accumulating text
@@ -2070,7 +2094,7 @@ struct ImGuiTextBuffer
 // Helper: Key->Value storage
 // Typically you don't have to worry about this since a storage is held within each Window.
 // We use it to e.g. store collapse state for a tree (Int 0/1)
-// This is optimized for efficient lookup (dichotomy into a contiguous buffer) and rare insertion (typically tied to user interactions aka max once a frame)
+// This is optimized for efficient lookup and insertion (open-addressing hash index into a contiguous buffer), so large trees with thousands of nodes stay cheap.
 // You can use it as custom user storage for temporary values. Declare your own storage if, for example:
 // - You want to manipulate the open/close state of a particular sub-tree in your interface (tree node uses Int 0/1 to store their state).
 // - You want to store custom debug data easily without adding or editing structures in your code (probably not efficient, but convenient)
@@ -2086,13 +2110,20 @@ struct ImGuiStorage
         ImGuiStoragePair(ImGuiID _key, float _val_f)    { key = _key; val_f = _val_f; }
         ImGuiStoragePair(ImGuiID _key, void* _val_p)    { key = _key; val_p = _val_p; }
     };
+    struct ImGuiStorageSlot
+    {
+        ImGuiID key;
+        int     index;      // Index into Data, -1 for an empty slot
+    };
 
-    ImVector<ImGuiStoragePair>      Data;
+    ImVector<ImGuiStoragePair>      Data;           // Pairs in insertion order (sorted by key after BuildSortByKey()). Iterate this one.
+    ImVector<ImGuiStorageSlot>      Slots;          // Hash index into Data: linear probing, power of two size, at most half full. Empty while Data is small enough to be scanned.
+    int                             SlotsCount;     // Number of pairs in Slots. When Data was modified directly (e.g. filled before BuildSortByKey()), Slots are rebuilt on next access.
 
-    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
-    // - Set***() functions find pair, insertion on demand if missing.
-    // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
-    void                Clear() { Data.clear(); }
+    // - Get***() functions find pair, never add/allocate. A query is O(1): a linear scan of small storages, a hash index lookup otherwise.
+    // - Set***() functions find pair, insertion on demand if missing. Insertion appends to Data, O(1) amortized.
+    ImGuiStorage()      { SlotsCount = 0; }
+    void                Clear() { Data.clear(); Slots.clear(); SlotsCount = 0; }
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -2114,7 +2145,7 @@ struct ImGuiStorage
     // Use on your own storage if you know only integer are being stored (open/close all tree nodes)
     IMGUI_API void      SetAllInt(int val);
 
-    // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
+    // Sort Data by key, e.g. to iterate it in a stable order. You may also add all your contents to Data directly and then call this once.
     IMGUI_API void      BuildSortByKey();
 };
 
@@ -2333,7 +2364,8 @@ enum ImDrawListFlags_
     ImDrawListFlags_AntiAliasedLines        = 1 << 0,  // Enable anti-aliased lines/borders (*2 the number of triangles for 1.0f wide line or lines thin enough to be drawn using textures, otherwise *3 the number of triangles)
     ImDrawListFlags_AntiAliasedLinesUseTex  = 1 << 1,  // Enable anti-aliased lines/borders using textures when possible. Require backend to render with bilinear filtering.
     ImDrawListFlags_AntiAliasedFill         = 1 << 2,  // Enable anti-aliased edge around filled shapes (rounded rectangles, circles).
-    ImDrawListFlags_AllowVtxOffset          = 1 << 3   // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_AllowVtxOffset          = 1 << 3,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_TextLayoutCache         = 1 << 4   // Reuse text layouts stored in the shared data. Set by ImGui on the draw lists it owns when 'io.ConfigTextLayoutCache' is enabled. The cache isn't thread-safe: never set it on lists built by worker threads.
 };
 
 // Draw command list
@@ -2398,11 +2430,20 @@ struct ImDrawList
     IMGUI_API void  AddNgonFilled(const ImVec2& center, float radius, ImU32 col, int num_segments);
     IMGUI_API void  AddText(const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end = NULL);
     IMGUI_API void  AddText(const ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end = NULL, float wrap_width = 0.0f, const ImVec4* cpu_fine_clip_rect = NULL);
+    IMGUI_API void  AddGlyphRun(const ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const ImWchar* glyphs, const ImVec2* offsets, int glyphs_count); // Pre-positioned glyphs (e.g. from a text shaper), see ImFont::RenderGlyphs()
     IMGUI_API void  AddPolyline(const ImVec2* points, int num_points, ImU32 col, ImDrawFlags flags, float thickness);
     IMGUI_API void  AddConvexPolyFilled(const ImVec2* points, int num_points, ImU32 col); // Note: Anti-aliased filling requires points to be in clockwise order.
     IMGUI_API void  AddBezierCubic(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, ImU32 col, float thickness, int num_segments = 0); // Cubic Bezier (4 control points)
     IMGUI_API void  AddBezierQuadratic(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, ImU32 col, float thickness, int num_segments = 0);               // Quadratic Bezier (3 control points)
 
+    // Batched primitives
+    // - Same output as calling AddRectFilled()/AddLine()/AddText() once per element, including the draw commands split at 64K vertices with 16-bit indices.
+    // - AddRectsFilled()/AddLines() reserve buffers by chunks and write vertices in a tight loop, without the per-call overhead. AddTexts() is a convenience: glyph layout dominates, it isn't faster than AddText().
+    // - Inputs are parallel arrays of 'count' elements. Elements with a zero alpha color are skipped, like with the single versions.
+    IMGUI_API void  AddRectsFilled(const ImVec2* p_min, const ImVec2* p_max, const ImU32* cols, int count);                                  // Non-rounded
+    IMGUI_API void  AddLines(const ImVec2* p1, const ImVec2* p2, const ImU32* cols, int count, float thickness = 1.0f);
+    IMGUI_API void  AddTexts(const ImFont* font, float font_size, const ImVec2* pos, const ImU32* cols, const char* const* texts, int count); // NULL font/0.0f size: use current default (zero-terminated texts)
+
     // Image primitives
     // - Read FAQ to understand what ImTextureID is.
     // - "p_min" and "p_max" represent the upper-left and lower-right corners of the rectangle.
@@ -2428,6 +2469,17 @@ struct ImDrawList
     IMGUI_API void  AddDrawCmd();                                               // This is useful if you need to forcefully create a new draw call (to allow for dependent rendering / blending). Otherwise primitives are merged into the same draw-call as much as possible
     IMGUI_API ImDrawList* CloneOutput() const;                                  // Create a clone of the CmdBuffer/IdxBuffer/VtxBuffer.
 
+    // Advanced: Parallel building
+    // - Independent content (e.g. one list per window, or large batches for the background/foreground lists) can be generated on worker threads,
+    //   each into its own ImDrawList created with ImGui::GetDrawListSharedData(), then appended on the main thread with AddDrawList().
+    //   The result only depends on the order of the AddDrawList() calls, not on the order in which workers finish.
+    // - On the worker: call _ResetForNewFrame() then PushTextureID()/PushClipRect() (or PushClipRectFullScreen()) before drawing.
+    //   Workers must not call any ImGui:: function, and must run between NewFrame() and Render() (see ImDrawListSharedData for what is read-only).
+    // - Use the AddText() overload taking an explicit font: the default font of the shared data follows PushFont() on the main thread.
+    // - Workers allocate through ImGui::MemAlloc(): functions given to SetAllocatorFunctions() must be thread-safe (malloc/free are).
+    // - Not supported with ImFontAtlasFlags_DynamicGlyphs: text drawn on a worker could rasterize missing glyphs into the atlas (asserted here).
+    IMGUI_API void  AddDrawList(const ImDrawList* src);                         // Append commands/indices/vertices of 'src' after the current content. 'src' is left untouched.
+
     // Advanced: Channels
     // - Use to split render into layers. By switching channels to can render out-of-order (e.g. submit FG primitives before BG primitives)
     // - Use to minimize draw calls (e.g. if going back-and-forth between multiple clipping rectangles, prefer to append into separate channels then merge at the end)
@@ -2502,6 +2554,7 @@ struct ImFontConfig
     int             OversampleH;            // 3        // Rasterize at higher quality for sub-pixel positioning. Note the difference between 2 and 3 is minimal so you can reduce this to 2 to save memory. Read https://github.com/nothings/stb/blob/master/tests/oversample/README.md for details.
     int             OversampleV;            // 1        // Rasterize at higher quality for sub-pixel positioning. This is not really useful as we don't use sub-pixel positions on the Y axis.
     bool            PixelSnapH;             // false    // Align every glyph to pixel boundary. Useful e.g. if you are merging a non-pixel aligned font with the default font. If enabled, you can set OversampleH/V to 1.
+    bool            Kerning;                // false    // Apply the kerning pairs of the font ('kern' and GPOS tables). Pairs are looked up once at build time between the glyphs baked in the atlas (up to IM_FONTATLAS_BUILD_KERNING_MAX_GLYPHS per source font).
     ImVec2          GlyphExtraSpacing;      // 0, 0     // Extra spacing (in pixels) between glyphs. Only X axis is supported for now.
     ImVec2          GlyphOffset;            // 0, 0     // Offset all glyphs from this font input.
     const ImWchar*  GlyphRanges;            // NULL     // Pointer to a user-provided list of Unicode range (2 value per range, values are inclusive, zero-terminated list). THE ARRAY DATA NEEDS TO PERSIST AS LONG AS THE FONT IS ALIVE.
@@ -2531,6 +2584,14 @@ struct ImFontGlyph
     float           U0, V0, U1, V1;     // Texture coordinates
 };
 
+// Kerning pair, stored in ImFont::KerningPairs[] (an open-addressed hash table, Left == 0 marks an empty slot)
+struct ImFontKerningPair
+{
+    ImWchar         Left;               // Codepoint of the glyph on the left
+    ImWchar         Right;              // Codepoint of the glyph on the right
+    float           AdvanceX;           // Added to the distance between the two glyphs (usually negative), in pixels at ImFont::FontSize
+};
+
 // Helper to build glyph ranges from text/string data. Feed your application strings/characters to it then call BuildRanges().
 // This is essentially a tightly packed of vector of 64k booleans = 8KB storage.
 struct ImFontGlyphRangesBuilder
@@ -2560,13 +2621,24 @@ struct ImFontAtlasCustomRect
     bool IsPacked() const           { return X != 0xFFFF; }
 };
 
+// Sub-rectangle of the atlas texture modified after it was built, which the backend needs to upload again.
+// Only emitted with ImFontAtlasFlags_DynamicGlyphs. Read from ImFontAtlas::TexUpdates[] and clear it once uploaded.
+struct ImFontAtlasTexUpdate
+{
+    unsigned short  X, Y;           // Top-left corner, in pixels
+    unsigned short  Width, Height;  // Size, in pixels
+};
+
 // Flags for ImFontAtlas build
 enum ImFontAtlasFlags_
 {
     ImFontAtlasFlags_None               = 0,
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
-    ImFontAtlasFlags_NoBakedLines       = 1 << 2    // Don't build thick line textures into the atlas (save a little texture memory). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_DynamicGlyphs      = 1 << 3,   // Only bake Latin-1 up front, rasterize other glyphs of the requested ranges the first time they are used (stb_truetype builder only). See TexDynamicHeight and TexUpdates.
+    ImFontAtlasFlags_SDF                = 1 << 4,   // Store glyphs as signed distance fields, drawn sharp at any scale (stb_truetype builder only). Needs a renderer with ImGuiBackendFlags_RendererHasSdfFonts.
+    ImFontAtlasFlags_PackTight          = 1 << 5    // Try every texture width (or only TexDesiredWidth if set) with two packing heuristics and keep the smallest texture (stb_truetype builder only). Slower Build(), see TexPackedSurface. Best combined with ImFontAtlasFlags_NoPowerOfTwoHeight.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -2585,6 +2657,20 @@ enum ImFontAtlasFlags_
 // - Important: By default, AddFontFromMemoryTTF() takes ownership of the data. Even though we are not writing to it, we will free the pointer on destruction.
 //   You can set font_cfg->FontDataOwnedByAtlas=false to keep ownership of your data and it won't be freed,
 // - Even though many functions are suffixed with "TTF", OTF data is supported just as well.
+// Dynamic glyphs (Flags |= ImFontAtlasFlags_DynamicGlyphs):
+// - Large ranges (e.g. GetGlyphRangesChineseFull()) are not rasterized by Build(). Only codepoints < 0x100, the fallback and ellipsis characters are.
+//   Other glyphs are rasterized and packed into a reserved area of the texture (TexDynamicHeight) the first time ImFont::FindGlyph() misses.
+// - Each newly rasterized glyph is appended to TexUpdates[]: the backend uploads those sub-rectangles before rendering, then clears the list.
+// - This needs a renderer with ImGuiBackendFlags_RendererHasTexUpdates: without it, Build() clears ImFontAtlasFlags_DynamicGlyphs and rasterizes all
+//   the requested glyphs up front. So build the atlas of io.Fonts after initializing the renderer backend (it normally builds it itself).
+// - When the reserved area is full, the least recently used page of it is evicted. Pages used during the current frame are never evicted.
+// - The font data and CPU-side pixels need to stay around: don't call ClearInputData() or ClearTexData() after building.
+// - Glyphs may be rasterized between NewFrame() and Render(): don't build draw lists from other threads with such an atlas.
+// Distance field fonts (Flags |= ImFontAtlasFlags_SDF):
+// - The renderer rebuilds sharp glyph edges at any scale (ImFont::Scale, io.FontGlobalScale, SetWindowFontScale()): one font can replace several
+//   sizes of the same one, and a display size change doesn't need a rebuild. Add it at a size near the largest one it will be drawn at.
+// - The font texture must be drawn by a renderer converting distances to coverage (io.BackendFlags & ImGuiBackendFlags_RendererHasSdfFonts).
+// - OversampleH/OversampleV and RasterizerMultiply are ignored. Building sets ImFontAtlasFlags_NoBakedLines.
 // - This is an old API and it is currently awkward for those and and various other reasons! We will address them in the future!
 struct ImFontAtlas
 {
@@ -2609,7 +2695,14 @@ struct ImFontAtlas
     IMGUI_API bool              Build();                    // Build pixels data. This is called automatically for you by the GetTexData*** functions.
     IMGUI_API void              GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 1 byte per-pixel
     IMGUI_API void              GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 4 bytes-per-pixel
+    IMGUI_API void              GetTexDataAsBC4(unsigned char** out_blocks, int* out_width, int* out_height, int* out_size_in_bytes = NULL);      // 8 bytes per 4x4 block (BC4 / RGTC1 unsigned, single channel), encoded from the Alpha8 data. Not updated by ImFontAtlasFlags_DynamicGlyphs.
     bool                        IsBuilt() const             { return Fonts.Size > 0 && (TexPixelsAlpha8 != NULL || TexPixelsRGBA32 != NULL); }
+
+    // Prebuilt atlas cache: the output of a Build() (glyphs, texture pixels) saved to a binary file keyed by a hash of the font data and configuration.
+    // Call LoadCache() after adding the fonts: when it succeeds the atlas is built and stb_truetype is not involved. Otherwise call Build() then SaveCache().
+    // Files are only meant to be read back by the same binary. Not supported with ImFontAtlasFlags_DynamicGlyphs.
+    IMGUI_API bool              LoadCache(const char* filename);    // Return false if the file is missing, corrupted or was built from different fonts/settings.
+    IMGUI_API bool              SaveCache(const char* filename);
     void                        SetTexID(ImTextureID id)    { TexID = id; }
 
     //-------------------------------------------
@@ -2656,14 +2749,19 @@ struct ImFontAtlas
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0.
     bool                        Locked;             // Marked as Locked by ImGui::NewFrame() so attempt to modify the atlas will assert.
+    int                         BuildThreadsCount;  // Number of threads rasterizing glyphs in Build(), with the stb_truetype builder and IMGUI_ENABLE_FONT_BUILD_THREADS. 0 or 1: calling thread only. Output is identical whatever the count. Threads allocate memory through ImGui::MemAlloc(): functions given to SetAllocatorFunctions() must be thread-safe (malloc/free are).
+    int                         TexDynamicHeight;   // Height of the texture area reserved for glyphs rasterized on demand, with ImFontAtlasFlags_DynamicGlyphs. Defaults to 1024.
+    ImVector<ImFontAtlasTexUpdate> TexUpdates;      // Texture sub-rectangles modified since the backend last uploaded them, with ImFontAtlasFlags_DynamicGlyphs. Backend clears it.
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
     bool                        TexPixelsUseColors; // Tell whether our texture data is known to use colors (rather than just alpha channel), in order to help backend select a format.
     unsigned char*              TexPixelsAlpha8;    // 1 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight
     unsigned int*               TexPixelsRGBA32;    // 4 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight * 4
+    unsigned char*              TexPixelsBC4;       // 8 bytes per block of 4x4 pixels, blocks in row order. Total size = ((TexWidth + 3) / 4) * ((TexHeight + 3) / 4) * 8
     int                         TexWidth;           // Texture width calculated during Build().
     int                         TexHeight;          // Texture height calculated during Build().
+    int                         TexPackedSurface;   // Texture pixels covered by the rectangles packed during Build() (glyphs including their padding, custom rects). Occupancy is TexPackedSurface / (TexWidth * TexHeight).
     ImVec2                      TexUvScale;         // = (1.0f/TexWidth, 1.0f/TexHeight)
     ImVec2                      TexUvWhitePixel;    // Texture coordinates to a white pixel
     ImVector<ImFont*>           Fonts;              // Hold all the fonts returned by AddFont*. Fonts[0] is the default font upon calling ImGui::NewFrame(), use ImGui::PushFont()/PopFont() to change the current font.
@@ -2678,6 +2776,8 @@ struct ImFontAtlas
     // [Internal] Packing data
     int                         PackIdMouseCursors; // Custom texture rectangle ID for white pixel and mouse cursors
     int                         PackIdLines;        // Custom texture rectangle ID for baked anti-aliased lines
+    ImFontAtlasDynamicData*     DynamicData;        // Glyph rasterizer state kept after Build() with ImFontAtlasFlags_DynamicGlyphs
+    int                         GlyphsGeneration;   // Incremented whenever glyphs may have moved or changed (build, clear, dynamic page eviction). Invalidates cached text layouts.
 
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     typedef ImFontAtlasCustomRect    CustomRect;         // OBSOLETED in 1.72+
@@ -2685,19 +2785,24 @@ struct ImFontAtlas
 #endif
 };
 
+// Codepoints per page of the glyph index, see ImFont::IndexPages
+#define IM_FONT_INDEX_PAGE_SIZE     256
+
 // Font runtime data and rendering
 // ImFontAtlas automatically loads a default embedded font for you when you call GetTexDataAsAlpha8() or GetTexDataAsRGBA32().
 struct ImFont
 {
     // Members: Hot ~20/24 bytes (for CalcTextSize)
-    ImVector<float>             IndexAdvanceX;      // 12-16 // out //            // Sparse. Glyphs->AdvanceX in a directly indexable way (cache-friendly for CalcTextSize functions which only this this info, and are often bottleneck in large UI).
+    ImVector<float>             IndexAdvanceX;      // 12-16 // out //            // Paged. Glyphs->AdvanceX in a directly indexable way (cache-friendly for CalcTextSize functions which only this this info, and are often bottleneck in large UI). Page 0 comes first: IndexAdvanceX[c] for c < IM_FONT_INDEX_PAGE_SIZE.
     float                       FallbackAdvanceX;   // 4     // out // = FallbackGlyph->AdvanceX
     float                       FontSize;           // 4     // in  //            // Height of characters/line, set during loading (don't change after loading)
 
     // Members: Hot ~28/40 bytes (for CalcTextSize + render loop)
-    ImVector<ImWchar>           IndexLookup;        // 12-16 // out //            // Sparse. Index glyphs by Unicode code-point.
+    ImVector<ImWchar>           IndexLookup;        // 12-16 // out //            // Paged. Index glyphs by Unicode code-point, same layout as IndexAdvanceX.
+    ImVector<ImU16>             IndexPages;         // 12-16 // out //            // Page table: c / IM_FONT_INDEX_PAGE_SIZE -> page in IndexAdvanceX/IndexLookup. Page 0 is stored first, then a shared empty page used by all code-point pages without any glyph.
     ImVector<ImFontGlyph>       Glyphs;             // 12-16 // out //            // All glyphs.
     const ImFontGlyph*          FallbackGlyph;      // 4-8   // out // = FindGlyph(FontFallbackChar)
+    ImVector<ImFontKerningPair> KerningPairs;       // 12-16 // out //            // Hash table of kerning pairs (power of two size, at most half full). Empty unless a source font has ImFontConfig::Kerning set.
 
     // Members: Cold ~32/40 bytes
     ImFontAtlas*                ContainerAtlas;     // 4-8   // out //            // What we has been loaded into
@@ -2714,9 +2819,11 @@ struct ImFont
     // Methods
     IMGUI_API ImFont();
     IMGUI_API ~ImFont();
-    IMGUI_API const ImFontGlyph*FindGlyph(ImWchar c) const;
-    IMGUI_API const ImFontGlyph*FindGlyphNoFallback(ImWchar c) const;
-    float                       GetCharAdvance(ImWchar c) const     { return ((int)c < IndexAdvanceX.Size) ? IndexAdvanceX[(int)c] : FallbackAdvanceX; }
+    IMGUI_API const ImFontGlyph*FindGlyph(ImWchar c) const;             // With ImFontAtlasFlags_DynamicGlyphs, rasterize the glyph if it isn't loaded yet
+    IMGUI_API const ImFontGlyph*FindGlyphNoFallback(ImWchar c) const;   // Never rasterize: NULL if not loaded yet
+    float                       GetCharAdvance(ImWchar c) const     { const int slot = GetIndexSlot(c); return (slot >= 0) ? IndexAdvanceX.Data[slot] : FallbackAdvanceX; }
+    int                         GetIndexSlot(unsigned int c) const  { const unsigned int page_n = c / IM_FONT_INDEX_PAGE_SIZE; return (page_n < (unsigned int)IndexPages.Size) ? IndexPages.Data[page_n] * IM_FONT_INDEX_PAGE_SIZE + (int)(c % IM_FONT_INDEX_PAGE_SIZE) : -1; } // Position of 'c' in IndexAdvanceX[]/IndexLookup[], -1 if above the last page
+    IMGUI_API float             GetKerning(ImWchar left, ImWchar right) const; // Unscaled, 0.0f if the pair has no kerning
     bool                        IsLoaded() const                    { return ContainerAtlas != NULL; }
     const char*                 GetDebugName() const                { return ConfigData ? ConfigData->Name : "<unknown>"; }
 
@@ -2726,11 +2833,15 @@ struct ImFont
     IMGUI_API const char*       CalcWordWrapPositionA(float scale, const char* text, const char* text_end, float wrap_width) const;
     IMGUI_API void              RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, ImWchar c) const;
     IMGUI_API void              RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width = 0.0f, bool cpu_fine_clip = false) const;
+    // RenderGlyphs() draws a run laid out by the caller (e.g. by a text shaper): no kerning, wrapping or line breaks are applied.
+    // 'glyphs' are ids as passed to FindGlyph() (codepoints, or ids given to AddCustomRectFontGlyph()). 'offsets' are pen positions relative to 'pos', in pixels at 'size'.
+    IMGUI_API void              RenderGlyphs(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const ImWchar* glyphs, const ImVec2* offsets, int glyphs_count) const;
 
     // [Internal] Don't use!
     IMGUI_API void              BuildLookupTable();
+    IMGUI_API void              BuildKerningTable(const ImFontKerningPair* pairs, int pairs_count); // Replace KerningPairs[] with a hash table of the given pairs (Left/Right != 0, no duplicates)
     IMGUI_API void              ClearOutputData();
-    IMGUI_API void              GrowIndex(int new_size);
+    IMGUI_API int               AllocIndexSlot(ImWchar c);       // Same as GetIndexSlot(), allocating the page of 'c' if needed
     IMGUI_API void              AddGlyph(const ImFontConfig* src_cfg, ImWchar c, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x);
     IMGUI_API void              AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst = true); // Makes 'dst' character/glyph points to 'src' character/glyph. Currently needs to be called AFTER fonts have been built.
     IMGUI_API void              SetGlyphVisible(ImWchar c, bool visible);
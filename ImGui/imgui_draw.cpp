@@ -16,6 +16,7 @@ Index of this file:
 // [SECTION] ImFontAtlas glyph ranges helpers
 // [SECTION] ImFontGlyphRangesBuilder
 // [SECTION] ImFont
+// [SECTION] ImTextLayoutCache
 // [SECTION] ImGui Internal Render Helpers
 // [SECTION] Decompression code
 // [SECTION] Default font data (ProggyClean.ttf)
@@ -39,6 +40,9 @@ Index of this file:
 #endif
 
 #include <stdio.h>      // vsnprintf, sscanf, printf
+#ifdef IMGUI_ENABLE_FONT_BUILD_THREADS
+#include <thread>       // std::thread
+#endif
 #if !defined(alloca)
 #if defined(__GLIBC__) || defined(__sun) || defined(__APPLE__) || defined(__NEWLIB__)
 #include <alloca.h>     // alloca (glibc uses <alloca.h>. Note that Cygwin may have _WIN32 defined, so the order matters here)
@@ -628,6 +632,70 @@ void ImDrawList::AddCallback(ImDrawCallback callback, void* callback_data)
 #define ImDrawCmd_HeaderCompare(CMD_LHS, CMD_RHS)   (memcmp(CMD_LHS, CMD_RHS, ImDrawCmd_HeaderSize))    // Compare ClipRect, TextureId, VtxOffset
 #define ImDrawCmd_HeaderCopy(CMD_DST, CMD_SRC)      (memcpy(CMD_DST, CMD_SRC, ImDrawCmd_HeaderSize))    // Copy ClipRect, TextureId, VtxOffset
 
+// Append the output of 'src', typically filled on a worker thread, after our current content.
+// Indices are rebased on our current vertex count when they fit in ImDrawIdx, so commands with the same clip rect/texture can be merged.
+// Otherwise (16-bit indices, ImDrawListFlags_AllowVtxOffset) they are copied as-is and the appended commands are moved with VtxOffset.
+void ImDrawList::AddDrawList(const ImDrawList* src)
+{
+    IM_ASSERT(src != this && src->_Data == _Data);
+    IM_ASSERT(src->_Splitter._Count <= 1 && "Call ChannelsMerge() on the source list first!");
+    IM_ASSERT((_Data->Font == NULL || _Data->Font->ContainerAtlas == NULL || (_Data->Font->ContainerAtlas->Flags & ImFontAtlasFlags_DynamicGlyphs) == 0) && "Worker threads can't draw text with an atlas loading glyphs on demand!");
+
+    const bool rebase_indices = (sizeof(ImDrawIdx) == 4) || (_VtxCurrentIdx + src->VtxBuffer.Size < (1 << 16));
+    IM_ASSERT((rebase_indices || (Flags & ImDrawListFlags_AllowVtxOffset)) && "Too many vertices in ImDrawList using 16-bit indices. Read comment in AddDrawListToDrawData().");
+    const unsigned int vtx_base = (unsigned int)VtxBuffer.Size;
+    const unsigned int idx_base = (unsigned int)IdxBuffer.Size;
+
+    VtxBuffer.resize(VtxBuffer.Size + src->VtxBuffer.Size);
+    if (src->VtxBuffer.Size > 0)
+        memcpy(VtxBuffer.Data + vtx_base, src->VtxBuffer.Data, (size_t)src->VtxBuffer.size_in_bytes());
+    IdxBuffer.resize(IdxBuffer.Size + src->IdxBuffer.Size);
+    if (!rebase_indices && src->IdxBuffer.Size > 0)
+        memcpy(IdxBuffer.Data + idx_base, src->IdxBuffer.Data, (size_t)src->IdxBuffer.size_in_bytes());
+
+    _PopUnusedDrawCmd();
+    for (int cmd_n = 0; cmd_n < src->CmdBuffer.Size; cmd_n++)
+    {
+        const ImDrawCmd* src_cmd = &src->CmdBuffer.Data[cmd_n];
+        if (src_cmd->ElemCount == 0 && src_cmd->UserCallback == NULL)
+            continue;
+        ImDrawCmd cmd = *src_cmd;
+        cmd.IdxOffset += idx_base;
+        if (rebase_indices)
+        {
+            const unsigned int idx_rebase = src_cmd->VtxOffset + _VtxCurrentIdx;
+            for (unsigned int n = 0; n < src_cmd->ElemCount; n++)
+                IdxBuffer.Data[cmd.IdxOffset + n] = (ImDrawIdx)(src->IdxBuffer.Data[src_cmd->IdxOffset + n] + idx_rebase);
+            cmd.VtxOffset = _CmdHeader.VtxOffset;
+        }
+        else
+        {
+            cmd.VtxOffset += vtx_base;
+        }
+
+        // Merge with previous command if it is contiguous and uses the same settings
+        ImDrawCmd* prev_cmd = CmdBuffer.Size > 0 ? &CmdBuffer.Data[CmdBuffer.Size - 1] : NULL;
+        if (prev_cmd != NULL && cmd.UserCallback == NULL && prev_cmd->UserCallback == NULL && ImDrawCmd_HeaderCompare(&cmd, prev_cmd) == 0 && prev_cmd->IdxOffset + prev_cmd->ElemCount == cmd.IdxOffset)
+            prev_cmd->ElemCount += cmd.ElemCount;
+        else
+            CmdBuffer.push_back(cmd);
+    }
+
+    // Following primitives go to a new command after the appended ones
+    if (rebase_indices)
+    {
+        _VtxCurrentIdx += src->VtxBuffer.Size;
+    }
+    else
+    {
+        _CmdHeader.VtxOffset = VtxBuffer.Size;
+        _VtxCurrentIdx = 0;
+    }
+    _VtxWritePtr = VtxBuffer.Data + VtxBuffer.Size;
+    _IdxWritePtr = IdxBuffer.Data + IdxBuffer.Size;
+    AddDrawCmd();
+}
+
 // Our scheme may appears a bit unusual, basically we want the most-common calls AddLine AddRect etc. to not have to perform any check so we always have a command ready in the stack.
 // The cost of figuring out if a new command has to be added or if we can merge is paid in those Update** functions only.
 void ImDrawList::_OnChangedClipRect()
@@ -835,6 +903,70 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_FIXNORMAL2F_MAX_INVLEN2          100.0f // 500.0f (see #4053, #3366)
 #define IM_FIXNORMAL2F(VX,VY)               do { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > IM_FIXNORMAL2F_MAX_INVLEN2) inv_len2 = IM_FIXNORMAL2F_MAX_INVLEN2; VX *= inv_len2; VY *= inv_len2; } } while (0)
 
+// Polyline kernels used by AddPolyline(). With IMGUI_ENABLE_SSE, two points are processed per iteration using the same operations in the
+// same order as the scalar macros above (ImRsqrt() being _mm_rsqrt_ss() in that case), so both versions produce bit-identical vertices.
+// A new instruction set only needs another block before the scalar loop, which always finishes the remaining points.
+
+// Normal (tangent) of each of the 'count' line segments. Segment i1 goes from points[i1] to points[i1 + 1], the last one wrapping to points[0] on closed lines.
+static void ImPolylineComputeNormals(const ImVec2* points, const int points_count, const int count, ImVec2* out_normals)
+{
+    int i1 = 0;
+#ifdef IMGUI_ENABLE_SSE
+    const __m128 sign_y = _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+    const __m128 zero = _mm_setzero_ps();
+    for (; i1 + 2 < points_count; i1 += 2)
+    {
+        __m128 d = _mm_sub_ps(_mm_loadu_ps(&points[i1 + 1].x), _mm_loadu_ps(&points[i1].x));   // dx0, dy0, dx1, dy1
+        __m128 sq = _mm_mul_ps(d, d);
+        __m128 d2 = _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 3, 0, 1)));
+        __m128 mask = _mm_cmpgt_ps(d2, zero);
+        d = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(d, _mm_rsqrt_ps(d2))), _mm_andnot_ps(mask, d));
+        _mm_storeu_ps(&out_normals[i1].x, _mm_xor_ps(_mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)), sign_y));   // dy0, -dx0, dy1, -dx1
+    }
+#endif
+    for (; i1 < count; i1++)
+    {
+        const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
+        float dx = points[i2].x - points[i1].x;
+        float dy = points[i2].y - points[i1].y;
+        IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+        out_normals[i1].x = dy;
+        out_normals[i1].y = -dx;
+    }
+}
+
+// Averaged normal at each point, from the normals of the two segments joining there, ready to be scaled by the half width of the line.
+// Point 0 is only computed on closed lines (it is where the last segment ends).
+static void ImPolylineComputeMiters(const ImVec2* normals, const int points_count, const bool closed, ImVec2* out_miters)
+{
+    int i = 1;
+#ifdef IMGUI_ENABLE_SSE
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 min_d2 = _mm_set1_ps(0.000001f);
+    const __m128 max_inv_len2 = _mm_set1_ps(IM_FIXNORMAL2F_MAX_INVLEN2);
+    for (; i + 2 <= points_count; i += 2)
+    {
+        __m128 dm = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&normals[i - 1].x), _mm_loadu_ps(&normals[i].x)), half);
+        __m128 sq = _mm_mul_ps(dm, dm);
+        __m128 d2 = _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 3, 0, 1)));
+        __m128 mask = _mm_cmpgt_ps(d2, min_d2);
+        __m128 inv_len2 = _mm_min_ps(_mm_div_ps(one, d2), max_inv_len2);
+        _mm_storeu_ps(&out_miters[i].x, _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(dm, inv_len2)), _mm_andnot_ps(mask, dm)));
+    }
+#endif
+    for (; i < points_count + (closed ? 1 : 0); i++)
+    {
+        const int i0 = i - 1;
+        const int i1 = (i == points_count) ? 0 : i;
+        float dm_x = (normals[i0].x + normals[i1].x) * 0.5f;
+        float dm_y = (normals[i0].y + normals[i1].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        out_miters[i1].x = dm_x;
+        out_miters[i1].y = dm_y;
+    }
+}
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
@@ -871,22 +1003,16 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         PrimReserve(idx_count, vtx_count);
 
         // Temporary buffer
-        // The first <points_count> items are normals at each line point, then after that there are either 2 or 4 temp points for each line point
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * ((use_texture || !thick_line) ? 3 : 5) * sizeof(ImVec2)); //-V630
-        ImVec2* temp_points = temp_normals + points_count;
+        // The first <points_count> items are normals at each line point, then averaged normals at each line point, then after that there are either 2 or 4 temp points for each line point
+        ImVec2* temp_normals = (ImVec2*)alloca(points_count * ((use_texture || !thick_line) ? 4 : 6) * sizeof(ImVec2)); //-V630
+        ImVec2* temp_miters = temp_normals + points_count;
+        ImVec2* temp_points = temp_miters + points_count;
 
-        // Calculate normals (tangents) for each line segment
-        for (int i1 = 0; i1 < count; i1++)
-        {
-            const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
-            float dx = points[i2].x - points[i1].x;
-            float dy = points[i2].y - points[i1].y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i1].x = dy;
-            temp_normals[i1].y = -dx;
-        }
+        // Calculate normals (tangents) for each line segment, then their average at each point
+        ImPolylineComputeNormals(points, points_count, count, temp_normals);
         if (!closed)
             temp_normals[points_count - 1] = temp_normals[points_count - 2];
+        ImPolylineComputeMiters(temp_normals, points_count, closed, temp_miters);
 
         // If we are drawing a one-pixel-wide line without a texture, or a textured line of any width, we only need 2 or 3 vertices per point
         if (use_texture || !thick_line)
@@ -919,12 +1045,9 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
                 const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
 
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                dm_x *= half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
-                dm_y *= half_draw_size;
+                // Averaged normals
+                const float dm_x = temp_miters[i2].x * half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
+                const float dm_y = temp_miters[i2].y * half_draw_size;
 
                 // Add temporary vertexes for the outer edges
                 ImVec2* out_vtx = &temp_points[i2 * 2];
@@ -1015,10 +1138,9 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
                 const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
 
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
+                // Averaged normals
+                const float dm_x = temp_miters[i2].x;
+                const float dm_y = temp_miters[i2].y;
                 float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
                 float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
                 float dm_in_x = dm_x * half_inner_thickness;
@@ -1507,6 +1629,138 @@ void ImDrawList::AddLine(const ImVec2& p1, const ImVec2& p2, ImU32 col, float th
     PathStroke(col, 0, thickness);
 }
 
+// Batched primitives are reserved by chunks so that a chunk never crosses the 64K vertices boundary of 16-bit indices in one go.
+#define IM_DRAWLIST_BATCH_CHUNK_SIZE    (sizeof(ImDrawIdx) == 2 ? 2048 : 65536)
+
+// Number of elements to reserve for the next chunk of a batched primitive.
+// With 16-bit indices and ImDrawListFlags_AllowVtxOffset, the chunk stops at the last element that fits below 64K vertices, so that PrimReserve()
+// changes VtxOffset on the same element as the single versions would. The caller skips leading invisible elements, which never reserve anything.
+static int ImDrawListBatchChunkSize(const ImDrawList* draw_list, int remaining, int vtx_per_element)
+{
+    int chunk_size = ImMin(remaining, (int)IM_DRAWLIST_BATCH_CHUNK_SIZE);
+    if (sizeof(ImDrawIdx) == 2 && (draw_list->Flags & ImDrawListFlags_AllowVtxOffset) && draw_list->_VtxCurrentIdx + vtx_per_element < (1 << 16))
+        chunk_size = ImMin(chunk_size, (int)(((1 << 16) - 1 - draw_list->_VtxCurrentIdx) / vtx_per_element));
+    return chunk_size;
+}
+
+// Same vertices as calling AddLine() for each line (which is a 2 points AddPolyline(), unrolled here for each of its paths)
+void ImDrawList::AddLines(const ImVec2* p1, const ImVec2* p2, const ImU32* cols, int count, float thickness)
+{
+    const ImVec2 opaque_uv = _Data->TexUvWhitePixel;
+    const bool anti_aliased = (Flags & ImDrawListFlags_AntiAliasedLines) != 0;
+    const bool thick_line = (thickness > _FringeScale);
+    const float AA_SIZE = _FringeScale;
+    if (anti_aliased)
+        thickness = ImMax(thickness, 1.0f);
+    const int integer_thickness = (int)thickness;
+    const float fractional_thickness = thickness - integer_thickness;
+    const bool use_texture = anti_aliased && (Flags & ImDrawListFlags_AntiAliasedLinesUseTex) && (integer_thickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX) && (fractional_thickness <= 0.00001f) && (AA_SIZE == 1.0f);
+    const int idx_per_line = (!anti_aliased || use_texture) ? 6 : (thick_line ? 18 : 12);
+    const int vtx_per_line = (!anti_aliased || use_texture) ? 4 : (thick_line ? 8 : 6);
+    const ImVec4 tex_uvs = use_texture ? _Data->TexUvLines[integer_thickness] : ImVec4();
+    const ImVec2 tex_uv0(tex_uvs.x, tex_uvs.y);
+    const ImVec2 tex_uv1(tex_uvs.z, tex_uvs.w);
+    const float half_draw_size = use_texture ? ((thickness * 0.5f) + 1) : AA_SIZE;
+    const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
+
+    for (int chunk_start = 0, chunk_end = 0; chunk_start < count; chunk_start = chunk_end)
+    {
+        while (chunk_start < count && (cols[chunk_start] & IM_COL32_A_MASK) == 0)
+            chunk_start++;
+        if (chunk_start == count)
+            break;
+        chunk_end = chunk_start + ImDrawListBatchChunkSize(this, count - chunk_start, vtx_per_line);
+        PrimReserve((chunk_end - chunk_start) * idx_per_line, (chunk_end - chunk_start) * vtx_per_line);
+        int skipped = 0;
+        for (int n = chunk_start; n < chunk_end; n++)
+        {
+            const ImU32 col = cols[n];
+            if ((col & IM_COL32_A_MASK) == 0)
+            {
+                skipped++;
+                continue;
+            }
+            const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+            const float ax = p1[n].x + 0.5f, ay = p1[n].y + 0.5f;
+            const float bx = p2[n].x + 0.5f, by = p2[n].y + 0.5f;
+            float dx = bx - ax;
+            float dy = by - ay;
+            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+            const unsigned int idx1 = _VtxCurrentIdx;
+            ImDrawVert* vtx = _VtxWritePtr;
+            ImDrawIdx* idx = _IdxWritePtr;
+
+            if (!anti_aliased)
+            {
+                dx *= (thickness * 0.5f);
+                dy *= (thickness * 0.5f);
+                vtx[0].pos.x = ax + dy; vtx[0].pos.y = ay - dx; vtx[0].uv = opaque_uv; vtx[0].col = col;
+                vtx[1].pos.x = bx + dy; vtx[1].pos.y = by - dx; vtx[1].uv = opaque_uv; vtx[1].col = col;
+                vtx[2].pos.x = bx - dy; vtx[2].pos.y = by + dx; vtx[2].uv = opaque_uv; vtx[2].col = col;
+                vtx[3].pos.x = ax - dy; vtx[3].pos.y = ay + dx; vtx[3].uv = opaque_uv; vtx[3].col = col;
+                idx[0] = (ImDrawIdx)(idx1); idx[1] = (ImDrawIdx)(idx1 + 1); idx[2] = (ImDrawIdx)(idx1 + 2);
+                idx[3] = (ImDrawIdx)(idx1); idx[4] = (ImDrawIdx)(idx1 + 2); idx[5] = (ImDrawIdx)(idx1 + 3);
+            }
+            else
+            {
+                // Normal of the segment at the first point, averaged normal of the (only) segment with itself at the second point
+                const float nx = dy, ny = -dx;
+                float mx = nx, my = ny;
+                IM_FIXNORMAL2F(mx, my);
+                if (use_texture)
+                {
+                    const unsigned int idx2 = idx1 + 2;
+                    vtx[0].pos.x = ax + nx * half_draw_size; vtx[0].pos.y = ay + ny * half_draw_size; vtx[0].uv = tex_uv0; vtx[0].col = col;
+                    vtx[1].pos.x = ax - nx * half_draw_size; vtx[1].pos.y = ay - ny * half_draw_size; vtx[1].uv = tex_uv1; vtx[1].col = col;
+                    vtx[2].pos.x = bx + mx * half_draw_size; vtx[2].pos.y = by + my * half_draw_size; vtx[2].uv = tex_uv0; vtx[2].col = col;
+                    vtx[3].pos.x = bx - mx * half_draw_size; vtx[3].pos.y = by - my * half_draw_size; vtx[3].uv = tex_uv1; vtx[3].col = col;
+                    idx[0] = (ImDrawIdx)(idx2 + 0); idx[1] = (ImDrawIdx)(idx1 + 0); idx[2] = (ImDrawIdx)(idx1 + 1);
+                    idx[3] = (ImDrawIdx)(idx2 + 1); idx[4] = (ImDrawIdx)(idx1 + 1); idx[5] = (ImDrawIdx)(idx2 + 0);
+                }
+                else if (!thick_line)
+                {
+                    const unsigned int idx2 = idx1 + 3;
+                    vtx[0].pos.x = ax;                       vtx[0].pos.y = ay;                       vtx[0].uv = opaque_uv; vtx[0].col = col;
+                    vtx[1].pos.x = ax + nx * half_draw_size; vtx[1].pos.y = ay + ny * half_draw_size; vtx[1].uv = opaque_uv; vtx[1].col = col_trans;
+                    vtx[2].pos.x = ax - nx * half_draw_size; vtx[2].pos.y = ay - ny * half_draw_size; vtx[2].uv = opaque_uv; vtx[2].col = col_trans;
+                    vtx[3].pos.x = bx;                       vtx[3].pos.y = by;                       vtx[3].uv = opaque_uv; vtx[3].col = col;
+                    vtx[4].pos.x = bx + mx * half_draw_size; vtx[4].pos.y = by + my * half_draw_size; vtx[4].uv = opaque_uv; vtx[4].col = col_trans;
+                    vtx[5].pos.x = bx - mx * half_draw_size; vtx[5].pos.y = by - my * half_draw_size; vtx[5].uv = opaque_uv; vtx[5].col = col_trans;
+                    idx[0] = (ImDrawIdx)(idx2 + 0); idx[1] = (ImDrawIdx)(idx1 + 0); idx[2] = (ImDrawIdx)(idx1 + 2);
+                    idx[3] = (ImDrawIdx)(idx1 + 2); idx[4] = (ImDrawIdx)(idx2 + 2); idx[5] = (ImDrawIdx)(idx2 + 0);
+                    idx[6] = (ImDrawIdx)(idx2 + 1); idx[7] = (ImDrawIdx)(idx1 + 1); idx[8] = (ImDrawIdx)(idx1 + 0);
+                    idx[9] = (ImDrawIdx)(idx1 + 0); idx[10] = (ImDrawIdx)(idx2 + 0); idx[11] = (ImDrawIdx)(idx2 + 1);
+                }
+                else
+                {
+                    const unsigned int idx2 = idx1 + 4;
+                    const float out_size = half_inner_thickness + AA_SIZE;
+                    vtx[0].pos.x = ax + nx * out_size;             vtx[0].pos.y = ay + ny * out_size;             vtx[0].col = col_trans;
+                    vtx[1].pos.x = ax + nx * half_inner_thickness; vtx[1].pos.y = ay + ny * half_inner_thickness; vtx[1].col = col;
+                    vtx[2].pos.x = ax - nx * half_inner_thickness; vtx[2].pos.y = ay - ny * half_inner_thickness; vtx[2].col = col;
+                    vtx[3].pos.x = ax - nx * out_size;             vtx[3].pos.y = ay - ny * out_size;             vtx[3].col = col_trans;
+                    vtx[4].pos.x = bx + mx * out_size;             vtx[4].pos.y = by + my * out_size;             vtx[4].col = col_trans;
+                    vtx[5].pos.x = bx + mx * half_inner_thickness; vtx[5].pos.y = by + my * half_inner_thickness; vtx[5].col = col;
+                    vtx[6].pos.x = bx - mx * half_inner_thickness; vtx[6].pos.y = by - my * half_inner_thickness; vtx[6].col = col;
+                    vtx[7].pos.x = bx - mx * out_size;             vtx[7].pos.y = by - my * out_size;             vtx[7].col = col_trans;
+                    for (int i = 0; i < 8; i++)
+                        vtx[i].uv = opaque_uv;
+                    idx[0]  = (ImDrawIdx)(idx2 + 1); idx[1]  = (ImDrawIdx)(idx1 + 1); idx[2]  = (ImDrawIdx)(idx1 + 2);
+                    idx[3]  = (ImDrawIdx)(idx1 + 2); idx[4]  = (ImDrawIdx)(idx2 + 2); idx[5]  = (ImDrawIdx)(idx2 + 1);
+                    idx[6]  = (ImDrawIdx)(idx2 + 1); idx[7]  = (ImDrawIdx)(idx1 + 1); idx[8]  = (ImDrawIdx)(idx1 + 0);
+                    idx[9]  = (ImDrawIdx)(idx1 + 0); idx[10] = (ImDrawIdx)(idx2 + 0); idx[11] = (ImDrawIdx)(idx2 + 1);
+                    idx[12] = (ImDrawIdx)(idx2 + 2); idx[13] = (ImDrawIdx)(idx1 + 2); idx[14] = (ImDrawIdx)(idx1 + 3);
+                    idx[15] = (ImDrawIdx)(idx1 + 3); idx[16] = (ImDrawIdx)(idx2 + 3); idx[17] = (ImDrawIdx)(idx2 + 2);
+                }
+            }
+            _VtxWritePtr += vtx_per_line;
+            _IdxWritePtr += idx_per_line;
+            _VtxCurrentIdx += vtx_per_line;
+        }
+        PrimUnreserve(skipped * idx_per_line, skipped * vtx_per_line);
+    }
+}
+
 // p_min = upper-left, p_max = lower-right
 // Note we don't render 1 pixels sized rectangles properly.
 void ImDrawList::AddRect(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, float rounding, ImDrawFlags flags, float thickness)
@@ -1536,6 +1790,49 @@ void ImDrawList::AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 c
     }
 }
 
+// Same vertices as calling AddRectFilled() with no rounding for each rectangle
+void ImDrawList::AddRectsFilled(const ImVec2* p_min, const ImVec2* p_max, const ImU32* cols, int count)
+{
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+    for (int chunk_start = 0, chunk_end = 0; chunk_start < count; chunk_start = chunk_end)
+    {
+        while (chunk_start < count && (cols[chunk_start] & IM_COL32_A_MASK) == 0)
+            chunk_start++;
+        if (chunk_start == count)
+            break;
+        chunk_end = chunk_start + ImDrawListBatchChunkSize(this, count - chunk_start, 4);
+        PrimReserve((chunk_end - chunk_start) * 6, (chunk_end - chunk_start) * 4);
+        ImDrawVert* vtx = _VtxWritePtr;
+        ImDrawIdx* idx = _IdxWritePtr;
+        unsigned int vtx_current_idx = _VtxCurrentIdx;
+        int skipped = 0;
+        for (int n = chunk_start; n < chunk_end; n++)
+        {
+            const ImU32 col = cols[n];
+            if ((col & IM_COL32_A_MASK) == 0)
+            {
+                skipped++;
+                continue;
+            }
+            const ImVec2 a = p_min[n];
+            const ImVec2 c = p_max[n];
+            idx[0] = (ImDrawIdx)(vtx_current_idx); idx[1] = (ImDrawIdx)(vtx_current_idx + 1); idx[2] = (ImDrawIdx)(vtx_current_idx + 2);
+            idx[3] = (ImDrawIdx)(vtx_current_idx); idx[4] = (ImDrawIdx)(vtx_current_idx + 2); idx[5] = (ImDrawIdx)(vtx_current_idx + 3);
+            vtx[0].pos.x = a.x; vtx[0].pos.y = a.y; vtx[0].uv = uv; vtx[0].col = col;
+            vtx[1].pos.x = c.x; vtx[1].pos.y = a.y; vtx[1].uv = uv; vtx[1].col = col;
+            vtx[2].pos.x = c.x; vtx[2].pos.y = c.y; vtx[2].uv = uv; vtx[2].col = col;
+            vtx[3].pos.x = a.x; vtx[3].pos.y = c.y; vtx[3].uv = uv; vtx[3].col = col;
+            vtx += 4;
+            idx += 6;
+            vtx_current_idx += 4;
+        }
+        _VtxWritePtr = vtx;
+        _IdxWritePtr = idx;
+        _VtxCurrentIdx = vtx_current_idx;
+        PrimUnreserve(skipped * 6, skipped * 4);
+    }
+}
+
 // p_min = upper-left, p_max = lower-right
 void ImDrawList::AddRectFilledMultiColor(const ImVec2& p_min, const ImVec2& p_max, ImU32 col_upr_left, ImU32 col_upr_right, ImU32 col_bot_right, ImU32 col_bot_left)
 {
@@ -1730,6 +2027,44 @@ void ImDrawList::AddText(const ImVec2& pos, ImU32 col, const char* text_begin, c
     AddText(NULL, 0.0f, pos, col, text_begin, text_end);
 }
 
+void ImDrawList::AddGlyphRun(const ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const ImWchar* glyphs, const ImVec2* offsets, int glyphs_count)
+{
+    if ((col & IM_COL32_A_MASK) == 0 || glyphs_count <= 0)
+        return;
+
+    // Pull default font/size from the shared ImDrawListSharedData instance
+    if (font == NULL)
+        font = _Data->Font;
+    if (font_size == 0.0f)
+        font_size = _Data->FontSize;
+
+    IM_ASSERT(font->ContainerAtlas->TexID == _CmdHeader.TextureId);  // Use high-level ImGui::PushFont() or low-level ImDrawList::PushTextureId() to change font.
+    font->RenderGlyphs(this, font_size, pos, col, _CmdHeader.ClipRect, glyphs, offsets, glyphs_count);
+}
+
+// Same vertices as calling AddText() for each text. Buffer capacity is reserved once for the worst case of the whole batch,
+// so that the per-text reservations made by RenderText() never reallocate.
+void ImDrawList::AddTexts(const ImFont* font, float font_size, const ImVec2* pos, const ImU32* cols, const char* const* texts, int count)
+{
+    if (font == NULL)
+        font = _Data->Font;
+    if (font_size == 0.0f)
+        font_size = _Data->FontSize;
+    IM_ASSERT(font->ContainerAtlas->TexID == _CmdHeader.TextureId);  // Use high-level ImGui::PushFont() or low-level ImDrawList::PushTextureId() to change font.
+
+    int char_count = 0;
+    for (int n = 0; n < count; n++)
+        if ((cols[n] & IM_COL32_A_MASK) != 0)
+            char_count += (int)strlen(texts[n]);
+    VtxBuffer.reserve(VtxBuffer.Size + char_count * 4);
+    IdxBuffer.reserve(IdxBuffer.Size + char_count * 6);
+
+    const ImVec4 clip_rect = _CmdHeader.ClipRect;
+    for (int n = 0; n < count; n++)
+        if ((cols[n] & IM_COL32_A_MASK) != 0 && texts[n][0] != 0)
+            font->RenderText(this, font_size, pos[n], cols[n], clip_rect, texts[n], NULL, 0.0f, false);
+}
+
 void ImDrawList::AddImage(ImTextureID user_texture_id, const ImVec2& p_min, const ImVec2& p_max, const ImVec2& uv_min, const ImVec2& uv_max, ImU32 col)
 {
     if ((col & IM_COL32_A_MASK) == 0)
@@ -2126,6 +2461,7 @@ void    ImFontAtlas::ClearInputData()
     ConfigData.clear();
     CustomRects.clear();
     PackIdMouseCursors = PackIdLines = -1;
+    ImFontAtlasBuildDynamicDestroy(this);
 }
 
 void    ImFontAtlas::ClearTexData()
@@ -2135,9 +2471,13 @@ void    ImFontAtlas::ClearTexData()
         IM_FREE(TexPixelsAlpha8);
     if (TexPixelsRGBA32)
         IM_FREE(TexPixelsRGBA32);
+    if (TexPixelsBC4)
+        IM_FREE(TexPixelsBC4);
     TexPixelsAlpha8 = NULL;
     TexPixelsRGBA32 = NULL;
+    TexPixelsBC4 = NULL;
     TexPixelsUseColors = false;
+    ImFontAtlasBuildDynamicDestroy(this);
 }
 
 void    ImFontAtlas::ClearFonts()
@@ -2146,6 +2486,8 @@ void    ImFontAtlas::ClearFonts()
     for (int i = 0; i < Fonts.Size; i++)
         IM_DELETE(Fonts[i]);
     Fonts.clear();
+    ImFontAtlasBuildDynamicDestroy(this);
+    GlyphsGeneration++;
 }
 
 void    ImFontAtlas::Clear()
@@ -2195,6 +2537,103 @@ void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_wid
     if (out_bytes_per_pixel) *out_bytes_per_pixel = 4;
 }
 
+// Encode one BC4 block with the palette mode giving the lowest squared error:
+// - 8 levels spread between the block min and max (red0 > red1),
+// - 6 levels between the min and max of the other texels, plus exact 0 and 255 (red0 <= red1). This one usually wins on glyph edges.
+static void ImFontAtlasEncodeBC4Block(const unsigned char texels[16], unsigned char out_block[8])
+{
+    int min_all = 255, max_all = 0, min_mid = 255, max_mid = 0;
+    for (int n = 0; n < 16; n++)
+    {
+        const int v = texels[n];
+        min_all = ImMin(min_all, v);
+        max_all = ImMax(max_all, v);
+        if (v != 0 && v != 255)
+        {
+            min_mid = ImMin(min_mid, v);
+            max_mid = ImMax(max_mid, v);
+        }
+    }
+    if (min_mid > max_mid)
+        min_mid = max_mid = 0;
+
+    ImU64 best_bits = 0;
+    int best_error = INT_MAX;
+    for (int mode = 0; mode < 2; mode++)
+    {
+        int palette[8];
+        const int red0 = (mode == 0) ? max_all : min_mid;
+        const int red1 = (mode == 0) ? min_all : max_mid;
+        if (mode == 0 && red0 == red1)
+            continue; // Would decode as the 6 levels mode
+        palette[0] = red0;
+        palette[1] = red1;
+        if (mode == 0)
+            for (int i = 2; i < 8; i++)
+                palette[i] = ((8 - i) * red0 + (i - 1) * red1 + 3) / 7;
+        else
+        {
+            for (int i = 2; i < 6; i++)
+                palette[i] = ((6 - i) * red0 + (i - 1) * red1 + 2) / 5;
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+
+        ImU64 bits = 0;
+        int error = 0;
+        for (int n = 0; n < 16; n++)
+        {
+            int best_i = 0, best_d = INT_MAX;
+            for (int i = 0; i < 8; i++)
+            {
+                const int d = (texels[n] - palette[i]) * (texels[n] - palette[i]);
+                if (d < best_d)
+                {
+                    best_d = d;
+                    best_i = i;
+                }
+            }
+            bits |= (ImU64)best_i << (n * 3);
+            error += best_d;
+        }
+        if (error < best_error)
+        {
+            best_error = error;
+            best_bits = (bits << 16) | ((ImU64)red1 << 8) | (ImU64)red0;
+        }
+    }
+    for (int n = 0; n < 8; n++)
+        out_block[n] = (unsigned char)(best_bits >> (n * 8));
+}
+
+void    ImFontAtlas::GetTexDataAsBC4(unsigned char** out_blocks, int* out_width, int* out_height, int* out_size_in_bytes)
+{
+    // Encode on demand. Blocks overlapping the right or bottom edge repeat the last column/row.
+    if (!TexPixelsBC4)
+    {
+        unsigned char* pixels = NULL;
+        GetTexDataAsAlpha8(&pixels, NULL, NULL);
+        if (pixels)
+        {
+            TexPixelsBC4 = (unsigned char*)IM_ALLOC((size_t)((TexWidth + 3) / 4) * (size_t)((TexHeight + 3) / 4) * 8);
+            unsigned char* dst = TexPixelsBC4;
+            unsigned char texels[16];
+            for (int y = 0; y < TexHeight; y += 4)
+                for (int x = 0; x < TexWidth; x += 4, dst += 8)
+                {
+                    for (int n = 0; n < 16; n++)
+                        texels[n] = pixels[ImMin(y + (n >> 2), TexHeight - 1) * TexWidth + ImMin(x + (n & 3), TexWidth - 1)];
+                    ImFontAtlasEncodeBC4Block(texels, dst);
+                }
+        }
+    }
+
+    *out_blocks = TexPixelsBC4;
+    if (out_width) *out_width = TexWidth;
+    if (out_height) *out_height = TexHeight;
+    if (out_size_in_bytes) *out_size_in_bytes = ((TexWidth + 3) / 4) * ((TexHeight + 3) / 4) * 8;
+}
+
 ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
@@ -2401,10 +2840,376 @@ bool    ImFontAtlas::Build()
 #endif
     }
 
+    // Glyphs rasterized on demand would never reach a renderer not uploading TexUpdates[]: rasterize everything now instead
+    if ((Flags & ImFontAtlasFlags_DynamicGlyphs) && GImGui != NULL && GImGui->IO.Fonts == this && !(GImGui->IO.BackendFlags & ImGuiBackendFlags_RendererHasTexUpdates))
+        Flags &= ~ImFontAtlasFlags_DynamicGlyphs;
+
     // Build
     return builder_io->FontBuilder_Build(this);
 }
 
+// File layout of LoadCache()/SaveCache():
+// - ImFontAtlasCacheHeader
+// - ImFontAtlasCacheFont[FontsCount]
+// - ImFontGlyph[GlyphsCount] (glyphs of all fonts, in order)
+// - ImFontKerningPair[KerningPairsCount] (kerning hash tables of all fonts, in order)
+// - ImU16[CustomRectsCount * 2] (X, Y of each custom rectangle)
+// - TexPixelsAlpha8[TexWidth * TexHeight]
+// Everything after the header is covered by PayloadHash. Structures are stored as-is: LayoutKey rejects files written by a different build.
+#define IM_FONTATLAS_CACHE_VERSION      3
+
+struct ImFontAtlasCacheHeader
+{
+    char        Magic[8];               // "ImFAtlas"
+    ImU32       Version;                // IM_FONTATLAS_CACHE_VERSION
+    ImU32       LayoutKey;              // Hash of the sizes of the stored structures
+    ImU32       ConfigKey;              // Hash of the font data and settings, see ImFontAtlasCalcCacheConfigKey()
+    ImU32       PayloadHash;
+    ImU64       PayloadSize;
+    int         TexWidth, TexHeight;
+    int         TexPackedSurface;
+    int         TexPixelsUseColors;
+    int         FontsCount;
+    int         GlyphsCount;
+    int         KerningPairsCount;
+    int         CustomRectsCount;
+    ImVec2      TexUvWhitePixel;
+    ImVec4      TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+};
+
+struct ImFontAtlasCacheFont
+{
+    float       FontSize;
+    float       Ascent, Descent;
+    int         GlyphsCount;
+    int         KerningPairsCount;
+    int         ConfigDataCount;
+    int         MetricsTotalSurface;
+    int         FallbackChar;
+    int         EllipsisChar;
+};
+
+static ImU32 ImFontAtlasCalcCacheLayoutKey()
+{
+    const int sizes[] = { (int)sizeof(ImFontAtlasCacheHeader), (int)sizeof(ImFontAtlasCacheFont), (int)sizeof(ImFontGlyph), (int)sizeof(ImFontKerningPair), (int)sizeof(ImWchar) };
+    return ImHashData(sizes, sizeof(sizes));
+}
+
+// Hash everything Build() output depends on. Keys are copied into zero-cleared structures so that padding doesn't leak into the hash.
+static ImU32 ImFontAtlasCalcCacheConfigKey(ImFontAtlas* atlas)
+{
+    struct AtlasKey { int Flags, TexDesiredWidth, TexGlyphPadding, FontsCount, ConfigCount, CustomRectsCount; unsigned int FontBuilderFlags; const void* FontBuilderIO; };
+    struct ConfigKey { int FontDataSize, FontNo, OversampleH, OversampleV, DstIndex, MergeMode, PixelSnapH, Kerning, EllipsisChar; unsigned int FontBuilderFlags; float SizePixels, GlyphExtraSpacingX, GlyphExtraSpacingY, GlyphOffsetX, GlyphOffsetY, GlyphMinAdvanceX, GlyphMaxAdvanceX, RasterizerMultiply; };
+    struct CustomRectKey { int Width, Height, GlyphID, FontIndex; float GlyphAdvanceX, GlyphOffsetX, GlyphOffsetY; };
+
+    AtlasKey atlas_key;
+    memset(&atlas_key, 0, sizeof(atlas_key));
+    atlas_key.Flags = atlas->Flags;
+    atlas_key.TexDesiredWidth = atlas->TexDesiredWidth;
+    atlas_key.TexGlyphPadding = atlas->TexGlyphPadding;
+    atlas_key.FontsCount = atlas->Fonts.Size;
+    atlas_key.ConfigCount = atlas->ConfigData.Size;
+    atlas_key.CustomRectsCount = atlas->CustomRects.Size;
+    atlas_key.FontBuilderFlags = atlas->FontBuilderFlags;
+    atlas_key.FontBuilderIO = atlas->FontBuilderIO;
+    ImU32 seed = ImHashData(&atlas_key, sizeof(atlas_key));
+
+    for (int i = 0; i < atlas->ConfigData.Size; i++)
+    {
+        const ImFontConfig& cfg = atlas->ConfigData[i];
+        ConfigKey cfg_key;
+        memset(&cfg_key, 0, sizeof(cfg_key));
+        cfg_key.FontDataSize = cfg.FontDataSize;
+        cfg_key.FontNo = cfg.FontNo;
+        cfg_key.OversampleH = cfg.OversampleH;
+        cfg_key.OversampleV = cfg.OversampleV;
+        cfg_key.DstIndex = atlas->Fonts.index_from_ptr(atlas->Fonts.find(cfg.DstFont));
+        cfg_key.MergeMode = cfg.MergeMode;
+        cfg_key.PixelSnapH = cfg.PixelSnapH;
+        cfg_key.Kerning = cfg.Kerning;
+        cfg_key.EllipsisChar = cfg.EllipsisChar;
+        cfg_key.FontBuilderFlags = cfg.FontBuilderFlags;
+        cfg_key.SizePixels = cfg.SizePixels;
+        cfg_key.GlyphExtraSpacingX = cfg.GlyphExtraSpacing.x;
+        cfg_key.GlyphExtraSpacingY = cfg.GlyphExtraSpacing.y;
+        cfg_key.GlyphOffsetX = cfg.GlyphOffset.x;
+        cfg_key.GlyphOffsetY = cfg.GlyphOffset.y;
+        cfg_key.GlyphMinAdvanceX = cfg.GlyphMinAdvanceX;
+        cfg_key.GlyphMaxAdvanceX = cfg.GlyphMaxAdvanceX;
+        cfg_key.RasterizerMultiply = cfg.RasterizerMultiply;
+        seed = ImHashData(&cfg_key, sizeof(cfg_key), seed);
+        seed = ImHashData(cfg.FontData, (size_t)cfg.FontDataSize, seed);
+        const ImWchar* ranges = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault();
+        int ranges_count = 0;
+        while (ranges[ranges_count] != 0)
+            ranges_count++;
+        seed = ImHashData(ranges, (size_t)ranges_count * sizeof(ImWchar), seed);
+    }
+
+    for (int i = 0; i < atlas->CustomRects.Size; i++)
+    {
+        const ImFontAtlasCustomRect& r = atlas->CustomRects[i];
+        CustomRectKey rect_key;
+        memset(&rect_key, 0, sizeof(rect_key));
+        rect_key.Width = r.Width;
+        rect_key.Height = r.Height;
+        rect_key.GlyphID = (int)r.GlyphID;
+        rect_key.FontIndex = r.Font ? atlas->Fonts.index_from_ptr(atlas->Fonts.find(r.Font)) : -1;
+        rect_key.GlyphAdvanceX = r.GlyphAdvanceX;
+        rect_key.GlyphOffsetX = r.GlyphOffset.x;
+        rect_key.GlyphOffsetY = r.GlyphOffset.y;
+        seed = ImHashData(&rect_key, sizeof(rect_key), seed);
+    }
+    return seed;
+}
+
+static bool ImFontAtlasCacheIsValidUv(const ImVec2& uv)
+{
+    return uv.x >= 0.0f && uv.x <= 1.0f && uv.y >= 0.0f && uv.y <= 1.0f; // Also false for NaN
+}
+
+static bool ImFontAtlasCacheIsValidChar(int c)
+{
+    return (c >= 0 && c <= IM_UNICODE_CODEPOINT_MAX) || c == (int)(ImWchar)-1; // (ImWchar)-1: no ellipsis character
+}
+
+// Check every value LoadCache() copies into the atlas, so that a crafted file with a valid hash can't produce out of range codepoints,
+// texture coordinates or rectangles, nor a kerning table without an empty slot (lookups would never end).
+// Sizes were checked against the file size by the caller: only the contents of the payload are checked here.
+static bool ImFontAtlasCacheValidatePayload(ImFontAtlas* atlas, const ImFontAtlasCacheHeader& header, const unsigned char* payload)
+{
+    if (!ImFontAtlasCacheIsValidUv(header.TexUvWhitePixel))
+        return false;
+    for (int n = 0; n < IM_ARRAYSIZE(header.TexUvLines); n++)
+        if (!ImFontAtlasCacheIsValidUv(ImVec2(header.TexUvLines[n].x, header.TexUvLines[n].y)) || !ImFontAtlasCacheIsValidUv(ImVec2(header.TexUvLines[n].z, header.TexUvLines[n].w)))
+            return false;
+
+    // Fonts: counts must add up to the header totals (64-bit sums: per-font counts are untrusted)
+    const ImFontAtlasCacheFont* cache_fonts = (const ImFontAtlasCacheFont*)(const void*)payload;
+    ImS64 glyphs_count = 0, kerning_pairs_count = 0;
+    for (int font_n = 0; font_n < header.FontsCount; font_n++)
+    {
+        const ImFontAtlasCacheFont& cache_font = cache_fonts[font_n];
+        if (cache_font.GlyphsCount < 0 || cache_font.KerningPairsCount < 0)
+            return false;
+        if (cache_font.KerningPairsCount != 0 && !ImIsPowerOfTwo(cache_font.KerningPairsCount)) // Stored as-is in ImFont::KerningPairs[]
+            return false;
+        if (!ImFontAtlasCacheIsValidChar(cache_font.FallbackChar) || !ImFontAtlasCacheIsValidChar(cache_font.EllipsisChar))
+            return false;
+        int config_data_count = 0;
+        for (int cfg_n = 0; cfg_n < atlas->ConfigData.Size; cfg_n++)
+            if (atlas->ConfigData[cfg_n].DstFont == atlas->Fonts[font_n])
+                config_data_count++;
+        if (cache_font.ConfigDataCount != config_data_count)
+            return false;
+        glyphs_count += cache_font.GlyphsCount;
+        kerning_pairs_count += cache_font.KerningPairsCount;
+    }
+    if (glyphs_count != header.GlyphsCount || kerning_pairs_count != header.KerningPairsCount)
+        return false;
+
+    // Glyphs
+    const ImFontGlyph* cache_glyphs = (const ImFontGlyph*)(const void*)(cache_fonts + header.FontsCount);
+    for (int n = 0; n < header.GlyphsCount; n++)
+    {
+        const ImFontGlyph& glyph = cache_glyphs[n];
+        if (glyph.Codepoint > IM_UNICODE_CODEPOINT_MAX || !ImFontAtlasCacheIsValidUv(ImVec2(glyph.U0, glyph.V0)) || !ImFontAtlasCacheIsValidUv(ImVec2(glyph.U1, glyph.V1)))
+            return false;
+    }
+
+    // Kerning hash tables: each one needs at least one empty slot
+    const ImFontKerningPair* cache_kerning_pairs = (const ImFontKerningPair*)(const void*)(cache_glyphs + header.GlyphsCount);
+    for (int font_n = 0; font_n < header.FontsCount; font_n++)
+    {
+        const int table_size = cache_fonts[font_n].KerningPairsCount;
+        int empty_count = 0;
+        for (int n = 0; n < table_size; n++)
+            if (cache_kerning_pairs[n].Left == 0)
+                empty_count++;
+        if (table_size > 0 && empty_count == 0)
+            return false;
+        cache_kerning_pairs += table_size;
+    }
+
+    // Custom rectangles must lie within the texture
+    const unsigned char* cache_rects = (const unsigned char*)cache_kerning_pairs;
+    for (int i = 0; i < atlas->CustomRects.Size; i++)
+    {
+        ImU16 xy[2];
+        memcpy(xy, cache_rects + i * 4, sizeof(xy));
+        const ImFontAtlasCustomRect& r = atlas->CustomRects[i];
+        if ((int)xy[0] + r.Width > header.TexWidth || (int)xy[1] + r.Height > header.TexHeight)
+            return false;
+    }
+    return true;
+}
+
+bool    ImFontAtlas::LoadCache(const char* filename)
+{
+    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    if (ConfigData.empty() || (Flags & ImFontAtlasFlags_DynamicGlyphs))
+        return false;
+
+    size_t file_size = 0;
+    const unsigned char* file_data = (const unsigned char*)ImFileMap(filename, &file_size);
+    if (file_data == NULL)
+        return false;
+
+    // Validate the whole file before touching the atlas
+    // (register the same custom rectangles as Build() would first, they are part of the key)
+    ImFontAtlasBuildInit(this);
+    ImFontAtlasCacheHeader header;
+    bool valid = file_size >= sizeof(header);
+    if (valid)
+    {
+        memcpy(&header, file_data, sizeof(header));
+        valid = memcmp(header.Magic, "ImFAtlas", 8) == 0 && header.Version == IM_FONTATLAS_CACHE_VERSION && header.LayoutKey == ImFontAtlasCalcCacheLayoutKey();
+    }
+    if (valid)
+        valid = header.PayloadSize == (ImU64)(file_size - sizeof(header)) && header.FontsCount == Fonts.Size && header.CustomRectsCount == CustomRects.Size;
+    if (valid)
+        valid = header.TexWidth > 0 && header.TexHeight > 0 && header.TexWidth <= 0x8000 && header.TexHeight <= 0x8000 && header.GlyphsCount >= 0 && header.KerningPairsCount >= 0 &&
+            header.PayloadSize == (ImU64)header.FontsCount * sizeof(ImFontAtlasCacheFont) + (ImU64)header.GlyphsCount * sizeof(ImFontGlyph) + (ImU64)header.KerningPairsCount * sizeof(ImFontKerningPair) + (ImU64)header.CustomRectsCount * 4 + (ImU64)header.TexWidth * header.TexHeight;
+    const unsigned char* payload = file_data + sizeof(header);
+    if (valid)
+        valid = header.ConfigKey == ImFontAtlasCalcCacheConfigKey(this) && header.PayloadHash == ImHashData(payload, (size_t)header.PayloadSize);
+    valid = valid && ImFontAtlasCacheValidatePayload(this, header, payload);
+    if (!valid)
+    {
+        ImFileUnmap(file_data, file_size);
+        return false;
+    }
+
+    // Texture
+    ClearTexData();
+    TexWidth = header.TexWidth;
+    TexHeight = header.TexHeight;
+    TexPackedSurface = header.TexPackedSurface;
+    TexUvScale = ImVec2(1.0f / TexWidth, 1.0f / TexHeight);
+    TexUvWhitePixel = header.TexUvWhitePixel;
+    memcpy(TexUvLines, header.TexUvLines, sizeof(TexUvLines));
+    TexPixelsUseColors = header.TexPixelsUseColors != 0;
+    const ImFontAtlasCacheFont* cache_fonts = (const ImFontAtlasCacheFont*)(const void*)payload;
+    const ImFontGlyph* cache_glyphs = (const ImFontGlyph*)(const void*)(cache_fonts + header.FontsCount);
+    const ImFontKerningPair* cache_kerning_pairs = (const ImFontKerningPair*)(const void*)(cache_glyphs + header.GlyphsCount);
+    const unsigned char* cache_rects = (const unsigned char*)(cache_kerning_pairs + header.KerningPairsCount);
+    const unsigned char* cache_pixels = cache_rects + header.CustomRectsCount * 4;
+    TexPixelsAlpha8 = (unsigned char*)IM_ALLOC((size_t)TexWidth * TexHeight);
+    memcpy(TexPixelsAlpha8, cache_pixels, (size_t)TexWidth * TexHeight);
+    for (int i = 0; i < CustomRects.Size; i++)
+    {
+        ImU16 xy[2];
+        memcpy(xy, cache_rects + i * 4, sizeof(xy));
+        CustomRects[i].X = xy[0];
+        CustomRects[i].Y = xy[1];
+    }
+
+    // Fonts (mirrors ImFontAtlasBuildSetupFont() + ImFontAtlasBuildFinish())
+    GlyphsGeneration++;
+    for (int font_n = 0; font_n < Fonts.Size; font_n++)
+    {
+        ImFont* font = Fonts[font_n];
+        const ImFontAtlasCacheFont& cache_font = cache_fonts[font_n];
+        ImFontConfig* font_cfg = NULL;
+        for (int cfg_n = 0; cfg_n < ConfigData.Size; cfg_n++)
+            if (ConfigData[cfg_n].DstFont == font && (font_cfg == NULL || font_cfg->MergeMode))
+                font_cfg = &ConfigData[cfg_n];
+        font->ClearOutputData();
+        font->FontSize = cache_font.FontSize;
+        font->ConfigData = font_cfg;
+        font->ConfigDataCount = (short)cache_font.ConfigDataCount;
+        font->ContainerAtlas = this;
+        font->Ascent = cache_font.Ascent;
+        font->Descent = cache_font.Descent;
+        font->FallbackChar = (ImWchar)cache_font.FallbackChar;
+        font->EllipsisChar = (ImWchar)cache_font.EllipsisChar;
+        font->Glyphs.resize(cache_font.GlyphsCount);
+        if (cache_font.GlyphsCount > 0)
+            memcpy(font->Glyphs.Data, cache_glyphs, (size_t)cache_font.GlyphsCount * sizeof(ImFontGlyph));
+        cache_glyphs += cache_font.GlyphsCount;
+        font->KerningPairs.resize(cache_font.KerningPairsCount);
+        if (cache_font.KerningPairsCount > 0)
+            memcpy(font->KerningPairs.Data, cache_kerning_pairs, (size_t)cache_font.KerningPairsCount * sizeof(ImFontKerningPair));
+        cache_kerning_pairs += cache_font.KerningPairsCount;
+        font->BuildLookupTable();
+        font->MetricsTotalSurface = cache_font.MetricsTotalSurface;
+    }
+    ImFileUnmap(file_data, file_size);
+    return true;
+}
+
+static void ImFontAtlasCacheAppend(ImVector<unsigned char>& buf, const void* data, size_t data_size)
+{
+    const int off = buf.Size;
+    buf.resize(off + (int)data_size);
+    memcpy(buf.Data + off, data, data_size);
+}
+
+bool    ImFontAtlas::SaveCache(const char* filename)
+{
+    if (!IsBuilt() || TexPixelsAlpha8 == NULL || (Flags & ImFontAtlasFlags_DynamicGlyphs))
+        return false;
+
+    ImFontAtlasCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.Magic, "ImFAtlas", 8);
+    header.Version = IM_FONTATLAS_CACHE_VERSION;
+    header.LayoutKey = ImFontAtlasCalcCacheLayoutKey();
+    header.ConfigKey = ImFontAtlasCalcCacheConfigKey(this);
+    header.TexWidth = TexWidth;
+    header.TexHeight = TexHeight;
+    header.TexPackedSurface = TexPackedSurface;
+    header.TexPixelsUseColors = TexPixelsUseColors ? 1 : 0;
+    header.FontsCount = Fonts.Size;
+    header.CustomRectsCount = CustomRects.Size;
+    header.TexUvWhitePixel = TexUvWhitePixel;
+    memcpy(header.TexUvLines, TexUvLines, sizeof(TexUvLines));
+    for (int font_n = 0; font_n < Fonts.Size; font_n++)
+    {
+        header.GlyphsCount += Fonts[font_n]->Glyphs.Size;
+        header.KerningPairsCount += Fonts[font_n]->KerningPairs.Size;
+    }
+
+    ImVector<unsigned char> payload;
+    payload.reserve(Fonts.Size * (int)sizeof(ImFontAtlasCacheFont) + header.GlyphsCount * (int)sizeof(ImFontGlyph) + header.KerningPairsCount * (int)sizeof(ImFontKerningPair) + CustomRects.Size * 4 + TexWidth * TexHeight);
+    for (int font_n = 0; font_n < Fonts.Size; font_n++)
+    {
+        const ImFont* font = Fonts[font_n];
+        ImFontAtlasCacheFont cache_font;
+        memset(&cache_font, 0, sizeof(cache_font));
+        cache_font.FontSize = font->FontSize;
+        cache_font.Ascent = font->Ascent;
+        cache_font.Descent = font->Descent;
+        cache_font.GlyphsCount = font->Glyphs.Size;
+        cache_font.KerningPairsCount = font->KerningPairs.Size;
+        cache_font.ConfigDataCount = font->ConfigDataCount;
+        cache_font.MetricsTotalSurface = font->MetricsTotalSurface;
+        cache_font.FallbackChar = font->FallbackChar;
+        cache_font.EllipsisChar = font->EllipsisChar;
+        ImFontAtlasCacheAppend(payload, &cache_font, sizeof(cache_font));
+    }
+    for (int font_n = 0; font_n < Fonts.Size; font_n++)
+        ImFontAtlasCacheAppend(payload, Fonts[font_n]->Glyphs.Data, (size_t)Fonts[font_n]->Glyphs.size_in_bytes());
+    for (int font_n = 0; font_n < Fonts.Size; font_n++)
+        ImFontAtlasCacheAppend(payload, Fonts[font_n]->KerningPairs.Data, (size_t)Fonts[font_n]->KerningPairs.size_in_bytes());
+    for (int i = 0; i < CustomRects.Size; i++)
+    {
+        const ImU16 xy[2] = { (ImU16)CustomRects[i].X, (ImU16)CustomRects[i].Y };
+        ImFontAtlasCacheAppend(payload, xy, sizeof(xy));
+    }
+    ImFontAtlasCacheAppend(payload, TexPixelsAlpha8, (size_t)TexWidth * TexHeight);
+    header.PayloadSize = (ImU64)payload.Size;
+    header.PayloadHash = ImHashData(payload.Data, (size_t)payload.Size);
+
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (f == NULL)
+        return false;
+    bool ret = ImFileWrite(&header, sizeof(header), 1, f) == 1;
+    ret &= ImFileWrite(payload.Data, 1, (ImU64)payload.Size, f) == (ImU64)payload.Size;
+    ret &= ImFileClose(f);
+    return ret;
+}
+
 void    ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_brighten_factor)
 {
     for (unsigned int i = 0; i < 256; i++)
@@ -2448,27 +3253,257 @@ struct ImFontBuildDstData
     ImBitVector         GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
-static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>* out)
+// Glyphs are rasterized in chunks of consecutive glyphs of a same source font
+#define IM_FONTATLAS_BUILD_RENDER_CHUNK_SIZE    64
+#define IM_FONTATLAS_BUILD_THREADS_MAX          32
+
+// Kerning (ImFontConfig::Kerning) is looked up between every pair of the first glyphs of a source font (lowest codepoints first)
+#ifndef IM_FONTATLAS_BUILD_KERNING_MAX_GLYPHS
+#define IM_FONTATLAS_BUILD_KERNING_MAX_GLYPHS   512
+#endif
+
+// Distance fields (ImFontAtlasFlags_SDF): IM_FONTATLAS_SDF_ONEDGE_VALUE on the glyph outline, increasing inside,
+// down to 0 at IM_FONTATLAS_SDF_SPREAD pixels outside (in pixels of the size the font is built at)
+#ifndef IM_FONTATLAS_SDF_SPREAD
+#define IM_FONTATLAS_SDF_SPREAD                 4
+#endif
+#define IM_FONTATLAS_SDF_ONEDGE_VALUE           128
+
+// Size of the rectangle to pack for a glyph (see stbtt_PackFontRangesGatherRects). Distance fields are never oversampled.
+static void ImFontAtlasBuildCalcGlyphRectSize(const ImFontAtlas* atlas, const ImFontConfig& cfg, const stbtt_fontinfo* font_info, float scale, int glyph_index_in_font, stbrp_rect* r)
 {
-    IM_ASSERT(sizeof(in->Storage.Data[0]) == sizeof(int));
-    const ImU32* it_begin = in->Storage.begin();
-    const ImU32* it_end = in->Storage.end();
-    for (const ImU32* it = it_begin; it < it_end; it++)
-        if (ImU32 entries_32 = *it)
-            for (ImU32 bit_n = 0; bit_n < 32; bit_n++)
-                if (entries_32 & ((ImU32)1 << bit_n))
-                    out->push_back((int)(((it - it_begin) << 5) + bit_n));
+    const int padding = atlas->TexGlyphPadding;
+    int x0, y0, x1, y1;
+    if (atlas->Flags & ImFontAtlasFlags_SDF)
+    {
+        stbtt_GetGlyphBitmapBoxSubpixel(font_info, glyph_index_in_font, scale, scale, 0, 0, &x0, &y0, &x1, &y1);
+        const int spread = (x0 != x1 && y0 != y1) ? IM_FONTATLAS_SDF_SPREAD * 2 : 0; // stbtt_GetGlyphSDF() outputs nothing for empty glyphs
+        r->w = (stbrp_coord)(x1 - x0 + spread + padding);
+        r->h = (stbrp_coord)(y1 - y0 + spread + padding);
+        return;
+    }
+    stbtt_GetGlyphBitmapBoxSubpixel(font_info, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+    r->w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
+    r->h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
 }
 
-static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
+// Same as stbtt_PackFontRangesRenderIntoRects() for a single range, rendering distance fields instead of coverage (ImFontAtlasFlags_SDF).
+static void ImFontAtlasBuildRenderRangeSDF(ImFontAtlas* atlas, const stbtt_fontinfo* font_info, stbtt_pack_range* range, stbrp_rect* rects)
+{
+    const float scale = (range->font_size > 0) ? stbtt_ScaleForPixelHeight(font_info, range->font_size) : stbtt_ScaleForMappingEmToPixels(font_info, -range->font_size);
+    const int padding = atlas->TexGlyphPadding;
+    for (int glyph_i = 0; glyph_i < range->num_chars; glyph_i++)
+    {
+        stbrp_rect* r = &rects[glyph_i];
+        if (!r->was_packed)
+            continue;
+
+        // Pad on left and top
+        r->x += (stbrp_coord)padding;
+        r->y += (stbrp_coord)padding;
+        r->w -= (stbrp_coord)padding;
+        r->h -= (stbrp_coord)padding;
+        const int glyph_index_in_font = stbtt_FindGlyphIndex(font_info, range->array_of_unicode_codepoints[glyph_i]);
+        int advance, lsb, x0, y0, x1, y1;
+        stbtt_GetGlyphHMetrics(font_info, glyph_index_in_font, &advance, &lsb);
+        stbtt_GetGlyphBitmapBoxSubpixel(font_info, glyph_index_in_font, scale, scale, 0, 0, &x0, &y0, &x1, &y1);
+        int w = 0, h = 0;
+        if (unsigned char* sdf = stbtt_GetGlyphSDF(font_info, scale, glyph_index_in_font, IM_FONTATLAS_SDF_SPREAD, IM_FONTATLAS_SDF_ONEDGE_VALUE, (float)IM_FONTATLAS_SDF_ONEDGE_VALUE / IM_FONTATLAS_SDF_SPREAD, &w, &h, &x0, &y0))
+        {
+            IM_ASSERT(w == r->w && h == r->h);
+            for (int y = 0; y < h; y++)
+                memcpy(atlas->TexPixelsAlpha8 + (size_t)(r->y + y) * atlas->TexWidth + r->x, sdf + y * w, (size_t)w);
+            stbtt_FreeSDF(sdf, font_info->userdata);
+        }
+
+        stbtt_packedchar* pc = &range->chardata_for_range[glyph_i];
+        pc->x0 = (unsigned short)r->x;
+        pc->y0 = (unsigned short)r->y;
+        pc->x1 = (unsigned short)(r->x + r->w);
+        pc->y1 = (unsigned short)(r->y + r->h);
+        pc->xadvance = scale * advance;
+        pc->xoff = (float)x0;
+        pc->yoff = (float)y0;
+        pc->xoff2 = (float)(x0 + r->w);
+        pc->yoff2 = (float)(y0 + r->h);
+    }
+}
+
+// Glyphs of one source font rendered by ImFontAtlasBuildRenderChunks()
+struct ImFontBuildRenderChunk
+{
+    int                 SrcIndex;
+    int                 GlyphsStart;
+    int                 GlyphsCount;
+};
+
+struct ImFontBuildRenderJob
+{
+    ImFontAtlas*                Atlas;
+    const stbtt_pack_context*   PackContext;
+    ImFontBuildSrcData*         SrcData;
+    const ImFontBuildRenderChunk* Chunks;
+    int                         ChunksCount;
+    int                         ThreadsCount;       // Thread N renders chunks N, N + ThreadsCount, N + ThreadsCount * 2, etc.
+};
+
+// Rasterize the glyphs of a set of chunks and apply their multiply operator.
+// Each glyph only writes within its own packed rectangle: the output doesn't depend on the order or on the thread count.
+// Note that stb_truetype allocates with IM_ALLOC(): allocators set with SetAllocatorFunctions() need to be thread-safe to build on multiple threads.
+static void ImFontAtlasBuildRenderChunks(ImFontBuildRenderJob* job, int thread_n)
+{
+    ImFontAtlas* atlas = job->Atlas;
+    stbtt_pack_context spc = *job->PackContext; // stbtt_PackFontRangesRenderIntoRects() temporarily writes into the context
+    for (int chunk_n = thread_n; chunk_n < job->ChunksCount; chunk_n += job->ThreadsCount)
+    {
+        const ImFontBuildRenderChunk& chunk = job->Chunks[chunk_n];
+        const ImFontConfig& cfg = atlas->ConfigData[chunk.SrcIndex];
+        ImFontBuildSrcData& src_tmp = job->SrcData[chunk.SrcIndex];
+        stbtt_pack_range pack_range = src_tmp.PackRange;
+        pack_range.array_of_unicode_codepoints += chunk.GlyphsStart;
+        pack_range.chardata_for_range += chunk.GlyphsStart;
+        pack_range.num_chars = chunk.GlyphsCount;
+        stbrp_rect* rects = src_tmp.Rects + chunk.GlyphsStart;
+        if (atlas->Flags & ImFontAtlasFlags_SDF)
+        {
+            ImFontAtlasBuildRenderRangeSDF(atlas, &src_tmp.FontInfo, &pack_range, rects);
+            continue;
+        }
+        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &pack_range, 1, rects);
+
+        // Apply multiply operator
+        if (cfg.RasterizerMultiply != 1.0f)
+        {
+            unsigned char multiply_table[256];
+            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+            stbrp_rect* r = rects;
+            for (int glyph_i = 0; glyph_i < chunk.GlyphsCount; glyph_i++, r++)
+                if (r->was_packed)
+                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+        }
+    }
+}
+
+// stb_truetype cannot enumerate the pairs of a GPOS table, so we query each pair of glyphs (a few milliseconds for Latin-1 ranges).
+static void ImFontAtlasBuildGatherKerningPairs(const ImFontBuildSrcData& src_tmp, const ImFontConfig& cfg, ImVector<ImFontKerningPair>* out_pairs)
+{
+    const stbtt_fontinfo* font_info = &src_tmp.FontInfo;
+    if (!font_info->kern && !font_info->gpos)
+        return;
+
+    const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(font_info, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(font_info, -cfg.SizePixels);
+    const int glyphs_count = ImMin(src_tmp.GlyphsList.Size, IM_FONTATLAS_BUILD_KERNING_MAX_GLYPHS);
+    ImVector<int> glyph_indices;
+    glyph_indices.resize(glyphs_count);
+    for (int glyph_i = 0; glyph_i < glyphs_count; glyph_i++)
+        glyph_indices[glyph_i] = stbtt_FindGlyphIndex(font_info, src_tmp.GlyphsList[glyph_i]);
+
+    for (int left_i = 0; left_i < glyphs_count; left_i++)
+        for (int right_i = 0; right_i < glyphs_count; right_i++)
+        {
+            const int kern = stbtt_GetGlyphKernAdvance(font_info, glyph_indices[left_i], glyph_indices[right_i]);
+            if (kern == 0)
+                continue;
+            float advance_x = kern * scale;
+            if (cfg.PixelSnapH)
+                advance_x = IM_ROUND(advance_x);
+            if (advance_x == 0.0f)
+                continue;
+            ImFontKerningPair pair;
+            pair.Left = (ImWchar)src_tmp.GlyphsList[left_i];
+            pair.Right = (ImWchar)src_tmp.GlyphsList[right_i];
+            pair.AdvanceX = advance_x;
+            out_pairs->push_back(pair);
+        }
+}
+
+static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>* out)
+{
+    IM_ASSERT(sizeof(in->Storage.Data[0]) == sizeof(int));
+    const ImU32* it_begin = in->Storage.begin();
+    const ImU32* it_end = in->Storage.end();
+    for (const ImU32* it = it_begin; it < it_end; it++)
+        if (ImU32 entries_32 = *it)
+            for (ImU32 bit_n = 0; bit_n < 32; bit_n++)
+                if (entries_32 & ((ImU32)1 << bit_n))
+                    out->push_back((int)(((it - it_begin) << 5) + bit_n));
+}
+
+static void ImFontAtlasBuildDynamicInit(ImFontAtlas* atlas, int tex_y0);
+
+// Final texture height for a given height of packed rectangles
+static int ImFontAtlasBuildCalcTexHeight(const ImFontAtlas* atlas, int packed_height)
+{
+    int tex_height = packed_height;
+    if (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs)
+        tex_height += (atlas->TexDynamicHeight > 0) ? atlas->TexDynamicHeight : 1024;
+    return (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (tex_height + 1) : ImUpperPowerOfTwo(tex_height);
+}
+
+// With ImFontAtlasFlags_PackTight: pack the custom rectangles then all glyphs (as Build() does) at each candidate width with both stb_rectpack skyline heuristics,
+// and select the combination giving the smallest final texture. Ties go to the squarer texture.
+// With ImFontAtlasFlags_DynamicGlyphs, widths below 1024 are not tried as they would shrink the area reserved by TexDynamicHeight.
+static void ImFontAtlasBuildPackTightSelect(const ImFontAtlas* atlas, const stbrp_rect* glyph_rects, int glyph_rects_count, int tex_height_max, int* out_tex_width, int* out_heuristic)
+{
+    const ImVector<ImFontAtlasCustomRect>& user_rects = atlas->CustomRects;
+    const int padding = atlas->TexGlyphPadding;
+    ImVector<stbrp_rect> rects;
+    rects.resize(user_rects.Size + glyph_rects_count);
+    int rect_max_width = 0;
+    for (int i = 0; i < rects.Size; i++)
+    {
+        rects[i].id = i;
+        rects[i].w = (i < user_rects.Size) ? user_rects[i].Width : glyph_rects[i - user_rects.Size].w;
+        rects[i].h = (i < user_rects.Size) ? user_rects[i].Height : glyph_rects[i - user_rects.Size].h;
+        rect_max_width = ImMax(rect_max_width, (int)rects[i].w + padding);
+    }
+
+    const int width_min = (atlas->TexDesiredWidth > 0) ? atlas->TexDesiredWidth : ImMax((atlas->Flags & ImFontAtlasFlags_DynamicGlyphs) ? 1024 : 128, ImUpperPowerOfTwo(rect_max_width));
+    const int width_max = (atlas->TexDesiredWidth > 0) ? atlas->TexDesiredWidth : ImMax(4096, width_min);
+    ImVector<stbrp_node> nodes;
+    int best_width = 0, best_height = 0;
+    for (int tex_width = width_min; tex_width <= width_max; tex_width *= 2)
+        for (int heuristic = STBRP_HEURISTIC_Skyline_BL_sortHeight; heuristic <= STBRP_HEURISTIC_Skyline_BF_sortHeight; heuristic++)
+        {
+            stbrp_context pack_context;
+            nodes.resize(tex_width - padding);
+            stbrp_init_target(&pack_context, tex_width - padding, tex_height_max - padding, nodes.Data, nodes.Size);
+            stbrp_setup_heuristic(&pack_context, heuristic);
+            stbrp_pack_rects(&pack_context, rects.Data, user_rects.Size);
+            stbrp_pack_rects(&pack_context, rects.Data + user_rects.Size, glyph_rects_count);
+
+            int packed_height = 0;
+            bool all_packed = true;
+            for (int i = 0; i < rects.Size && all_packed; i++)
+            {
+                all_packed = rects[i].was_packed != 0;
+                packed_height = ImMax(packed_height, rects[i].y + rects[i].h);
+            }
+            if (!all_packed)
+                continue;
+            const int tex_height = ImFontAtlasBuildCalcTexHeight(atlas, packed_height);
+            const ImS64 area = (ImS64)tex_width * tex_height;
+            const ImS64 best_area = (ImS64)best_width * best_height;
+            if (best_width == 0 || area < best_area || (area == best_area && ImMax(tex_width, tex_height) < ImMax(best_width, best_height)))
+            {
+                best_width = tex_width;
+                best_height = tex_height;
+                *out_tex_width = tex_width;
+                *out_heuristic = heuristic;
+            }
+        }
+}
+
+static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
+    const bool dynamic_glyphs = (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs) != 0;
 
     ImFontAtlasBuildInit(atlas);
 
     // Clear atlas
     atlas->TexID = (ImTextureID)NULL;
-    atlas->TexWidth = atlas->TexHeight = 0;
+    atlas->TexWidth = atlas->TexHeight = atlas->TexPackedSurface = 0;
     atlas->TexUvScale = ImVec2(0.0f, 0.0f);
     atlas->TexUvWhitePixel = ImVec2(0.0f, 0.0f);
     atlas->ClearTexData();
@@ -2519,6 +3554,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     {
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
         ImFontBuildDstData& dst_tmp = dst_tmp_array[src_tmp.DstIndex];
+        const ImFont* dst_font = atlas->ConfigData[src_i].DstFont;
         src_tmp.GlyphsSet.Create(src_tmp.GlyphsHighest + 1);
         if (dst_tmp.GlyphsSet.Storage.empty())
             dst_tmp.GlyphsSet.Create(dst_tmp.GlyphsHighest + 1);
@@ -2526,6 +3562,8 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         for (const ImWchar* src_range = src_tmp.SrcRanges; src_range[0] && src_range[1]; src_range += 2)
             for (unsigned int codepoint = src_range[0]; codepoint <= src_range[1]; codepoint++)
             {
+                if (dynamic_glyphs && codepoint >= 0x100 && codepoint != dst_font->FallbackChar && codepoint != 0x2026) // Rasterized on demand (see ImFontAtlasBuildDynamicLoadGlyph)
+                    continue;
                 if (dst_tmp.GlyphsSet.TestBit(codepoint))    // Don't overwrite existing glyphs. We could make this an option for MergeMode (e.g. MergeOverwrite==true)
                     continue;
                 if (!stbtt_FindGlyphIndex(&src_tmp.FontInfo, codepoint))    // It is actually in the font?
@@ -2589,15 +3627,11 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 
         // Gather the sizes of all rectangles we will need to pack (this loop is based on stbtt_PackFontRangesGatherRects)
         const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels);
-        const int padding = atlas->TexGlyphPadding;
         for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
         {
-            int x0, y0, x1, y1;
             const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
             IM_ASSERT(glyph_index_in_font != 0);
-            stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
+            ImFontAtlasBuildCalcGlyphRectSize(atlas, cfg, &src_tmp.FontInfo, scale, glyph_index_in_font, &src_tmp.Rects[glyph_i]);
             total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
         }
     }
@@ -2610,33 +3644,51 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     if (atlas->TexDesiredWidth > 0)
         atlas->TexWidth = atlas->TexDesiredWidth;
     else
-        atlas->TexWidth = (surface_sqrt >= 4096 * 0.7f) ? 4096 : (surface_sqrt >= 2048 * 0.7f) ? 2048 : (surface_sqrt >= 1024 * 0.7f) ? 1024 : 512;
+        atlas->TexWidth = (surface_sqrt >= 4096 * 0.7f) ? 4096 : (surface_sqrt >= 2048 * 0.7f) ? 2048 : (surface_sqrt >= 1024 * 0.7f) ? 1024 : (dynamic_glyphs ? 1024 : 512);
 
     // 5. Start packing
     // Pack our extra data rectangles first, so it will be on the upper-left corner of our texture (UV will have small values).
+    // With ImFontAtlasFlags_PackTight, the width and heuristic are selected by packing at every candidate width first.
     const int TEX_HEIGHT_MAX = 1024 * 32;
+    const bool pack_tight = (atlas->Flags & ImFontAtlasFlags_PackTight) != 0;
+    int pack_heuristic = STBRP_HEURISTIC_Skyline_default;
+    if (pack_tight)
+        ImFontAtlasBuildPackTightSelect(atlas, buf_rects.Data, buf_rects.Size, TEX_HEIGHT_MAX, &atlas->TexWidth, &pack_heuristic);
     stbtt_pack_context spc = {};
     stbtt_PackBegin(&spc, NULL, atlas->TexWidth, TEX_HEIGHT_MAX, 0, atlas->TexGlyphPadding, NULL);
+    stbrp_setup_heuristic((stbrp_context*)spc.pack_info, pack_heuristic);
     ImFontAtlasBuildPackCustomRects(atlas, spc.pack_info);
+    for (int i = 0; i < atlas->CustomRects.Size; i++)
+        if (atlas->CustomRects[i].IsPacked())
+            atlas->TexPackedSurface += atlas->CustomRects[i].Width * atlas->CustomRects[i].Height;
 
     // 6. Pack each source font. No rendering yet, we are working with rectangles in an infinitely tall texture at this point.
+    // With ImFontAtlasFlags_PackTight, all glyphs are packed in a single call so they are sorted by height across source fonts.
+    if (pack_tight && buf_rects.Size > 0)
+        stbrp_pack_rects((stbrp_context*)spc.pack_info, buf_rects.Data, buf_rects.Size);
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
         if (src_tmp.GlyphsCount == 0)
             continue;
 
-        stbrp_pack_rects((stbrp_context*)spc.pack_info, src_tmp.Rects, src_tmp.GlyphsCount);
+        if (!pack_tight)
+            stbrp_pack_rects((stbrp_context*)spc.pack_info, src_tmp.Rects, src_tmp.GlyphsCount);
 
         // Extend texture height and mark missing glyphs as non-packed so we won't render them.
         // FIXME: We are not handling packing failure here (would happen if we got off TEX_HEIGHT_MAX or if a single if larger than TexWidth?)
         for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++)
             if (src_tmp.Rects[glyph_i].was_packed)
+            {
                 atlas->TexHeight = ImMax(atlas->TexHeight, src_tmp.Rects[glyph_i].y + src_tmp.Rects[glyph_i].h);
+                atlas->TexPackedSurface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+            }
     }
 
     // 7. Allocate texture
-    atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
+    // With dynamic glyphs, reserve an area below the baked glyphs for the ones rasterized on demand.
+    const int dynamic_tex_y0 = atlas->TexHeight;
+    atlas->TexHeight = ImFontAtlasBuildCalcTexHeight(atlas, atlas->TexHeight);
     atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
     atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(atlas->TexWidth * atlas->TexHeight);
     memset(atlas->TexPixelsAlpha8, 0, atlas->TexWidth * atlas->TexHeight);
@@ -2644,27 +3696,33 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
+    // Glyphs are split in chunks which can be rendered in any order (packed rectangles don't overlap), possibly on multiple threads.
+    ImVector<ImFontBuildRenderChunk> render_chunks;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
-    {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
-        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
+        for (int glyph_i = 0; glyph_i < src_tmp_array[src_i].GlyphsCount; glyph_i += IM_FONTATLAS_BUILD_RENDER_CHUNK_SIZE)
         {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+            ImFontBuildRenderChunk chunk = { src_i, glyph_i, ImMin(src_tmp_array[src_i].GlyphsCount - glyph_i, IM_FONTATLAS_BUILD_RENDER_CHUNK_SIZE) };
+            render_chunks.push_back(chunk);
         }
-        src_tmp.Rects = NULL;
+    ImFontBuildRenderJob render_job = { atlas, &spc, src_tmp_array.Data, render_chunks.Data, render_chunks.Size, 1 };
+#ifdef IMGUI_ENABLE_FONT_BUILD_THREADS
+    render_job.ThreadsCount = ImClamp(atlas->BuildThreadsCount, 1, ImMin(render_chunks.Size, IM_FONTATLAS_BUILD_THREADS_MAX));
+    if (render_job.ThreadsCount > 1)
+    {
+        std::thread threads[IM_FONTATLAS_BUILD_THREADS_MAX];
+        for (int thread_n = 1; thread_n < render_job.ThreadsCount; thread_n++)
+            threads[thread_n] = std::thread(ImFontAtlasBuildRenderChunks, &render_job, thread_n);
+        ImFontAtlasBuildRenderChunks(&render_job, 0);
+        for (int thread_n = 1; thread_n < render_job.ThreadsCount; thread_n++)
+            threads[thread_n].join();
+    }
+    else
+#endif
+    {
+        ImFontAtlasBuildRenderChunks(&render_job, 0);
     }
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        src_tmp_array[src_i].Rects = NULL;
 
     // End packing
     stbtt_PackEnd(&spc);
@@ -2705,11 +3763,25 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         }
     }
 
+    // 10. Kerning pairs, between glyphs of a same source font (with ImFontAtlasFlags_DynamicGlyphs, only the glyphs baked above)
+    ImVector<ImFontKerningPair> kerning_pairs;
+    for (int font_i = 0; font_i < atlas->Fonts.Size; font_i++)
+    {
+        kerning_pairs.resize(0);
+        for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+            if (atlas->ConfigData[src_i].DstFont == atlas->Fonts[font_i] && atlas->ConfigData[src_i].Kerning)
+                ImFontAtlasBuildGatherKerningPairs(src_tmp_array[src_i], atlas->ConfigData[src_i], &kerning_pairs);
+        if (kerning_pairs.Size > 0)
+            atlas->Fonts[font_i]->BuildKerningTable(kerning_pairs.Data, kerning_pairs.Size);
+    }
+
     // Cleanup temporary (ImVector doesn't honor destructor)
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
         src_tmp_array[src_i].~ImFontBuildSrcData();
 
     ImFontAtlasBuildFinish(atlas);
+    if (dynamic_glyphs)
+        ImFontAtlasBuildDynamicInit(atlas, dynamic_tex_y0);
     return true;
 }
 
@@ -2722,6 +3794,306 @@ const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype()
 
 #endif // IMGUI_ENABLE_STB_TRUETYPE
 
+//-------------------------------------------------------------------------
+// Glyphs rasterized on demand (ImFontAtlasFlags_DynamicGlyphs)
+//-------------------------------------------------------------------------
+// The texture area below the baked glyphs is split in horizontal pages, each with its own skyline packer.
+// The least recently used page is evicted when no page has room left for a new glyph.
+// - Pages in which a glyph was rendered during the current frame are never evicted: draw lists already reference their UV.
+// - ImFontAtlasTexUpdate rectangles are appended for every modified area, the backend uploads them before rendering.
+// - Codepoints a font doesn't have are only looked up once (GlyphsRequested), they keep using the fallback glyph.
+//-------------------------------------------------------------------------
+
+struct ImFontAtlasDynamicPage
+{
+    stbrp_context       PackContext;
+    int                 Y;                  // Top of the page in the texture
+    int                 LastUsedFrame;      // Last value of ImFontAtlasDynamicData::FrameCount in which a glyph of the page was used
+    int                 GlyphsCount;
+};
+
+struct ImFontAtlasDynamicData
+{
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+    ImVector<stbtt_fontinfo>        FontInfos;          // One per atlas->ConfigData[], pointing to the font data owned by the atlas
+#endif
+    ImVector<ImFontAtlasDynamicPage> Pages;
+    ImVector<stbrp_node>            PackNodes;          // atlas->TexWidth nodes per page
+    ImBitVector                     GlyphsRequested;    // 1 bit per (font, codepoint) already looked up: loaded, or missing from the font
+    int                             FontsCount;         // atlas->Fonts.Size when the atlas was built
+    int                             TexY0;              // Top of the dynamic area
+    int                             TexHeight;
+    int                             PageHeight;
+    int                             FrameCount;
+
+    ImFontAtlasDynamicData()        { FontsCount = TexY0 = TexHeight = PageHeight = FrameCount = 0; }
+};
+
+void ImFontAtlasBuildDynamicNewFrame(ImFontAtlas* atlas)
+{
+    atlas->DynamicData->FrameCount++;
+}
+
+void ImFontAtlasBuildDynamicDestroy(ImFontAtlas* atlas)
+{
+    if (atlas->DynamicData)
+        IM_DELETE(atlas->DynamicData);
+    atlas->DynamicData = NULL;
+    atlas->TexUpdates.clear();
+}
+
+static inline void ImFontAtlasBuildDynamicTouchUV(ImFontAtlasDynamicData* dynamic_data, float v0)
+{
+    const int y = (int)(v0 * dynamic_data->TexHeight + 0.5f);
+    if (y >= dynamic_data->TexY0)
+        dynamic_data->Pages[(y - dynamic_data->TexY0) / dynamic_data->PageHeight].LastUsedFrame = dynamic_data->FrameCount;
+}
+
+static inline void ImFontAtlasBuildDynamicTouchGlyph(ImFontAtlasDynamicData* dynamic_data, const ImFontGlyph* glyph)
+{
+    ImFontAtlasBuildDynamicTouchUV(dynamic_data, glyph->V0);
+}
+
+static void ImFontAtlasBuildDynamicResetPage(ImFontAtlas* atlas, int page_n)
+{
+    ImFontAtlasDynamicData* dynamic_data = atlas->DynamicData;
+    ImFontAtlasDynamicPage& page = dynamic_data->Pages[page_n];
+    const int padding = atlas->TexGlyphPadding;
+    stbrp_init_target(&page.PackContext, atlas->TexWidth - padding, dynamic_data->PageHeight - padding, &dynamic_data->PackNodes[page_n * atlas->TexWidth], atlas->TexWidth);
+    page.GlyphsCount = 0;
+}
+
+static void ImFontAtlasBuildDynamicEvictPage(ImFontAtlas* atlas, int page_n)
+{
+    ImFontAtlasDynamicData* dynamic_data = atlas->DynamicData;
+    const int page_y0 = dynamic_data->Pages[page_n].Y;
+    const int page_y1 = page_y0 + dynamic_data->PageHeight;
+
+    // Drop the glyphs located in the page and rebuild lookup tables of the fonts which had some
+    // (the TAB glyph is dropped as well, BuildLookupTable() appends it again)
+    for (int font_n = 0; font_n < dynamic_data->FontsCount; font_n++)
+    {
+        ImFont* font = atlas->Fonts[font_n];
+        int glyphs_in_page = 0;
+        for (int glyph_n = 0; glyph_n < font->Glyphs.Size; glyph_n++)
+        {
+            const int y = (int)(font->Glyphs.Data[glyph_n].V0 * atlas->TexHeight + 0.5f);
+            if (y >= page_y0 && y < page_y1)
+                glyphs_in_page++;
+        }
+        if (glyphs_in_page == 0)
+            continue;
+
+        int dst_n = 0;
+        for (int glyph_n = 0; glyph_n < font->Glyphs.Size; glyph_n++)
+        {
+            const ImFontGlyph& glyph = font->Glyphs.Data[glyph_n];
+            const int y = (int)(glyph.V0 * atlas->TexHeight + 0.5f);
+            if (y >= page_y0 && y < page_y1)
+                dynamic_data->GlyphsRequested.ClearBit(font_n * (IM_UNICODE_CODEPOINT_MAX + 1) + (int)glyph.Codepoint);
+            else if (glyph.Codepoint != '\t')
+                font->Glyphs.Data[dst_n++] = glyph;
+        }
+        font->Glyphs.resize(dst_n);
+        font->BuildLookupTable();
+    }
+
+    // Clear pixels so that bilinear filtering doesn't pick up old glyphs in the padding of the new ones
+    memset(atlas->TexPixelsAlpha8 + (size_t)page_y0 * atlas->TexWidth, 0, (size_t)dynamic_data->PageHeight * atlas->TexWidth);
+    if (atlas->TexPixelsRGBA32)
+    {
+        unsigned int* dst = atlas->TexPixelsRGBA32 + (size_t)page_y0 * atlas->TexWidth;
+        for (int n = dynamic_data->PageHeight * atlas->TexWidth; n > 0; n--)
+            *dst++ = IM_COL32(255, 255, 255, 0);
+    }
+    ImFontAtlasTexUpdate update = { 0, (unsigned short)page_y0, (unsigned short)atlas->TexWidth, (unsigned short)dynamic_data->PageHeight };
+    atlas->TexUpdates.push_back(update);
+    ImFontAtlasBuildDynamicResetPage(atlas, page_n);
+    atlas->GlyphsGeneration++;
+}
+
+static bool ImFontAtlasBuildDynamicPackRectInPage(ImFontAtlasDynamicData* dynamic_data, int page_n, stbrp_rect* r)
+{
+    ImFontAtlasDynamicPage& page = dynamic_data->Pages[page_n];
+    r->was_packed = 0;
+    stbrp_pack_rects(&page.PackContext, r, 1);
+    if (!r->was_packed)
+        return false;
+    r->y = (stbrp_coord)(r->y + page.Y);
+    page.LastUsedFrame = dynamic_data->FrameCount;
+    page.GlyphsCount++;
+    return true;
+}
+
+static bool ImFontAtlasBuildDynamicPackRect(ImFontAtlas* atlas, stbrp_rect* r)
+{
+    ImFontAtlasDynamicData* dynamic_data = atlas->DynamicData;
+    for (int page_n = 0; page_n < dynamic_data->Pages.Size; page_n++)
+        if (ImFontAtlasBuildDynamicPackRectInPage(dynamic_data, page_n, r))
+            return true;
+
+    // All pages are full: evict the least recently used one, unless all of them are used by the current frame
+    int evict_n = -1;
+    for (int page_n = 0; page_n < dynamic_data->Pages.Size; page_n++)
+        if (dynamic_data->Pages[page_n].LastUsedFrame != dynamic_data->FrameCount)
+            if (evict_n == -1 || dynamic_data->Pages[page_n].LastUsedFrame < dynamic_data->Pages[evict_n].LastUsedFrame)
+                evict_n = page_n;
+    if (evict_n == -1)
+        return false;
+    ImFontAtlasBuildDynamicEvictPage(atlas, evict_n);
+    return ImFontAtlasBuildDynamicPackRectInPage(dynamic_data, evict_n, r);
+}
+
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+
+// Called at the end of ImFontAtlasBuildWithStbTruetype(), with the texture area [tex_y0, TexHeight) left empty.
+static void ImFontAtlasBuildDynamicInit(ImFontAtlas* atlas, int tex_y0)
+{
+    ImFontAtlasDynamicData* dynamic_data = IM_NEW(ImFontAtlasDynamicData)();
+    dynamic_data->FontInfos.resize(atlas->ConfigData.Size);
+    int glyph_height_max = 0;
+    for (int src_i = 0; src_i < atlas->ConfigData.Size; src_i++)
+    {
+        const ImFontConfig& cfg = atlas->ConfigData[src_i];
+        const int font_offset = stbtt_GetFontOffsetForIndex((unsigned char*)cfg.FontData, cfg.FontNo);
+        stbtt_InitFont(&dynamic_data->FontInfos[src_i], (unsigned char*)cfg.FontData, font_offset); // Already validated by the build
+        glyph_height_max = ImMax(glyph_height_max, (int)(cfg.SizePixels * 1.5f) * cfg.OversampleV + cfg.OversampleV + atlas->TexGlyphPadding);
+    }
+
+    // Split the area in 8 pages, or less if a page wouldn't be able to hold the tallest glyphs
+    const int area_height = atlas->TexHeight - tex_y0;
+    dynamic_data->FontsCount = atlas->Fonts.Size;
+    dynamic_data->TexY0 = tex_y0;
+    dynamic_data->TexHeight = atlas->TexHeight;
+    dynamic_data->PageHeight = ImMax(area_height / 8, glyph_height_max);
+    const int pages_count = area_height / dynamic_data->PageHeight;
+    dynamic_data->Pages.resize(pages_count);
+    dynamic_data->PackNodes.resize(pages_count * atlas->TexWidth);
+    dynamic_data->GlyphsRequested.Create(dynamic_data->FontsCount * (IM_UNICODE_CODEPOINT_MAX + 1));
+    atlas->DynamicData = dynamic_data;
+    for (int page_n = 0; page_n < pages_count; page_n++)
+    {
+        dynamic_data->Pages[page_n].Y = tex_y0 + page_n * dynamic_data->PageHeight;
+        dynamic_data->Pages[page_n].LastUsedFrame = -1;
+        ImFontAtlasBuildDynamicResetPage(atlas, page_n);
+    }
+}
+
+// Rasterize and register a glyph missing from 'font', exactly as ImFontAtlasBuildWithStbTruetype() would have.
+// Returns NULL if the font doesn't have it (in its requested ranges) or if there is no room left for it in this frame.
+const ImFontGlyph* ImFontAtlasBuildDynamicLoadGlyph(ImFontAtlas* atlas, ImFont* font, ImWchar codepoint)
+{
+    ImFontAtlasDynamicData* dynamic_data = atlas->DynamicData;
+    const int font_n = atlas->Fonts.index_from_ptr(atlas->Fonts.find(font));
+    if (font_n >= dynamic_data->FontsCount)
+        return NULL;
+    const int request_n = font_n * (IM_UNICODE_CODEPOINT_MAX + 1) + (int)codepoint;
+    if (dynamic_data->GlyphsRequested.TestBit(request_n))
+        return NULL;
+    dynamic_data->GlyphsRequested.SetBit(request_n);
+    if (font->Glyphs.Size >= 0xFFFE) // -1 is reserved in IndexLookup[]
+        return NULL;
+
+    // Find the first source providing the codepoint within its requested ranges (earlier sources win when merging, as in the build)
+    int src_n = -1;
+    int glyph_index_in_font = 0;
+    for (int src_i = 0; src_i < atlas->ConfigData.Size && src_n == -1; src_i++)
+    {
+        const ImFontConfig& cfg = atlas->ConfigData[src_i];
+        if (cfg.DstFont != font)
+            continue;
+        for (const ImWchar* src_range = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault(); src_range[0] && src_range[1]; src_range += 2)
+            if (codepoint >= src_range[0] && codepoint <= src_range[1])
+            {
+                glyph_index_in_font = stbtt_FindGlyphIndex(&dynamic_data->FontInfos[src_i], codepoint);
+                if (glyph_index_in_font != 0)
+                    src_n = src_i;
+                break;
+            }
+    }
+    if (src_n == -1)
+        return NULL;
+    const ImFontConfig& cfg = atlas->ConfigData[src_n];
+    const stbtt_fontinfo* font_info = &dynamic_data->FontInfos[src_n];
+
+    // Measure and pack
+    const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(font_info, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(font_info, -cfg.SizePixels);
+    const int padding = atlas->TexGlyphPadding;
+    stbrp_rect r = {};
+    ImFontAtlasBuildCalcGlyphRectSize(atlas, cfg, font_info, scale, glyph_index_in_font, &r);
+    if (!ImFontAtlasBuildDynamicPackRect(atlas, &r))
+    {
+        dynamic_data->GlyphsRequested.ClearBit(request_n); // Try again next frame
+        return NULL;
+    }
+    const ImFontAtlasTexUpdate update = { (unsigned short)r.x, (unsigned short)r.y, (unsigned short)r.w, (unsigned short)r.h };
+
+    // Rasterize with the same stb_truetype code path as the build (only the fields it reads are set in the pack context)
+    stbtt_pack_context spc = {};
+    spc.width = atlas->TexWidth;
+    spc.height = atlas->TexHeight;
+    spc.stride_in_bytes = atlas->TexWidth;
+    spc.padding = padding;
+    spc.h_oversample = spc.v_oversample = 1;
+    spc.pixels = atlas->TexPixelsAlpha8;
+    int codepoint_in_range = (int)codepoint;
+    stbtt_packedchar pc = {};
+    stbtt_pack_range pack_range = {};
+    pack_range.font_size = cfg.SizePixels;
+    pack_range.array_of_unicode_codepoints = &codepoint_in_range;
+    pack_range.num_chars = 1;
+    pack_range.chardata_for_range = &pc;
+    pack_range.h_oversample = (unsigned char)cfg.OversampleH;
+    pack_range.v_oversample = (unsigned char)cfg.OversampleV;
+    if (atlas->Flags & ImFontAtlasFlags_SDF)
+        ImFontAtlasBuildRenderRangeSDF(atlas, font_info, &pack_range, &r);
+    else
+        stbtt_PackFontRangesRenderIntoRects(&spc, font_info, &pack_range, 1, &r);
+    if (cfg.RasterizerMultiply != 1.0f && !(atlas->Flags & ImFontAtlasFlags_SDF))
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r.x, r.y, r.w, r.h, atlas->TexWidth * 1);
+    }
+    if (atlas->TexPixelsRGBA32)
+        for (int y = update.Y; y < update.Y + update.Height; y++)
+        {
+            const unsigned char* src = atlas->TexPixelsAlpha8 + (size_t)y * atlas->TexWidth + update.X;
+            unsigned int* dst = atlas->TexPixelsRGBA32 + (size_t)y * atlas->TexWidth + update.X;
+            for (int n = update.Width; n > 0; n--)
+                *dst++ = IM_COL32(255, 255, 255, (unsigned int)(*src++));
+        }
+    atlas->TexUpdates.push_back(update);
+
+    // Register glyph
+    const float font_off_x = cfg.GlyphOffset.x;
+    const float font_off_y = cfg.GlyphOffset.y + IM_ROUND(font->Ascent);
+    stbtt_aligned_quad q;
+    float unused_x = 0.0f, unused_y = 0.0f;
+    stbtt_GetPackedQuad(&pc, atlas->TexWidth, atlas->TexHeight, 0, &unused_x, &unused_y, &q, 0);
+    font->AddGlyph(&cfg, codepoint, q.x0 + font_off_x, q.y0 + font_off_y, q.x1 + font_off_x, q.y1 + font_off_y, q.s0, q.t0, q.s1, q.t1, pc.xadvance);
+
+    // Update lookup tables incrementally instead of calling BuildLookupTable()
+    const int glyph_n = font->Glyphs.Size - 1;
+    const int slot = font->AllocIndexSlot(codepoint);
+    font->IndexAdvanceX[slot] = font->Glyphs[glyph_n].AdvanceX;
+    font->IndexLookup[slot] = (ImWchar)glyph_n;
+    const int page_n = (int)codepoint / 4096;
+    font->Used4kPagesMap[page_n >> 3] |= 1 << (page_n & 7);
+    font->FallbackGlyph = font->FindGlyphNoFallback(font->FallbackChar); // Glyphs[] may have been reallocated
+    font->DirtyLookupTables = false;
+    return &font->Glyphs[glyph_n];
+}
+
+#else
+
+const ImFontGlyph* ImFontAtlasBuildDynamicLoadGlyph(ImFontAtlas*, ImFont*, ImWchar)
+{
+    return NULL;
+}
+
+#endif // IMGUI_ENABLE_STB_TRUETYPE
+
 void ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* font_config, float ascent, float descent)
 {
     if (!font_config->MergeMode)
@@ -2878,6 +4250,10 @@ static void ImFontAtlasBuildRenderLinesTexData(ImFontAtlas* atlas)
 // Note: this is called / shared by both the stb_truetype and the FreeType builder
 void ImFontAtlasBuildInit(ImFontAtlas* atlas)
 {
+    // Baked lines are coverage data, they can't be sampled as a distance field
+    if (atlas->Flags & ImFontAtlasFlags_SDF)
+        atlas->Flags |= ImFontAtlasFlags_NoBakedLines;
+
     // Register texture region for mouse cursors or standard white pixels
     if (atlas->PackIdMouseCursors < 0)
     {
@@ -2901,6 +4277,7 @@ void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
 {
     // Render into our custom data blocks
     IM_ASSERT(atlas->TexPixelsAlpha8 != NULL || atlas->TexPixelsRGBA32 != NULL);
+    atlas->GlyphsGeneration++;
     ImFontAtlasBuildRenderDefaultTexData(atlas);
     ImFontAtlasBuildRenderLinesTexData(atlas);
 
@@ -3262,6 +4639,8 @@ void    ImFont::ClearOutputData()
     Glyphs.clear();
     IndexAdvanceX.clear();
     IndexLookup.clear();
+    IndexPages.clear();
+    KerningPairs.clear();
     FallbackGlyph = NULL;
     ContainerAtlas = NULL;
     DirtyLookupTables = true;
@@ -3271,22 +4650,21 @@ void    ImFont::ClearOutputData()
 
 void ImFont::BuildLookupTable()
 {
-    int max_codepoint = 0;
-    for (int i = 0; i != Glyphs.Size; i++)
-        max_codepoint = ImMax(max_codepoint, (int)Glyphs[i].Codepoint);
-
     // Build lookup table
-    IM_ASSERT(Glyphs.Size < 0xFFFF); // -1 is reserved
+    // Only the IM_FONT_INDEX_PAGE_SIZE pages holding at least one glyph are allocated, so a CJK or icon font doesn't pay for the unused code-points below its highest one.
+    IM_ASSERT((unsigned int)Glyphs.Size < (unsigned int)(ImWchar)-1); // -1 is reserved
     IndexAdvanceX.clear();
     IndexLookup.clear();
+    IndexPages.clear();
     DirtyLookupTables = false;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
-    GrowIndex(max_codepoint + 1);
+    AllocIndexSlot(0); // Page 0 (ASCII + Latin-1) is always allocated first
     for (int i = 0; i < Glyphs.Size; i++)
     {
         int codepoint = (int)Glyphs[i].Codepoint;
-        IndexAdvanceX[codepoint] = Glyphs[i].AdvanceX;
-        IndexLookup[codepoint] = (ImWchar)i;
+        const int slot = AllocIndexSlot((ImWchar)codepoint);
+        IndexAdvanceX[slot] = Glyphs[i].AdvanceX;
+        IndexLookup[slot] = (ImWchar)i;
 
         // Mark 4K page as used
         const int page_n = codepoint / 4096;
@@ -3303,7 +4681,7 @@ void ImFont::BuildLookupTable()
         tab_glyph = *FindGlyph((ImWchar)' ');
         tab_glyph.Codepoint = '\t';
         tab_glyph.AdvanceX *= IM_TABSIZE;
-        IndexAdvanceX[(int)tab_glyph.Codepoint] = (float)tab_glyph.AdvanceX;
+        IndexAdvanceX[(int)tab_glyph.Codepoint] = (float)tab_glyph.AdvanceX; // Page 0
         IndexLookup[(int)tab_glyph.Codepoint] = (ImWchar)(Glyphs.Size - 1);
     }
 
@@ -3314,8 +4692,8 @@ void ImFont::BuildLookupTable()
     // Setup fall-backs
     FallbackGlyph = FindGlyphNoFallback(FallbackChar);
     FallbackAdvanceX = FallbackGlyph ? FallbackGlyph->AdvanceX : 0.0f;
-    for (int i = 0; i < max_codepoint + 1; i++)
-        if (IndexAdvanceX[i] < 0.0f)
+    for (int i = 0; i < IndexLookup.Size; i++)
+        if (IndexLookup[i] == (ImWchar)-1)
             IndexAdvanceX[i] = FallbackAdvanceX;
 }
 
@@ -3344,13 +4722,29 @@ void ImFont::SetFallbackChar(ImWchar c)
     BuildLookupTable();
 }
 
-void ImFont::GrowIndex(int new_size)
+// Index page 1 is never written to: every code-point page without a glyph points to it, so lookups don't need to test for missing pages.
+#define IM_FONT_INDEX_EMPTY_PAGE    1
+
+int ImFont::AllocIndexSlot(ImWchar c)
 {
     IM_ASSERT(IndexAdvanceX.Size == IndexLookup.Size);
-    if (new_size <= IndexLookup.Size)
-        return;
-    IndexAdvanceX.resize(new_size, -1.0f);
-    IndexLookup.resize(new_size, (ImWchar)-1);
+    const int page_n = (int)c / IM_FONT_INDEX_PAGE_SIZE;
+    if (IndexPages.Size == 0)
+    {
+        // Page 0 always comes first so ASCII/Latin-1 can be read directly from IndexAdvanceX[]
+        IndexPages.push_back(0);
+        IndexAdvanceX.resize(IM_FONT_INDEX_PAGE_SIZE * 2, FallbackAdvanceX);
+        IndexLookup.resize(IM_FONT_INDEX_PAGE_SIZE * 2, (ImWchar)-1);
+    }
+    if (page_n >= IndexPages.Size)
+        IndexPages.resize(page_n + 1, IM_FONT_INDEX_EMPTY_PAGE);
+    if (IndexPages[page_n] == IM_FONT_INDEX_EMPTY_PAGE)
+    {
+        IndexPages[page_n] = (ImU16)(IndexLookup.Size / IM_FONT_INDEX_PAGE_SIZE);
+        IndexAdvanceX.resize(IndexAdvanceX.Size + IM_FONT_INDEX_PAGE_SIZE, FallbackAdvanceX);
+        IndexLookup.resize(IndexLookup.Size + IM_FONT_INDEX_PAGE_SIZE, (ImWchar)-1);
+    }
+    return IndexPages[page_n] * IM_FONT_INDEX_PAGE_SIZE + ((int)c % IM_FONT_INDEX_PAGE_SIZE);
 }
 
 // x0/y0/x1/y1 are offset from the character upper-left layout position, in pixels. Therefore x0/y0 are often fairly close to zero.
@@ -3400,42 +4794,111 @@ void ImFont::AddGlyph(const ImFontConfig* cfg, ImWchar codepoint, float x0, floa
     MetricsTotalSurface += (int)((glyph.U1 - glyph.U0) * ContainerAtlas->TexWidth + pad) * (int)((glyph.V1 - glyph.V0) * ContainerAtlas->TexHeight + pad);
 }
 
+// Kerning pairs are stored in an open-addressed hash table with linear probing. Keeping it at most half full makes the
+// common case of a pair without kerning end on an empty slot after one or two probes.
+static inline unsigned int ImFontKerningHash(unsigned int left, unsigned int right)
+{
+    unsigned int h = (left * 0x9E3779B1u + right) * 0x85EBCA6Bu;
+    return h ^ (h >> 15);
+}
+
+static inline float ImFontFindKerning(const ImFontKerningPair* pairs, unsigned int mask, unsigned int left, unsigned int right)
+{
+    for (unsigned int i = ImFontKerningHash(left, right) & mask; ; i = (i + 1) & mask)
+    {
+        const ImFontKerningPair& pair = pairs[i];
+        if (pair.Left == left && pair.Right == right)
+            return pair.AdvanceX;
+        if (pair.Left == 0)
+            return 0.0f;
+    }
+}
+
+void ImFont::BuildKerningTable(const ImFontKerningPair* pairs, int pairs_count)
+{
+    KerningPairs.clear();
+    if (pairs_count == 0)
+        return;
+    KerningPairs.resize(ImUpperPowerOfTwo(pairs_count * 2));
+    memset(KerningPairs.Data, 0, (size_t)KerningPairs.size_in_bytes());
+    const unsigned int mask = (unsigned int)KerningPairs.Size - 1;
+    for (int n = 0; n < pairs_count; n++)
+    {
+        const ImFontKerningPair& pair = pairs[n];
+        IM_ASSERT(pair.Left != 0 && pair.Right != 0);
+        unsigned int i = ImFontKerningHash(pair.Left, pair.Right) & mask;
+        while (KerningPairs.Data[i].Left != 0)
+        {
+            IM_ASSERT(KerningPairs.Data[i].Left != pair.Left || KerningPairs.Data[i].Right != pair.Right); // Duplicate pair
+            i = (i + 1) & mask;
+        }
+        KerningPairs.Data[i] = pair;
+    }
+}
+
+float ImFont::GetKerning(ImWchar left, ImWchar right) const
+{
+    if (KerningPairs.Size == 0 || left == 0)
+        return 0.0f;
+    return ImFontFindKerning(KerningPairs.Data, (unsigned int)KerningPairs.Size - 1, left, right);
+}
+
 void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 {
     IM_ASSERT(IndexLookup.Size > 0);    // Currently this can only be called AFTER the font has been built, aka after calling ImFontAtlas::GetTexDataAs*() function.
-    unsigned int index_size = (unsigned int)IndexLookup.Size;
+    const int dst_slot = GetIndexSlot(dst);
+    const int src_slot = GetIndexSlot(src);
 
-    if (dst < index_size && IndexLookup.Data[dst] == (ImWchar)-1 && !overwrite_dst) // 'dst' already exists
+    if (dst_slot >= 0 && IndexLookup.Data[dst_slot] == (ImWchar)-1 && !overwrite_dst) // 'dst' already exists
         return;
-    if (src >= index_size && dst >= index_size) // both 'dst' and 'src' don't exist -> no-op
+    if (src_slot < 0 && dst_slot < 0) // both 'dst' and 'src' don't exist -> no-op
         return;
 
-    GrowIndex(dst + 1);
-    IndexLookup[dst] = (src < index_size) ? IndexLookup.Data[src] : (ImWchar)-1;
-    IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
+    const int slot = AllocIndexSlot(dst); // Doesn't move existing slots
+    IndexLookup[slot] = (src_slot >= 0) ? IndexLookup.Data[src_slot] : (ImWchar)-1;
+    IndexAdvanceX[slot] = (src_slot >= 0) ? IndexAdvanceX.Data[src_slot] : 1.0f;
 }
 
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
 {
-    if (c >= (size_t)IndexLookup.Size)
-        return FallbackGlyph;
-    const ImWchar i = IndexLookup.Data[c];
-    if (i == (ImWchar)-1)
+    const int slot = GetIndexSlot(c);
+    if (slot < 0 || IndexLookup.Data[slot] == (ImWchar)-1)
+    {
+        if (ContainerAtlas && ContainerAtlas->DynamicData)
+            if (const ImFontGlyph* glyph = ImFontAtlasBuildDynamicLoadGlyph(ContainerAtlas, (ImFont*)this, c))
+                return glyph;
         return FallbackGlyph;
-    return &Glyphs.Data[i];
+    }
+    return &Glyphs.Data[IndexLookup.Data[slot]];
 }
 
 const ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c) const
 {
-    if (c >= (size_t)IndexLookup.Size)
+    const int slot = GetIndexSlot(c);
+    if (slot < 0)
         return NULL;
-    const ImWchar i = IndexLookup.Data[c];
+    const ImWchar i = IndexLookup.Data[slot];
     if (i == (ImWchar)-1)
         return NULL;
     return &Glyphs.Data[i];
 }
 
-const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const char* text_end, float wrap_width) const
+// Kerning lookups are compiled in a separate instance: fonts without kerning don't pay for them in this loop (they cost registers, not just a branch).
+// The instances without kerning are forced inline in the public functions, and the kerning ones are kept out of line. Left to the compiler,
+// both were inlined in each public function and short strings got ~20% slower (bench_kerning); calling both out of line costs one more call per string.
+#if defined(_MSC_VER)
+#define IM_FONT_TEXT_INLINE     __forceinline
+#define IM_FONT_TEXT_NOINLINE   __declspec(noinline)
+#elif defined(__GNUC__)
+#define IM_FONT_TEXT_INLINE     inline __attribute__((always_inline))
+#define IM_FONT_TEXT_NOINLINE   __attribute__((noinline))
+#else
+#define IM_FONT_TEXT_INLINE     inline
+#define IM_FONT_TEXT_NOINLINE
+#endif
+
+template<bool KERNING>
+static IM_FONT_TEXT_INLINE const char* ImFontCalcWordWrapPositionT(const ImFont* font, float scale, const char* text, const char* text_end, float wrap_width)
 {
     // Simple word-wrapping for English, not full-featured. Please submit failing cases!
     // FIXME: Much possible improvements (don't cut things like "word !", "word!!!" but cut within "word,,,,", more sensible support for punctuations, support for Unicode punctuations, etc.)
@@ -3460,6 +4923,9 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
     const char* word_end = text;
     const char* prev_word_end = NULL;
     bool inside_word = true;
+    const bool dynamic_glyphs = font->ContainerAtlas && font->ContainerAtlas->DynamicData;
+    const unsigned int kerning_mask = (unsigned int)font->KerningPairs.Size - 1;
+    unsigned int prev_c = 0;
 
     const char* s = text;
     while (s < text_end)
@@ -3479,6 +4945,8 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
             {
                 line_width = word_width = blank_width = 0.0f;
                 inside_word = true;
+                if (KERNING)
+                    prev_c = 0;
                 s = next_s;
                 continue;
             }
@@ -3489,7 +4957,14 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
             }
         }
 
-        const float char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX.Data[c] : FallbackAdvanceX);
+        if (dynamic_glyphs && !font->FindGlyphNoFallback((ImWchar)c))
+            font->FindGlyph((ImWchar)c); // Rasterize now so that IndexAdvanceX[] holds its real advance
+        float char_width = font->GetCharAdvance((ImWchar)c);
+        if (KERNING)
+        {
+            char_width += ImFontFindKerning(font->KerningPairs.Data, kerning_mask, prev_c, c);
+            prev_c = c;
+        }
         if (ImCharIsBlankW(c))
         {
             if (inside_word)
@@ -3534,19 +5009,37 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
     return s;
 }
 
-ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining) const
+static IM_FONT_TEXT_NOINLINE const char* ImFontCalcWordWrapPositionKerning(const ImFont* font, float scale, const char* text, const char* text_end, float wrap_width)
+{
+    return ImFontCalcWordWrapPositionT<true>(font, scale, text, text_end, wrap_width);
+}
+
+const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const char* text_end, float wrap_width) const
+{
+    if (KerningPairs.Size > 0)
+        return ImFontCalcWordWrapPositionKerning(this, scale, text, text_end, wrap_width);
+    return ImFontCalcWordWrapPositionT<false>(this, scale, text, text_end, wrap_width);
+}
+
+// Instanced with and without kerning, like ImFontCalcWordWrapPositionT()
+template<bool KERNING>
+static IM_FONT_TEXT_INLINE ImVec2 ImFontCalcTextSizeT(const ImFont* font, float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining)
 {
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // FIXME-OPT: Need to avoid this.
 
     const float line_height = size;
-    const float scale = size / FontSize;
+    const float scale = size / font->FontSize;
 
     ImVec2 text_size = ImVec2(0, 0);
     float line_width = 0.0f;
 
     const bool word_wrap_enabled = (wrap_width > 0.0f);
     const char* word_wrap_eol = NULL;
+    const bool dynamic_glyphs = font->ContainerAtlas && font->ContainerAtlas->DynamicData;
+    const bool ascii_fast_path = !KERNING && !word_wrap_enabled && !dynamic_glyphs && font->IndexAdvanceX.Size >= 0x80;
+    const unsigned int kerning_mask = (unsigned int)font->KerningPairs.Size - 1;
+    unsigned int prev_c = 0;
 
     const char* s = text_begin;
     while (s < text_end)
@@ -3556,7 +5049,7 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
             // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
             if (!word_wrap_eol)
             {
-                word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - line_width);
+                word_wrap_eol = ImFontCalcWordWrapPositionT<KERNING>(font, scale, s, text_end, wrap_width - line_width);
                 if (word_wrap_eol == s) // Wrap_width is too small to fit anything. Force displaying 1 character to minimize the height discontinuity.
                     word_wrap_eol++;    // +1 may not be a character start point in UTF-8 but it's ok because we use s >= word_wrap_eol below
             }
@@ -3568,6 +5061,8 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
                 text_size.y += line_height;
                 line_width = 0.0f;
                 word_wrap_eol = NULL;
+                if (KERNING)
+                    prev_c = 0;
 
                 // Wrapping skips upcoming blanks
                 while (s < text_end)
@@ -3579,6 +5074,32 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
             }
         }
 
+#ifdef IMGUI_ENABLE_SSE
+        // Fast path: measure runs of printable ASCII, classifying 16 bytes at a time. Advances are accumulated in the same order
+        // as below so the result is identical. Control characters, multi-byte sequences and the max_width cut-off fall through.
+        // Runs need at least 2 characters: single spaces between CJK words would pay for a 16 bytes load each.
+        if (ascii_fast_path && s + 1 < text_end && (unsigned char)(s[0] - 0x20) < 0x60 && (unsigned char)(s[1] - 0x20) < 0x60)
+        {
+            while (s + 16 <= text_end)
+            {
+                const __m128i v = _mm_loadu_si128((const __m128i*)(const void*)s);
+                const int mask = _mm_movemask_epi8(_mm_cmplt_epi8(v, _mm_set1_epi8(0x20))); // Signed compare: bytes >= 0x80 are negative
+                const char* run_end = s + (mask ? ImCountTrailingZeros((unsigned int)mask) : 16);
+                for (; s < run_end; s++)
+                {
+                    const float char_width = font->IndexAdvanceX.Data[(unsigned char)*s] * scale;
+                    if (line_width + char_width >= max_width)
+                        break;
+                    line_width += char_width;
+                }
+                if (s != run_end || mask != 0)
+                    break;
+            }
+            if (s >= text_end)
+                break;
+        }
+#endif
+
         // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
@@ -3600,13 +5121,22 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
                 text_size.x = ImMax(text_size.x, line_width);
                 text_size.y += line_height;
                 line_width = 0.0f;
+                if (KERNING)
+                    prev_c = 0;
                 continue;
             }
             if (c == '\r')
                 continue;
         }
 
-        const float char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX.Data[c] : FallbackAdvanceX) * scale;
+        if (dynamic_glyphs && !font->FindGlyphNoFallback((ImWchar)c))
+            font->FindGlyph((ImWchar)c); // Rasterize now so that IndexAdvanceX[] holds its real advance
+        float char_width = font->GetCharAdvance((ImWchar)c) * scale;
+        if (KERNING)
+        {
+            char_width += ImFontFindKerning(font->KerningPairs.Data, kerning_mask, prev_c, c) * scale;
+            prev_c = c;
+        }
         if (line_width + char_width >= max_width)
         {
             s = prev_s;
@@ -3628,12 +5158,26 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     return text_size;
 }
 
+static IM_FONT_TEXT_NOINLINE ImVec2 ImFontCalcTextSizeKerning(const ImFont* font, float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining)
+{
+    return ImFontCalcTextSizeT<true>(font, size, max_width, wrap_width, text_begin, text_end, remaining);
+}
+
+ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining) const
+{
+    if (KerningPairs.Size > 0)
+        return ImFontCalcTextSizeKerning(this, size, max_width, wrap_width, text_begin, text_end, remaining);
+    return ImFontCalcTextSizeT<false>(this, size, max_width, wrap_width, text_begin, text_end, remaining);
+}
+
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
 void ImFont::RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, ImWchar c) const
 {
     const ImFontGlyph* glyph = FindGlyph(c);
     if (!glyph || !glyph->Visible)
         return;
+    if (ContainerAtlas && ContainerAtlas->DynamicData)
+        ImFontAtlasBuildDynamicTouchGlyph(ContainerAtlas->DynamicData, glyph);
     if (glyph->Colored)
         col |= ~IM_COL32_A_MASK;
     float scale = (size >= 0.0f) ? (size / FontSize) : 1.0f;
@@ -3643,8 +5187,75 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     draw_list->PrimRectUV(ImVec2(pos.x + glyph->X0 * scale, pos.y + glyph->Y0 * scale), ImVec2(pos.x + glyph->X1 * scale, pos.y + glyph->Y1 * scale), ImVec2(glyph->U0, glyph->V0), ImVec2(glyph->U1, glyph->V1), col);
 }
 
+// Emit the quads of a cached layout at 'pos', which must already be rounded like in RenderText(). Same vertices as RenderText() up to float rounding.
+static void ImFontRenderTextLayout(ImDrawList* draw_list, const ImTextLayoutCacheEntry* layout, ImVec2 pos, ImU32 col, ImFontAtlasDynamicData* dynamic_data)
+{
+    const int vtx_count = layout->Vertices.Size;
+    if (vtx_count == 0)
+        return;
+    draw_list->PrimReserve(vtx_count / 4 * 6, vtx_count);
+
+    ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+
+    const ImDrawVert* src = layout->Vertices.Data;
+#if defined(IMGUI_ENABLE_SSE) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+    if (!layout->HasColoredGlyphs)
+    {
+        // A quad is 5 x 16 bytes: translate positions with one add per lane and OR the color into the lanes holding 'col' (stored as 0)
+        IM_STATIC_ASSERT(sizeof(ImDrawVert) == 20);
+        const __m128i col_v = _mm_set1_epi32((int)col);
+        const __m128 add_0 = _mm_setr_ps(pos.x, pos.y, 0.0f, 0.0f);
+        const __m128 add_1 = _mm_setr_ps(0.0f, pos.x, pos.y, 0.0f);
+        const __m128 add_2 = _mm_setr_ps(0.0f, 0.0f, pos.x, pos.y);
+        const __m128 add_3 = _mm_setr_ps(0.0f, 0.0f, 0.0f, pos.x);
+        const __m128 add_4 = _mm_setr_ps(pos.y, 0.0f, 0.0f, 0.0f);
+        const __m128 col_1 = _mm_castsi128_ps(_mm_and_si128(col_v, _mm_setr_epi32(-1, 0, 0, 0)));
+        const __m128 col_2 = _mm_castsi128_ps(_mm_and_si128(col_v, _mm_setr_epi32(0, -1, 0, 0)));
+        const __m128 col_3 = _mm_castsi128_ps(_mm_and_si128(col_v, _mm_setr_epi32(0, 0, -1, 0)));
+        const __m128 col_4 = _mm_castsi128_ps(_mm_and_si128(col_v, _mm_setr_epi32(0, 0, 0, -1)));
+        const float* src_f = (const float*)(const void*)src;
+        float* dst_f = (float*)(void*)vtx_write;
+        for (int n = 0; n < vtx_count; n += 4, src_f += 20, dst_f += 20)
+        {
+            _mm_storeu_ps(dst_f + 0, _mm_add_ps(_mm_loadu_ps(src_f + 0), add_0));
+            _mm_storeu_ps(dst_f + 4, _mm_or_ps(_mm_add_ps(_mm_loadu_ps(src_f + 4), add_1), col_1));
+            _mm_storeu_ps(dst_f + 8, _mm_or_ps(_mm_add_ps(_mm_loadu_ps(src_f + 8), add_2), col_2));
+            _mm_storeu_ps(dst_f + 12, _mm_or_ps(_mm_add_ps(_mm_loadu_ps(src_f + 12), add_3), col_3));
+            _mm_storeu_ps(dst_f + 16, _mm_or_ps(_mm_add_ps(_mm_loadu_ps(src_f + 16), add_4), col_4));
+        }
+    }
+    else
+#endif
+    {
+        const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
+        for (int n = 0; n < vtx_count; n++)
+        {
+            vtx_write[n].pos.x = src[n].pos.x + pos.x;
+            vtx_write[n].pos.y = src[n].pos.y + pos.y;
+            vtx_write[n].uv = src[n].uv;
+            vtx_write[n].col = src[n].col ? col_untinted : col;
+        }
+    }
+    for (int n = 0; n < vtx_count; n += 4, vtx_current_idx += 4)
+    {
+        if (dynamic_data)
+            ImFontAtlasBuildDynamicTouchUV(dynamic_data, src[n].uv.y);
+        idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
+        idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
+        idx_write += 6;
+    }
+    vtx_write += vtx_count;
+    draw_list->_VtxWritePtr = vtx_write;
+    draw_list->_IdxWritePtr = idx_write;
+    draw_list->_VtxCurrentIdx = vtx_current_idx;
+}
+
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
-void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip) const
+// Instanced with and without kerning, like ImFontCalcWordWrapPositionT()
+template<bool KERNING>
+static IM_FONT_TEXT_INLINE void ImFontRenderTextT(const ImFont* font, ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip)
 {
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // ImGui:: functions generally already provides a valid text_end, so this is merely to handle direct calls.
@@ -3657,8 +5268,22 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     if (y > clip_rect.w)
         return;
 
-    const float scale = size / FontSize;
-    const float line_height = FontSize * scale;
+    // Copy the glyph quads of a string drawn in a previous call when none of them can be clipped
+    ImTextLayoutCacheEntry* layout = NULL;
+    if ((draw_list->Flags & ImDrawListFlags_TextLayoutCache) && draw_list->_Data->TextLayoutCache)
+        layout = draw_list->_Data->TextLayoutCache->GetOrAdd(font, size, wrap_width, text_begin, text_end);
+    if (layout && layout->HasVertices)
+    {
+        const ImRect bb(layout->Bounds.Min + pos, layout->Bounds.Max + pos);
+        if (bb.Min.x >= clip_rect.x && bb.Min.y >= clip_rect.y && bb.Max.x <= clip_rect.z && bb.Max.y <= clip_rect.w)
+        {
+            ImFontRenderTextLayout(draw_list, layout, pos, col, font->ContainerAtlas ? font->ContainerAtlas->DynamicData : NULL);
+            return;
+        }
+    }
+
+    const float scale = size / font->FontSize;
+    const float line_height = font->FontSize * scale;
     const bool word_wrap_enabled = (wrap_width > 0.0f);
     const char* word_wrap_eol = NULL;
 
@@ -3698,8 +5323,15 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
     ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
     unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+    const ImDrawVert* vtx_begin = vtx_write;
+    const char* s_begin = s;
+    bool clipped = false;
+    bool has_colored_glyphs = false;
 
     const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
+    ImFontAtlasDynamicData* dynamic_data = font->ContainerAtlas ? font->ContainerAtlas->DynamicData : NULL;
+    const unsigned int kerning_mask = (unsigned int)font->KerningPairs.Size - 1;
+    unsigned int prev_c = 0;
 
     while (s < text_end)
     {
@@ -3708,7 +5340,7 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
             // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
             if (!word_wrap_eol)
             {
-                word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - (x - pos.x));
+                word_wrap_eol = ImFontCalcWordWrapPositionT<KERNING>(font, scale, s, text_end, wrap_width - (x - pos.x));
                 if (word_wrap_eol == s) // Wrap_width is too small to fit anything. Force displaying 1 character to minimize the height discontinuity.
                     word_wrap_eol++;    // +1 may not be a character start point in UTF-8 but it's ok because we use s >= word_wrap_eol below
             }
@@ -3718,6 +5350,8 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
                 x = pos.x;
                 y += line_height;
                 word_wrap_eol = NULL;
+                if (KERNING)
+                    prev_c = 0;
 
                 // Wrapping skips upcoming blanks
                 while (s < text_end)
@@ -3748,17 +5382,31 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
             {
                 x = pos.x;
                 y += line_height;
+                if (KERNING)
+                    prev_c = 0;
                 if (y > clip_rect.w)
+                {
+                    clipped = true;
                     break; // break out of main loop
+                }
                 continue;
             }
             if (c == '\r')
                 continue;
         }
 
-        const ImFontGlyph* glyph = FindGlyph((ImWchar)c);
+        // Inlined FindGlyph() for glyphs already in the index
+        const int glyph_slot = font->GetIndexSlot(c);
+        const ImFontGlyph* glyph = (glyph_slot >= 0 && font->IndexLookup.Data[glyph_slot] != (ImWchar)-1) ? &font->Glyphs.Data[font->IndexLookup.Data[glyph_slot]] : font->FindGlyph((ImWchar)c);
         if (glyph == NULL)
             continue;
+        if (dynamic_data)
+            ImFontAtlasBuildDynamicTouchGlyph(dynamic_data, glyph);
+        if (KERNING)
+        {
+            x += ImFontFindKerning(font->KerningPairs.Data, kerning_mask, prev_c, c) * scale;
+            prev_c = c;
+        }
 
         float char_width = glyph->AdvanceX * scale;
         if (glyph->Visible)
@@ -3807,7 +5455,12 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
                 }
 
                 // Support for untinted glyphs
-                ImU32 glyph_col = glyph->Colored ? col_untinted : col;
+                ImU32 glyph_col = col;
+                if (glyph->Colored)
+                {
+                    glyph_col = col_untinted;
+                    has_colored_glyphs = true;
+                }
 
                 // We are NOT calling PrimRectUV() here because non-inlined causes too much overhead in a debug builds. Inlined here:
                 {
@@ -3822,6 +5475,10 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
                     idx_write += 6;
                 }
             }
+            else
+            {
+                clipped = true;
+            }
         }
         x += char_width;
     }
@@ -3833,6 +5490,250 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     draw_list->_VtxWritePtr = vtx_write;
     draw_list->_IdxWritePtr = idx_write;
     draw_list->_VtxCurrentIdx = vtx_current_idx;
+
+    // Store the quads for the next calls, provided that nothing was skipped or clipped
+    if (layout && !clipped && !cpu_fine_clip && s_begin == text_begin)
+        draw_list->_Data->TextLayoutCache->SetVertices(layout, vtx_begin, (int)(vtx_write - vtx_begin), pos, col, has_colored_glyphs);
+}
+
+static IM_FONT_TEXT_NOINLINE void ImFontRenderTextKerning(const ImFont* font, ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip)
+{
+    ImFontRenderTextT<true>(font, draw_list, size, pos, col, clip_rect, text_begin, text_end, wrap_width, cpu_fine_clip);
+}
+
+void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip) const
+{
+    if (KerningPairs.Size > 0)
+        ImFontRenderTextKerning(this, draw_list, size, pos, col, clip_rect, text_begin, text_end, wrap_width, cpu_fine_clip);
+    else
+        ImFontRenderTextT<false>(this, draw_list, size, pos, col, clip_rect, text_begin, text_end, wrap_width, cpu_fine_clip);
+}
+
+// Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
+void ImFont::RenderGlyphs(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const ImWchar* glyphs, const ImVec2* offsets, int glyphs_count) const
+{
+    // Align to be pixel perfect (offsets are kept as is, shapers generally output sub-pixel positions)
+    pos.x = IM_FLOOR(pos.x);
+    pos.y = IM_FLOOR(pos.y);
+    const float scale = size / FontSize;
+
+    const int idx_expected_size = draw_list->IdxBuffer.Size + glyphs_count * 6;
+    draw_list->PrimReserve(glyphs_count * 6, glyphs_count * 4);
+
+    ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+
+    const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
+    ImFontAtlasDynamicData* dynamic_data = ContainerAtlas ? ContainerAtlas->DynamicData : NULL;
+
+    for (int n = 0; n < glyphs_count; n++)
+    {
+        const ImFontGlyph* glyph = FindGlyph(glyphs[n]);
+        if (glyph == NULL || !glyph->Visible)
+            continue;
+
+        const float x = pos.x + offsets[n].x;
+        const float y = pos.y + offsets[n].y;
+        const float x1 = x + glyph->X0 * scale;
+        const float x2 = x + glyph->X1 * scale;
+        const float y1 = y + glyph->Y0 * scale;
+        const float y2 = y + glyph->Y1 * scale;
+        if (x1 > clip_rect.z || x2 < clip_rect.x || y1 > clip_rect.w || y2 < clip_rect.y)
+            continue;
+        if (dynamic_data)
+            ImFontAtlasBuildDynamicTouchGlyph(dynamic_data, glyph);
+
+        const ImU32 glyph_col = glyph->Colored ? col_untinted : col;
+        idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
+        idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
+        vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = glyph->U0; vtx_write[0].uv.y = glyph->V0;
+        vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = glyph->U1; vtx_write[1].uv.y = glyph->V0;
+        vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = glyph_col; vtx_write[2].uv.x = glyph->U1; vtx_write[2].uv.y = glyph->V1;
+        vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = glyph_col; vtx_write[3].uv.x = glyph->U0; vtx_write[3].uv.y = glyph->V1;
+        vtx_write += 4;
+        vtx_current_idx += 4;
+        idx_write += 6;
+    }
+
+    // Give back unused vertices (clipped ones, blanks)
+    draw_list->VtxBuffer.Size = (int)(vtx_write - draw_list->VtxBuffer.Data);
+    draw_list->IdxBuffer.Size = (int)(idx_write - draw_list->IdxBuffer.Data);
+    draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
+    draw_list->_VtxWritePtr = vtx_write;
+    draw_list->_IdxWritePtr = idx_write;
+    draw_list->_VtxCurrentIdx = vtx_current_idx;
+}
+
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImTextLayoutCache
+//-----------------------------------------------------------------------------
+// Enabled with io.ConfigTextLayoutCache. Used by ImGui::CalcTextSize() and by ImFont::RenderText() on lists with ImDrawListFlags_TextLayoutCache.
+// - Strings are keyed by (font, size, wrap width, text). The measured size is stored on the first lookup, the glyph quads on the first draw
+//   which wasn't clipped. Later draws of the same string copy them translated to the new position (any color).
+// - Entries are measured and laid out again when the atlas GlyphsGeneration changes (rebuild, dynamic glyph page eviction).
+// - Memory is bounded by IM_TEXT_LAYOUT_CACHE_MAX_BYTES, entries unused for IM_TEXT_LAYOUT_CACHE_MAX_AGE frames are dropped by NewFrame().
+//-----------------------------------------------------------------------------
+
+static int ImTextLayoutCacheCalcEntryBytes(const ImTextLayoutCacheEntry* entry)
+{
+    return (int)sizeof(ImTextLayoutCacheEntry) + (int)sizeof(ImGuiStorage::ImGuiStoragePair) + (int)sizeof(ImGuiStorage::ImGuiStorageSlot) * 2 + (int)sizeof(ImTextLayoutCacheEntry*) + entry->Text.Capacity + entry->Vertices.Capacity * (int)sizeof(ImDrawVert);
+}
+
+static inline bool ImTextLayoutCacheEntryMatches(const ImTextLayoutCacheEntry* entry, const ImFont* font, float size, float wrap_width, const char* text, int text_len)
+{
+    return entry->Font == font && entry->Size == size && entry->WrapWidth == wrap_width && entry->Text.Size == text_len && memcmp(entry->Text.Data, text, (size_t)text_len) == 0;
+}
+
+void ImTextLayoutCache::Clear()
+{
+    for (int n = 0; n < Entries.Size; n++)
+        IM_DELETE(Entries[n]);
+    for (int n = 0; n < FreeEntries.Size; n++)
+        IM_DELETE(FreeEntries[n]);
+    Entries.clear();
+    FreeEntries.clear();
+    Map.Clear();
+    LastEntry = NULL;
+    TotalBytes = 0;
+}
+
+void ImTextLayoutCache::NewFrame()
+{
+    FrameCount++;
+
+    // Strings changing every frame (e.g. counters) replace entries at the rate they expire: recycling the dropped ones avoids allocating in steady state.
+    // Dropped entries are kept for another IM_TEXT_LAYOUT_CACHE_MAX_AGE frames to absorb bursts.
+    int free_dst_n = 0;
+    for (int n = 0; n < FreeEntries.Size; n++)
+    {
+        ImTextLayoutCacheEntry* entry = FreeEntries[n];
+        if (FrameCount - entry->LastUsedFrame <= IM_TEXT_LAYOUT_CACHE_MAX_AGE * 2)
+        {
+            FreeEntries[free_dst_n++] = entry;
+            continue;
+        }
+        TotalBytes -= ImTextLayoutCacheCalcEntryBytes(entry);
+        IM_DELETE(entry);
+    }
+    FreeEntries.resize(free_dst_n);
+
+    int dst_n = 0;
+    for (int n = 0; n < Entries.Size; n++)
+    {
+        ImTextLayoutCacheEntry* entry = Entries[n];
+        if (FrameCount - entry->LastUsedFrame <= IM_TEXT_LAYOUT_CACHE_MAX_AGE)
+        {
+            Entries[dst_n++] = entry;
+            continue;
+        }
+        FreeEntries.push_back(entry);
+    }
+    if (dst_n == Entries.Size)
+        return;
+    Entries.resize(dst_n);
+    LastEntry = NULL;
+
+    // Rebuild the map in one go rather than erasing pairs one by one (its hash index is rebuilt on next access)
+    Map.Data.resize(0);
+    Map.Data.reserve(Entries.Size);
+    for (int n = 0; n < Entries.Size; n++)
+        Map.Data.push_back(ImGuiStorage::ImGuiStoragePair(Entries[n]->Key, (void*)Entries[n]));
+    Map.SlotsCount = -1;
+}
+
+ImTextLayoutCacheEntry* ImTextLayoutCache::GetOrAdd(const ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end)
+{
+    const int text_len = (int)(text_end - text_begin);
+    if (text_len > IM_TEXT_LAYOUT_CACHE_MAX_TEXT_LEN)
+        return NULL;
+    if (wrap_width <= 0.0f)
+        wrap_width = 0.0f; // No wrapping: CalcTextSize() passes -1.0f, AddText() passes 0.0f
+
+    // Labels are commonly measured then drawn right away: check the last entry before hashing
+    ImTextLayoutCacheEntry* entry = LastEntry;
+    if (entry == NULL || !ImTextLayoutCacheEntryMatches(entry, font, size, wrap_width, text_begin, text_len))
+    {
+        // Hash the text only, seeded with the other parts of the key
+        ImU32 size_bits, wrap_width_bits;
+        memcpy(&size_bits, &size, sizeof(size_bits));
+        memcpy(&wrap_width_bits, &wrap_width, sizeof(wrap_width_bits));
+        const ImGuiID seed = (ImGuiID)(((size_t)font >> 4) * 2654435761u) ^ (size_bits * 40503u) ^ (wrap_width_bits * 9973u);
+        const ImGuiID key = ImHashData(text_begin, (size_t)text_len, seed);
+
+        entry = (ImTextLayoutCacheEntry*)Map.GetVoidPtr(key);
+        if (entry != NULL && !ImTextLayoutCacheEntryMatches(entry, font, size, wrap_width, text_begin, text_len))
+            return NULL; // Hash collision: keep the string which came first
+        if (entry == NULL)
+        {
+            if (TotalBytes >= IM_TEXT_LAYOUT_CACHE_MAX_BYTES)
+                return NULL;
+            if (FreeEntries.Size > 0)
+            {
+                entry = FreeEntries.back();
+                FreeEntries.pop_back();
+                TotalBytes -= ImTextLayoutCacheCalcEntryBytes(entry);
+                entry->HasVertices = entry->HasColoredGlyphs = false;
+                entry->Vertices.resize(0);
+            }
+            else
+            {
+                entry = IM_NEW(ImTextLayoutCacheEntry)();
+            }
+            entry->Key = key;
+            entry->Font = font;
+            entry->Size = size;
+            entry->WrapWidth = wrap_width;
+            entry->GlyphsGeneration = -1;
+            entry->Text.resize(text_len);
+            if (text_len > 0)
+                memcpy(entry->Text.Data, text_begin, (size_t)text_len);
+            Entries.push_back(entry);
+            Map.SetVoidPtr(key, entry);
+            TotalBytes += ImTextLayoutCacheCalcEntryBytes(entry);
+        }
+        LastEntry = entry;
+    }
+
+    const int glyphs_generation = font->ContainerAtlas ? font->ContainerAtlas->GlyphsGeneration : 0;
+    if (entry->GlyphsGeneration != glyphs_generation)
+    {
+        entry->Vertices.resize(0);
+        entry->HasVertices = false;
+        entry->GlyphsGeneration = glyphs_generation;
+        entry->TextSize = font->CalcTextSizeA(size, FLT_MAX, wrap_width, text_begin, text_end);
+    }
+    entry->LastUsedFrame = FrameCount;
+    return entry;
+}
+
+void ImTextLayoutCache::SetVertices(ImTextLayoutCacheEntry* entry, const ImDrawVert* vtx, int vtx_count, ImVec2 origin, ImU32 col, bool has_colored_glyphs)
+{
+    // Colored glyphs are told apart by their vertex color, which is the same as other glyphs when 'col' is already white
+    const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
+    if (has_colored_glyphs && col == col_untinted)
+        return;
+    // Glyphs may have been rasterized and others evicted while drawing: the entry will be measured again on next lookup
+    if (entry->Font->ContainerAtlas && entry->Font->ContainerAtlas->GlyphsGeneration != entry->GlyphsGeneration)
+        return;
+    if (TotalBytes + vtx_count * (int)sizeof(ImDrawVert) > IM_TEXT_LAYOUT_CACHE_MAX_BYTES)
+        return;
+
+    TotalBytes -= entry->Vertices.Capacity * (int)sizeof(ImDrawVert);
+    entry->Vertices.resize(vtx_count);
+    TotalBytes += entry->Vertices.Capacity * (int)sizeof(ImDrawVert);
+    entry->Bounds = ImRect(ImVec2(0.0f, 0.0f), entry->TextSize);
+    entry->HasColoredGlyphs = has_colored_glyphs;
+    for (int n = 0; n < vtx_count; n++)
+    {
+        ImDrawVert& dst = entry->Vertices.Data[n];
+        dst.pos = ImVec2(vtx[n].pos.x - origin.x, vtx[n].pos.y - origin.y);
+        dst.uv = vtx[n].uv;
+        dst.col = (has_colored_glyphs && vtx[n].col == col_untinted) ? 1 : 0;
+        entry->Bounds.Add(dst.pos);
+    }
+    entry->HasVertices = true;
 }
 
 //-----------------------------------------------------------------------------
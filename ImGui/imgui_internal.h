@@ -56,6 +56,9 @@ Index of this file:
 #define IMGUI_ENABLE_SSE
 #include <immintrin.h>
 #endif
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>     // _BitScanForward, _InterlockedExchangeAdd
+#endif
 
 // Visual Studio warnings
 #ifdef _MSC_VER
@@ -110,10 +113,13 @@ struct ImBitVector;                 // Store 1-bit per value
 struct ImRect;                      // An axis-aligned rectangle (2 points)
 struct ImDrawDataBuilder;           // Helper to build a ImDrawData instance
 struct ImDrawListSharedData;        // Data shared between all ImDrawList instances
+struct ImTextLayoutCache;           // Measured size and glyph quads of recently drawn strings (io.ConfigTextLayoutCache)
+struct ImGuiBufferStats;            // Usage of a buffer over a period of frames (capacity, high-water mark, reallocations), for the Metrics window
 struct ImGuiColorMod;               // Stacked color modifier, backup of modified data so we can restore it
 struct ImGuiContext;                // Main Dear ImGui context
 struct ImGuiContextHook;            // Hook for extensions like ImGuiTestEngine
 struct ImGuiDataTypeInfo;           // Type information associated to a ImGuiDataType enum
+struct ImGuiDrawListStats;          // ImGuiBufferStats of the buffers of a ImDrawList
 struct ImGuiGroupData;              // Stacked storage data for BeginGroup()/EndGroup()
 struct ImGuiInputTextState;         // Internal state of the currently focused/edited text input box
 struct ImGuiLastItemDataBackup;     // Backup and restore IsItemHovered() internal data
@@ -300,6 +306,13 @@ IMGUI_API ImU32         ImAlphaBlendColors(ImU32 col_a, ImU32 col_b);
 static inline bool      ImIsPowerOfTwo(int v)           { return v != 0 && (v & (v - 1)) == 0; }
 static inline bool      ImIsPowerOfTwo(ImU64 v)         { return v != 0 && (v & (v - 1)) == 0; }
 static inline int       ImUpperPowerOfTwo(int v)        { v--; v |= v >> 1; v |= v >> 2; v |= v >> 4; v |= v >> 8; v |= v >> 16; v++; return v; }
+#if defined(_MSC_VER) && !defined(__clang__)
+static inline int       ImCountTrailingZeros(unsigned int v) { unsigned long r; _BitScanForward(&r, v); return (int)r; } // v must be non-zero
+#elif defined(__GNUC__) || defined(__clang__)
+static inline int       ImCountTrailingZeros(unsigned int v) { return __builtin_ctz(v); }                                // v must be non-zero
+#else
+static inline int       ImCountTrailingZeros(unsigned int v) { int n = 0; while (!(v & 1)) { v >>= 1; n++; } return n; } // v must be non-zero
+#endif
 
 // Helpers: String, Formatting
 IMGUI_API int           ImStricmp(const char* str1, const char* str2);
@@ -376,6 +389,8 @@ IMGUI_API ImU64             ImFileWrite(const void* data, ImU64 size, ImU64 coun
 #define IMGUI_DISABLE_TTY_FUNCTIONS // Can't use stdout, fflush if we are not using default file functions
 #endif
 IMGUI_API void*             ImFileLoadToMemory(const char* filename, const char* mode, size_t* out_file_size = NULL, int padding_bytes = 0);
+IMGUI_API const void*       ImFileMap(const char* filename, size_t* out_file_size);    // Map file content read-only (mmap/MapViewOfFile when available), release with ImFileUnmap()
+IMGUI_API void              ImFileUnmap(const void* file_data, size_t file_size);
 
 // Helpers: Maths
 IM_MSVC_RUNTIME_CHECKS_OFF
@@ -692,8 +707,56 @@ struct IMGUI_API ImChunkStream
 #endif
 #define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE // Sample index _PathArcToFastEx() for 360 angle.
 
+// ImFont::RenderText(), ImGui::CalcTextSize(): text layout cache limits (io.ConfigTextLayoutCache)
+#ifndef IM_TEXT_LAYOUT_CACHE_MAX_TEXT_LEN
+#define IM_TEXT_LAYOUT_CACHE_MAX_TEXT_LEN                       256         // Longer strings are never cached.
+#endif
+#ifndef IM_TEXT_LAYOUT_CACHE_MAX_BYTES
+#define IM_TEXT_LAYOUT_CACHE_MAX_BYTES                          (1 << 20)   // No new strings are cached while the cache uses more memory than this.
+#endif
+#ifndef IM_TEXT_LAYOUT_CACHE_MAX_AGE
+#define IM_TEXT_LAYOUT_CACHE_MAX_AGE                            60          // Number of frames after which an unused string is dropped.
+#endif
+
+// One string of the text layout cache, keyed by (font, size, wrap width, text).
+// Vertices are those emitted by ImFont::RenderText() at the origin, 4 per glyph quad. Their color is 0 for tinted glyphs and 1 for untinted (colored) glyphs.
+struct ImTextLayoutCacheEntry
+{
+    ImGuiID                 Key;                // Hash of Text, seeded with Font, Size and WrapWidth
+    const ImFont*           Font;
+    float                   Size;
+    float                   WrapWidth;
+    int                     GlyphsGeneration;   // Font->ContainerAtlas->GlyphsGeneration when TextSize/Vertices were computed
+    int                     LastUsedFrame;      // Value of ImTextLayoutCache::FrameCount
+    bool                    HasVertices;        // Vertices/Bounds are valid. Only set from a draw which wasn't clipped.
+    bool                    HasColoredGlyphs;   // Some Vertices have a color of 1
+    ImVec2                  TextSize;           // ImFont::CalcTextSizeA(Size, FLT_MAX, WrapWidth) (not rounded)
+    ImRect                  Bounds;             // Vertices and TextSize, relative to the origin
+    ImVector<char>          Text;
+    ImVector<ImDrawVert>    Vertices;
+};
+
+struct IMGUI_API ImTextLayoutCache
+{
+    ImVector<ImTextLayoutCacheEntry*> Entries;
+    ImVector<ImTextLayoutCacheEntry*> FreeEntries; // Dropped entries, reused by new strings along with their buffers. Deleted after another IM_TEXT_LAYOUT_CACHE_MAX_AGE frames.
+    ImGuiStorage            Map;                // Key -> ImTextLayoutCacheEntry*
+    ImTextLayoutCacheEntry* LastEntry;          // Returned by the last GetOrAdd() call
+    int                     FrameCount;
+    int                     TotalBytes;         // Memory used by the entries, including FreeEntries
+
+    ImTextLayoutCache()     { LastEntry = NULL; FrameCount = TotalBytes = 0; }
+    ~ImTextLayoutCache()    { Clear(); }
+    void                    Clear();
+    void                    NewFrame();         // Drop entries unused for IM_TEXT_LAYOUT_CACHE_MAX_AGE frames (to FreeEntries)
+    ImTextLayoutCacheEntry* GetOrAdd(const ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end); // NULL if the string can't be cached
+    void                    SetVertices(ImTextLayoutCacheEntry* entry, const ImDrawVert* vtx, int vtx_count, ImVec2 origin, ImU32 col, bool has_colored_glyphs);
+};
+
 // Data shared between all ImDrawList instances
 // You may want to create your own instance of this if you want to use ImDrawList completely without ImGui. In that case, watch out for future changes to this structure.
+// Between NewFrame() and Render(), only Font/FontSize are modified (by PushFont()/PopFont()) and TextLayoutCache is used by the main thread: everything else
+// may be read concurrently by worker threads (see ImDrawList::AddDrawList()). Worker buffers grow through ImGui::MemAlloc(), whose counters are atomic.
 struct IMGUI_API ImDrawListSharedData
 {
     ImVec2          TexUvWhitePixel;            // UV of white pixel in the atlas
@@ -709,6 +772,7 @@ struct IMGUI_API ImDrawListSharedData
     float           ArcFastRadiusCutoff;                        // Cutoff radius after which arc drawing will fallback to slower PathArcTo()
     ImU8            CircleSegmentCounts[64];    // Precomputed segment count for given radius before we calculate it dynamically (to avoid calculation overhead)
     const ImVec4*   TexUvLines;                 // UV of anti-aliased lines in the atlas
+    ImTextLayoutCache* TextLayoutCache;         // Only used by lists with ImDrawListFlags_TextLayoutCache (main thread only). NULL when io.ConfigTextLayoutCache is disabled.
 
     ImDrawListSharedData();
     void SetCircleTessellationMaxError(float max_error);
@@ -724,6 +788,30 @@ struct ImDrawDataBuilder
     IMGUI_API void FlattenIntoSingleLayer();
 };
 
+// Usage of a buffer over a period of frames, sampled by NewFrame() for the "Memory" section of the Metrics window
+struct ImGuiBufferStats
+{
+    int         Capacity;           // Capacity at the end of the last sampled frame, to detect reallocations
+    int         SizeMax;            // High-water mark of the current period
+    int         Reallocs;           // Number of frames in which the capacity changed (growth, compaction, wake up) during the current period
+    int         LastSizeMax;        // Values of the previous period
+    int         LastReallocs;
+
+    ImGuiBufferStats()  { memset(this, 0, sizeof(*this)); }
+    void        Sample(int size, int capacity)  { if (capacity != Capacity) { Capacity = capacity; Reallocs++; } if (size > SizeMax) SizeMax = size; }
+    void        NextPeriod()                    { LastSizeMax = SizeMax; LastReallocs = Reallocs; SizeMax = Reallocs = 0; }
+};
+
+struct ImGuiDrawListStats
+{
+    ImGuiBufferStats    CmdBuffer;
+    ImGuiBufferStats    IdxBuffer;
+    ImGuiBufferStats    VtxBuffer;
+
+    void        Sample(const ImDrawList* draw_list) { CmdBuffer.Sample(draw_list->CmdBuffer.Size, draw_list->CmdBuffer.Capacity); IdxBuffer.Sample(draw_list->IdxBuffer.Size, draw_list->IdxBuffer.Capacity); VtxBuffer.Sample(draw_list->VtxBuffer.Size, draw_list->VtxBuffer.Capacity); }
+    void        NextPeriod()                        { CmdBuffer.NextPeriod(); IdxBuffer.NextPeriod(); VtxBuffer.NextPeriod(); }
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Widgets support: flags, enums, data structures
 //-----------------------------------------------------------------------------
@@ -1241,6 +1329,7 @@ struct ImGuiViewportP : public ImGuiViewport
 {
     int                 DrawListsLastFrame[2];  // Last frame number the background (0) and foreground (1) draw lists were used
     ImDrawList*         DrawLists[2];           // Convenience background (0) and foreground (1) draw lists. We use them to draw software mouser cursor when io.MouseDrawCursor is set and to draw most debug overlays.
+    ImGuiDrawListStats  DrawListsStats[2];      // Buffers usage of the background (0) and foreground (1) draw lists, for the Metrics window
     ImDrawData          DrawDataP;
     ImDrawDataBuilder   DrawDataBuilder;
 
@@ -1310,6 +1399,7 @@ struct ImGuiMetricsConfig
     bool        ShowDrawCmdBoundingBoxes;
     int         ShowWindowsRectsType;
     int         ShowTablesRectsType;
+    int         MemoryStatsPeriod;      // Number of frames over which ImGuiBufferStats are accumulated
 
     ImGuiMetricsConfig()
     {
@@ -1320,6 +1410,7 @@ struct ImGuiMetricsConfig
         ShowDrawCmdBoundingBoxes = true;
         ShowWindowsRectsType = -1;
         ShowTablesRectsType = -1;
+        MemoryStatsPeriod = 120;
     }
 };
 
@@ -1370,6 +1461,9 @@ struct ImGuiContext
     float                   FontSize;                           // (Shortcut) == FontBaseSize * g.CurrentWindow->FontWindowScale == window->FontSize(). Text height for current window.
     float                   FontBaseSize;                       // (Shortcut) == IO.FontGlobalScale * Font->Scale * Font->FontSize. Base text height.
     ImDrawListSharedData    DrawListSharedData;
+    ImTextLayoutCache       TextLayoutCache;                    // Used when io.ConfigTextLayoutCache is enabled
+    int                     FrameAllocCount;                    // MemAlloc() calls since NewFrame(), published to io.MetricsFrameAllocations by the next one
+    int                     FrameFreeCount;                     // MemFree() calls since NewFrame(), published to io.MetricsFrameFrees by the next one
     double                  Time;
     int                     FrameCount;
     int                     FrameCountEnded;
@@ -1613,6 +1707,7 @@ struct ImGuiContext
         Font = NULL;
         FontSize = FontBaseSize = 0.0f;
         IO.Fonts = shared_font_atlas ? shared_font_atlas : IM_NEW(ImFontAtlas)();
+        FrameAllocCount = FrameFreeCount = 0;
         Time = 0.0f;
         FrameCount = 0;
         FrameCountEnded = FrameCountRendered = -1;
@@ -1907,6 +2002,10 @@ struct IMGUI_API ImGuiWindow
     int                     MemoryDrawListIdxCapacity;          // Backup of last idx/vtx count, so when waking up the window we can preallocate and avoid iterative alloc/copy
     int                     MemoryDrawListVtxCapacity;
     bool                    MemoryCompacted;                    // Set when window extraneous data have been garbage collected
+    ImS8                    MemoryCompactTimerShift;            // io.ConfigMemoryCompactTimer is scaled by (1 << MemoryCompactTimerShift) for this window, see io.ConfigMemoryCompactHysteresis
+    int                     MemoryCompactCount;                 // Number of times the window buffers were compacted
+    float                   MemoryCompactTime;                  // Time of the last compaction
+    ImGuiDrawListStats      MemoryStats;                        // Buffers usage of DrawList, for the Metrics window
 
 public:
     ImGuiWindow(ImGuiContext* context, const char* name);
@@ -2668,6 +2767,11 @@ IMGUI_API void      ImFontAtlasBuildRender32bppRectFromString(ImFontAtlas* atlas
 IMGUI_API void      ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void      ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
 
+// Glyphs rasterized on demand (ImFontAtlasFlags_DynamicGlyphs)
+IMGUI_API void      ImFontAtlasBuildDynamicNewFrame(ImFontAtlas* atlas);
+IMGUI_API const ImFontGlyph* ImFontAtlasBuildDynamicLoadGlyph(ImFontAtlas* atlas, ImFont* font, ImWchar codepoint);
+IMGUI_API void      ImFontAtlasBuildDynamicDestroy(ImFontAtlas* atlas);
+
 //-----------------------------------------------------------------------------
 // [SECTION] Test Engine specific hooks (imgui_test_engine)
 //-----------------------------------------------------------------------------
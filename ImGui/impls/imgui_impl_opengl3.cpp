@@ -6,6 +6,8 @@
 // Implemented features:
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture identifier as void*/ImTextureID. Read the FAQ about ImTextureID!
 //  [x] Renderer: Desktop GL only: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Font atlas built with ImFontAtlasFlags_SDF (distance fields), except with GLSL ES 1.00.
+//  [X] Renderer: Single channel font texture (GL 3.3+, ES 3.0), optionally BC4 compressed (Desktop GL 3.3+).
 
 // You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this. 
 // Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
@@ -14,6 +16,13 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2026-10-17: OpenGL: Upload the font atlas as GL_R8 from GetTexDataAsAlpha8() with a (1,1,1,R) texture swizzle when supported, instead of RGBA. Added ImGui_ImplOpenGL3_SetFontTextureCompression() to upload it as BC4 (GL_COMPRESSED_RED_RGTC1).
+//  2026-10-17: OpenGL: Support font atlases built with ImFontAtlasFlags_SDF (ImGuiBackendFlags_RendererHasSdfFonts): fragment shaders get a distance field variant, enabled for the font texture only.
+//  2026-10-17: OpenGL: Upload the font atlas sub-rectangles listed in ImFontAtlas::TexUpdates (glyphs rasterized on demand with ImFontAtlasFlags_DynamicGlyphs) with glTexSubImage2D() before rendering. Set ImGuiBackendFlags_RendererHasTexUpdates.
+//  2026-10-17: OpenGL: Desktop GL 4.3+ only: Added opt-in multi-draw submission with ImGui_ImplOpenGL3_SetMultiDraw(). Consecutive commands sharing a texture are drawn with one glMultiDrawElementsIndirect() call, clipping in the fragment shader.
+//  2026-10-17: OpenGL: Keep one VAO per GL context across frames instead of recreating it in every ImGui_ImplOpenGL3_RenderDrawData() call (when the current context can be identified with WGL, GLX or EGL, see IMGUI_IMPL_OPENGL_GET_CURRENT_CONTEXT). Added ImGui_ImplOpenGL3_DestroyContextObjects().
+//  2026-10-17: OpenGL: Host state backup/restore grouped and shadowed. Added ImGui_ImplOpenGL3_SetHostStateFlags(), ImGui_ImplOpenGL3_SetTrustedHost() and ImGui_ImplOpenGL3_GetFrameGLCallCount().
+//  2026-10-17: OpenGL: Desktop GL 4.4+ only: Upload all command lists once per frame into a persistently mapped, triple-buffered vertex/index ring (GL_ARB_buffer_storage) guarded by fences, instead of calling glBufferData() twice per command list.
 //  2021-05-24: OpenGL: Access GL_CLIP_ORIGIN when "GL_ARB_clip_control" extension is detected, inside of just OpenGL 4.5 version.
 //  2021-05-19: OpenGL: Replaced direct access to ImDrawCmd::TextureId with a call to ImDrawCmd::GetTexID(). (will become a requirement)
 //  2021-04-06: OpenGL: Don't try to read GL_CLIP_ORIGIN unless we're OpenGL 4.5 or greater.
@@ -146,6 +155,54 @@ using namespace gl;
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
 #endif
 
+// Desktop GL 4.4+ has glBufferStorage() and persistent/coherent buffer mapping (also exposed as GL_ARB_buffer_storage)
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && defined(GL_VERSION_4_4) && !defined(IMGUI_IMPL_OPENGL_DISABLE_BUFFER_STORAGE)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+#endif
+
+// Desktop GL 4.3+ has glMultiDrawElementsIndirect(). Our multi-draw path also sources all vertices/indices from the persistently mapped ring.
+#if defined(IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE) && defined(GL_VERSION_4_3)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_MULTI_DRAW
+#endif
+
+// Identify the current GL context, so that objects which aren't shared among contexts (VAO) can be kept alive across frames.
+// Define IMGUI_IMPL_OPENGL_GET_CURRENT_CONTEXT() to an expression returning a unique pointer for the current context if your platform isn't handled here,
+// e.g. '#define IMGUI_IMPL_OPENGL_GET_CURRENT_CONTEXT() ((void*)glXGetCurrentContext())'. Otherwise the VAO is recreated every frame. Windows (WGL) and Linux (GLX, EGL) are handled.
+#if !defined(IMGUI_IMPL_OPENGL_GET_CURRENT_CONTEXT) && defined(_WIN32) && !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>            // wglGetCurrentContext()
+#define IMGUI_IMPL_OPENGL_GET_CURRENT_CONTEXT()     ((void*)wglGetCurrentContext())
+#elif !defined(IMGUI_IMPL_OPENGL_GET_CURRENT_CONTEXT) && defined(__linux__) && !defined(__ANDROID__) && !defined(IMGUI_IMPL_OPENGL_ES2)
+// GLX or EGL, whichever the host uses: both are looked up at runtime so that neither library needs to be linked.
+#include <dlfcn.h>              // dlsym() (link with -ldl before glibc 2.34)
+static void* ImGui_ImplOpenGL3_GetCurrentContextLinux()
+{
+    typedef void* (*GetCurrentContextFunc)();
+    static GetCurrentContextFunc glx_get_current_context = (GetCurrentContextFunc)dlsym(RTLD_DEFAULT, "glXGetCurrentContext");
+    static GetCurrentContextFunc egl_get_current_context = (GetCurrentContextFunc)dlsym(RTLD_DEFAULT, "eglGetCurrentContext");
+    void* context = glx_get_current_context ? glx_get_current_context() : NULL;
+    if (context == NULL && egl_get_current_context)
+        context = egl_get_current_context();
+    return context;
+}
+#define IMGUI_IMPL_OPENGL_GET_CURRENT_CONTEXT()     ImGui_ImplOpenGL3_GetCurrentContextLinux()
+#endif
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && defined(IMGUI_IMPL_OPENGL_GET_CURRENT_CONTEXT)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_VAO_CACHE
+#endif
+
+// Desktop GL 3.3+ and GL ES 3.0 have single channel textures and texture swizzles (Desktop GL 3.0+ with GL_ARB_texture_swizzle)
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && defined(GL_TEXTURE_SWIZZLE_A) && defined(GL_R8)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+#endif
+
+// Desktop GL 3.0+ has BC4 compressed textures (GL_COMPRESSED_RED_RGTC1)
+#if defined(IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE) && !defined(IMGUI_IMPL_OPENGL_ES3) && defined(GL_COMPRESSED_RED_RGTC1)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_RGTC
+#endif
+
 // Desktop GL use extension detection
 #if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3)
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_EXTENSIONS
@@ -160,6 +217,97 @@ static GLint        g_AttribLocationTex = 0, g_AttribLocationProjMtx = 0;
 static GLuint       g_AttribLocationVtxPos = 0, g_AttribLocationVtxUV = 0, g_AttribLocationVtxColor = 0; // Vertex attributes location
 static unsigned int g_VboHandle = 0, g_ElementsHandle = 0;
 static bool         g_HasClipOrigin = false;
+static bool         g_SdfFontTexture = false;       // Shaders compiled with the distance field variant (the atlas was built with ImFontAtlasFlags_SDF)
+static GLint        g_AttribLocationFontSdf = 0;    // Uniform location
+static bool         g_SdfUniformValue = false;      // Current value of the 'FontSdf' uniform of the program in use
+static bool         g_HasTextureSwizzle = false;
+static bool         g_FontTextureCompress = false;  // Set by ImGui_ImplOpenGL3_SetFontTextureCompression()
+static GLint        g_FontTextureFormat = 0;        // Internal format of g_FontTexture: GL_RGBA, GL_R8 or GL_COMPRESSED_RED_RGTC1 (sampled as white + alpha through a swizzle)
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VAO_CACHE
+// VAO are not shared among GL contexts: keep one per context which rendered us. Released in ImGui_ImplOpenGL3_DestroyContextObjects() and ImGui_ImplOpenGL3_DestroyDeviceObjects().
+struct ImGui_ImplOpenGL3_ContextVao
+{
+    void*       Context;
+    GLuint      VertexArrayObject;
+};
+static ImVector<ImGui_ImplOpenGL3_ContextVao> g_ContextVaos;
+#endif
+
+// Backup/restore of the host GL state we modify while rendering.
+// Groups which the host declared it never touches are not queried: their last known value (shadow) is restored instead.
+struct ImGui_ImplOpenGL3_HostState
+{
+    GLenum      ActiveTexture;
+    GLuint      Program;
+    GLuint      Texture;
+    GLuint      Sampler;
+    GLuint      ArrayBuffer;
+    GLuint      DrawIndirectBuffer;
+    GLuint      VertexArrayObject;
+    GLint       PolygonMode[2];
+    GLint       Viewport[4];
+    GLint       ScissorBox[4];
+    GLenum      BlendSrcRgb, BlendDstRgb, BlendSrcAlpha, BlendDstAlpha;
+    GLenum      BlendEquationRgb, BlendEquationAlpha;
+    GLboolean   EnableBlend, EnableCullFace, EnableDepthTest, EnableStencilTest, EnableScissorTest, EnablePrimitiveRestart;
+    GLenum      ClipOrigin;
+};
+
+static ImGui_ImplOpenGL3_HostState  g_HostState = {};
+static bool                         g_HostStateValid = false;                           // Shadow is filled, only groups in g_HostStateFlags need to be queried again
+static int                          g_HostStateFlags = ImGui_ImplOpenGL3_HostState_All; // Groups the host may change between two frames
+static bool                         g_TrustedHost = false;                              // Skip backup/restore entirely
+static int                          g_GlCallCount = 0, g_LastFrameGlCallCount = 0;
+
+// Count GL calls issued while rendering a frame (see ImGui_ImplOpenGL3_GetFrameGLCallCount())
+#define GL_CALL(_CALL)  (g_GlCallCount++, _CALL)
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+// Persistently mapped vertex/index ring. Each frame writes into its own segment, a fence per segment
+// makes sure we never overwrite data the GPU may still be reading from a previous frame.
+#define IMGUI_IMPL_OPENGL_RING_FRAMES 3
+static bool         g_HasBufferStorage = false;
+static bool         g_UseRingBuffers = false;       // True while rendering a frame sourced from the ring
+static GLuint       g_RingVboHandle = 0, g_RingElementsHandle = 0;
+static ImDrawVert*  g_RingVtxMapped = NULL;
+static ImDrawIdx*   g_RingIdxMapped = NULL;
+static int          g_RingVtxCapacity = 0, g_RingIdxCapacity = 0;   // Per segment
+static int          g_RingSegment = 0;
+static GLsync       g_RingFences[IMGUI_IMPL_OPENGL_RING_FRAMES] = {};
+#endif
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MULTI_DRAW
+// Multi-draw submission: consecutive commands sharing a texture are drawn with a single glMultiDrawElementsIndirect() call.
+// Clipping is done in the fragment shader from a per-command clip rectangle, read as an instanced attribute
+// through the baseInstance of each indirect command, so that different clip rectangles don't break batches.
+struct ImGui_ImplOpenGL3_DrawElementsIndirectCommand
+{
+    GLuint      Count;
+    GLuint      InstanceCount;
+    GLuint      FirstIndex;
+    GLint       BaseVertex;
+    GLuint      BaseInstance;
+};
+struct ImGui_ImplOpenGL3_MultiDrawBatch
+{
+    ImTextureID         TexId;
+    int                 FirstCommand;
+    int                 CommandCount;
+    const ImDrawList*   CallbackList;       // User callbacks are kept in their own batch, in submission order
+    const ImDrawCmd*    CallbackCmd;
+};
+static bool         g_HasMultiDraw = false;
+static bool         g_MultiDrawEnabled = false;     // Set by ImGui_ImplOpenGL3_SetMultiDraw()
+static bool         g_UseMultiDraw = false;         // True while rendering a frame with the multi-draw path
+static GLuint       g_MultiDrawShaderHandle = 0, g_MultiDrawVertHandle = 0, g_MultiDrawFragHandle = 0;
+static GLint        g_MultiDrawAttribLocationTex = 0, g_MultiDrawAttribLocationProjMtx = 0, g_MultiDrawAttribLocationFontSdf = 0;
+static GLuint       g_MultiDrawAttribLocationClipRect = 0;
+static GLuint       g_MultiDrawIndirectHandle = 0, g_MultiDrawClipRectsHandle = 0;
+static ImVector<ImGui_ImplOpenGL3_DrawElementsIndirectCommand>  g_MultiDrawCommands;
+static ImVector<ImVec4>                                         g_MultiDrawClipRects;   // In framebuffer coordinates: x0, y0, x1, y1 (same as glScissor)
+static ImVector<ImGui_ImplOpenGL3_MultiDrawBatch>               g_MultiDrawBatches;
+#endif
 
 // Functions
 bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
@@ -188,6 +336,7 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     if (g_GlVersion >= 320)
         io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
 #endif
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTexUpdates;     // We upload the glyphs rasterized on demand (ImFontAtlasFlags_DynamicGlyphs), see ImGui_ImplOpenGL3_UpdateFontsTexture().
 
     // Store GLSL version string so we can refer to it later in case we recreate shaders.
     // Note: GLSL version is NOT the same as GL version. Leave this to NULL if unsure.
@@ -207,6 +356,12 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     IM_ASSERT((int)strlen(glsl_version) + 2 < IM_ARRAYSIZE(g_GlslVersionString));
     strcpy(g_GlslVersionString, glsl_version);
     strcat(g_GlslVersionString, "\n");
+    int glsl_version_num = 130;
+    sscanf(g_GlslVersionString, "#version %d", &glsl_version_num);
+
+    // Distance field fonts need fwidth(), which GLSL ES 1.00 only has as an extension
+    if (glsl_version_num != 100)
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasSdfFonts;
 
     // Debugging construct to make it easily visible in the IDE and debugger which GL loader has been selected.
     // The code actually never uses the 'gl_loader' variable! It is only here so you can read it!
@@ -249,8 +404,33 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
         const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
         if (extension != NULL && strcmp(extension, "GL_ARB_clip_control") == 0)
             g_HasClipOrigin = true;
+        if (extension != NULL && strcmp(extension, "GL_ARB_texture_swizzle") == 0)
+            g_HasTextureSwizzle = true;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+        if (extension != NULL && strcmp(extension, "GL_ARB_buffer_storage") == 0)
+            g_HasBufferStorage = true;
+#endif
     }
 #endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    // The ring relies on glDrawElementsBaseVertex() to address each list inside the shared buffers.
+    if (g_GlVersion >= 440)
+        g_HasBufferStorage = true;
+    if (g_GlVersion < 320 || glBufferStorage == NULL || glMapBufferRange == NULL || glFenceSync == NULL)
+        g_HasBufferStorage = false;
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+    // GL_R8 textures need Desktop GL 3.0 or GL ES 3.0, swizzles are core in Desktop GL 3.3 and GL ES 3.0
+#if defined(IMGUI_IMPL_OPENGL_ES3)
+    g_HasTextureSwizzle = (g_GlVersion >= 300);
+#else
+    g_HasTextureSwizzle = (g_GlVersion >= 330) || (g_GlVersion >= 300 && g_HasTextureSwizzle);
+#endif
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MULTI_DRAW
+    // The clipping shader needs 'flat' varyings (GLSL 130+, not ES)
+    g_HasMultiDraw = g_HasBufferStorage && g_GlVersion >= 430 && glsl_version_num >= 130 && glsl_version_num != 300 && glMultiDrawElementsIndirect != NULL && glVertexAttribDivisor != NULL;
+#endif
 
     return true;
 }
@@ -258,6 +438,7 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
 void    ImGui_ImplOpenGL3_Shutdown()
 {
     ImGui_ImplOpenGL3_DestroyDeviceObjects();
+    g_HostStateValid = false;
 }
 
 bool    ImGui_ImplOpenGL3_NewFrame()
@@ -267,38 +448,152 @@ bool    ImGui_ImplOpenGL3_NewFrame()
     return true;
 }
 
+void    ImGui_ImplOpenGL3_SetHostStateFlags(int flags)
+{
+    g_HostStateFlags = flags;
+    g_HostStateValid = false;
+}
+
+void    ImGui_ImplOpenGL3_SetTrustedHost(bool trusted_host)
+{
+    g_TrustedHost = trusted_host;
+    g_HostStateValid = false;
+}
+
+int     ImGui_ImplOpenGL3_GetFrameGLCallCount()
+{
+    return g_LastFrameGlCallCount;
+}
+
+static void ImGui_ImplOpenGL3_BackupHostState(ImGui_ImplOpenGL3_HostState* s)
+{
+    // Clip origin is only read to setup our projection (never modified), so it is also queried when the host is trusted.
+    const int flags = g_TrustedHost ? ImGui_ImplOpenGL3_HostState_None : g_HostStateValid ? g_HostStateFlags : ImGui_ImplOpenGL3_HostState_All;
+#if defined(GL_CLIP_ORIGIN)
+    if (g_HasClipOrigin && (g_TrustedHost || (flags & ImGui_ImplOpenGL3_HostState_Raster)))
+        GL_CALL(glGetIntegerv(GL_CLIP_ORIGIN, (GLint*)&s->ClipOrigin));
+#endif
+
+    if (flags & ImGui_ImplOpenGL3_HostState_Textures)
+        GL_CALL(glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&s->ActiveTexture));
+    GL_CALL(glActiveTexture(GL_TEXTURE0));
+    if (flags & ImGui_ImplOpenGL3_HostState_Textures)
+    {
+        GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&s->Texture));
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+        if (g_GlVersion >= 330) { GL_CALL(glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&s->Sampler)); } else { s->Sampler = 0; }
+#endif
+    }
+    if (flags & ImGui_ImplOpenGL3_HostState_Program)
+        GL_CALL(glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&s->Program));
+    if (flags & ImGui_ImplOpenGL3_HostState_Buffers)
+    {
+        GL_CALL(glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&s->ArrayBuffer));
+#ifndef IMGUI_IMPL_OPENGL_ES2
+        GL_CALL(glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&s->VertexArrayObject));
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MULTI_DRAW
+        if (g_MultiDrawEnabled)
+            GL_CALL(glGetIntegerv(GL_DRAW_INDIRECT_BUFFER_BINDING, (GLint*)&s->DrawIndirectBuffer));
+#endif
+    }
+    if (flags & ImGui_ImplOpenGL3_HostState_Raster)
+    {
+#ifdef GL_POLYGON_MODE
+        GL_CALL(glGetIntegerv(GL_POLYGON_MODE, s->PolygonMode));
+#endif
+        GL_CALL(glGetIntegerv(GL_VIEWPORT, s->Viewport));
+        GL_CALL(glGetIntegerv(GL_SCISSOR_BOX, s->ScissorBox));
+    }
+    if (flags & ImGui_ImplOpenGL3_HostState_Blend)
+    {
+        GL_CALL(glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&s->BlendSrcRgb));
+        GL_CALL(glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&s->BlendDstRgb));
+        GL_CALL(glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&s->BlendSrcAlpha));
+        GL_CALL(glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&s->BlendDstAlpha));
+        GL_CALL(glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&s->BlendEquationRgb));
+        GL_CALL(glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&s->BlendEquationAlpha));
+    }
+    if (flags & ImGui_ImplOpenGL3_HostState_Enables)
+    {
+        s->EnableBlend = GL_CALL(glIsEnabled(GL_BLEND));
+        s->EnableCullFace = GL_CALL(glIsEnabled(GL_CULL_FACE));
+        s->EnableDepthTest = GL_CALL(glIsEnabled(GL_DEPTH_TEST));
+        s->EnableStencilTest = GL_CALL(glIsEnabled(GL_STENCIL_TEST));
+        s->EnableScissorTest = GL_CALL(glIsEnabled(GL_SCISSOR_TEST));
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+        s->EnablePrimitiveRestart = (g_GlVersion >= 310) ? GL_CALL(glIsEnabled(GL_PRIMITIVE_RESTART)) : GL_FALSE;
+#endif
+    }
+    g_HostStateValid = !g_TrustedHost;
+}
+
+static void ImGui_ImplOpenGL3_RestoreHostState(const ImGui_ImplOpenGL3_HostState* s)
+{
+    if (g_TrustedHost)
+        return;
+    GL_CALL(glUseProgram(s->Program));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, s->Texture));
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+    if (g_GlVersion >= 330)
+        GL_CALL(glBindSampler(0, s->Sampler));
+#endif
+    GL_CALL(glActiveTexture(s->ActiveTexture));
+#ifndef IMGUI_IMPL_OPENGL_ES2
+    GL_CALL(glBindVertexArray(s->VertexArrayObject));
+#endif
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, s->ArrayBuffer));
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MULTI_DRAW
+    if (g_MultiDrawEnabled)
+        GL_CALL(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, s->DrawIndirectBuffer));
+#endif
+    GL_CALL(glBlendEquationSeparate(s->BlendEquationRgb, s->BlendEquationAlpha));
+    GL_CALL(glBlendFuncSeparate(s->BlendSrcRgb, s->BlendDstRgb, s->BlendSrcAlpha, s->BlendDstAlpha));
+    if (s->EnableBlend) GL_CALL(glEnable(GL_BLEND)); else GL_CALL(glDisable(GL_BLEND));
+    if (s->EnableCullFace) GL_CALL(glEnable(GL_CULL_FACE)); else GL_CALL(glDisable(GL_CULL_FACE));
+    if (s->EnableDepthTest) GL_CALL(glEnable(GL_DEPTH_TEST)); else GL_CALL(glDisable(GL_DEPTH_TEST));
+    if (s->EnableStencilTest) GL_CALL(glEnable(GL_STENCIL_TEST)); else GL_CALL(glDisable(GL_STENCIL_TEST));
+    if (s->EnableScissorTest) GL_CALL(glEnable(GL_SCISSOR_TEST)); else GL_CALL(glDisable(GL_SCISSOR_TEST));
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+    if (g_GlVersion >= 310) { if (s->EnablePrimitiveRestart) GL_CALL(glEnable(GL_PRIMITIVE_RESTART)); else GL_CALL(glDisable(GL_PRIMITIVE_RESTART)); }
+#endif
+
+#ifdef GL_POLYGON_MODE
+    GL_CALL(glPolygonMode(GL_FRONT_AND_BACK, (GLenum)s->PolygonMode[0]));
+#endif
+    GL_CALL(glViewport(s->Viewport[0], s->Viewport[1], (GLsizei)s->Viewport[2], (GLsizei)s->Viewport[3]));
+    GL_CALL(glScissor(s->ScissorBox[0], s->ScissorBox[1], (GLsizei)s->ScissorBox[2], (GLsizei)s->ScissorBox[3]));
+}
+
 static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
 {
     // Setup render state: alpha-blending enabled, no face culling, no depth testing, scissor enabled, polygon fill
-    glEnable(GL_BLEND);
-    glBlendEquation(GL_FUNC_ADD);
-    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_CULL_FACE);
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_STENCIL_TEST);
-    glEnable(GL_SCISSOR_TEST);
+    GL_CALL(glEnable(GL_BLEND));
+    GL_CALL(glBlendEquation(GL_FUNC_ADD));
+    GL_CALL(glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA));
+    GL_CALL(glDisable(GL_CULL_FACE));
+    GL_CALL(glDisable(GL_DEPTH_TEST));
+    GL_CALL(glDisable(GL_STENCIL_TEST));
+    GL_CALL(glEnable(GL_SCISSOR_TEST));
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
     if (g_GlVersion >= 310)
-        glDisable(GL_PRIMITIVE_RESTART);
+        GL_CALL(glDisable(GL_PRIMITIVE_RESTART));
 #endif
 #ifdef GL_POLYGON_MODE
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    GL_CALL(glPolygonMode(GL_FRONT_AND_BACK, GL_FILL));
 #endif
 
     // Support for GL 4.5 rarely used glClipControl(GL_UPPER_LEFT)
+    // (clip origin was read along with the host state backup)
 #if defined(GL_CLIP_ORIGIN)
     bool clip_origin_lower_left = true;
-    if (g_HasClipOrigin)
-    {
-        GLenum current_clip_origin = 0; glGetIntegerv(GL_CLIP_ORIGIN, (GLint*)&current_clip_origin);
-        if (current_clip_origin == GL_UPPER_LEFT)
-            clip_origin_lower_left = false;
-    }
+    if (g_HasClipOrigin && g_HostState.ClipOrigin == GL_UPPER_LEFT)
+        clip_origin_lower_left = false;
 #endif
 
     // Setup viewport, orthographic projection matrix
     // Our visible imgui space lies from draw_data->DisplayPos (top left) to draw_data->DisplayPos+data_data->DisplaySize (bottom right). DisplayPos is (0,0) for single viewport apps.
-    glViewport(0, 0, (GLsizei)fb_width, (GLsizei)fb_height);
+    GL_CALL(glViewport(0, 0, (GLsizei)fb_width, (GLsizei)fb_height));
     float L = draw_data->DisplayPos.x;
     float R = draw_data->DisplayPos.x + draw_data->DisplaySize.x;
     float T = draw_data->DisplayPos.y;
@@ -313,34 +608,465 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
         { 0.0f,         0.0f,        -1.0f,   0.0f },
         { (R+L)/(L-R),  (T+B)/(B-T),  0.0f,   1.0f },
     };
-    glUseProgram(g_ShaderHandle);
-    glUniform1i(g_AttribLocationTex, 0);
-    glUniformMatrix4fv(g_AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
+    GLuint shader_handle = g_ShaderHandle;
+    GLint attrib_location_tex = g_AttribLocationTex, attrib_location_proj_mtx = g_AttribLocationProjMtx, attrib_location_font_sdf = g_AttribLocationFontSdf;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MULTI_DRAW
+    if (g_UseMultiDraw)
+    {
+        shader_handle = g_MultiDrawShaderHandle;
+        attrib_location_tex = g_MultiDrawAttribLocationTex;
+        attrib_location_proj_mtx = g_MultiDrawAttribLocationProjMtx;
+        attrib_location_font_sdf = g_MultiDrawAttribLocationFontSdf;
+    }
+#endif
+    GL_CALL(glUseProgram(shader_handle));
+    GL_CALL(glUniform1i(attrib_location_tex, 0));
+    GL_CALL(glUniformMatrix4fv(attrib_location_proj_mtx, 1, GL_FALSE, &ortho_projection[0][0]));
+    if (g_SdfFontTexture)
+    {
+        GL_CALL(glUniform1i(attrib_location_font_sdf, 0));
+        g_SdfUniformValue = false;
+    }
 
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
     if (g_GlVersion >= 330)
-        glBindSampler(0, 0); // We use combined texture/sampler state. Applications using GL 3.3 may set that otherwise.
+        GL_CALL(glBindSampler(0, 0)); // We use combined texture/sampler state. Applications using GL 3.3 may set that otherwise.
 #endif
 
     (void)vertex_array_object;
 #ifndef IMGUI_IMPL_OPENGL_ES2
-    glBindVertexArray(vertex_array_object);
+    GL_CALL(glBindVertexArray(vertex_array_object));
 #endif
 
     // Bind vertex/index buffers and setup attributes for ImDrawVert
-    glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ElementsHandle);
-    glEnableVertexAttribArray(g_AttribLocationVtxPos);
-    glEnableVertexAttribArray(g_AttribLocationVtxUV);
-    glEnableVertexAttribArray(g_AttribLocationVtxColor);
-    glVertexAttribPointer(g_AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, pos));
-    glVertexAttribPointer(g_AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, uv));
-    glVertexAttribPointer(g_AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (g_UseRingBuffers)
+    {
+        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, g_RingVboHandle));
+        GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_RingElementsHandle));
+    }
+    else
+#endif
+    {
+        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle));
+        GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ElementsHandle));
+    }
+    GL_CALL(glEnableVertexAttribArray(g_AttribLocationVtxPos));
+    GL_CALL(glEnableVertexAttribArray(g_AttribLocationVtxUV));
+    GL_CALL(glEnableVertexAttribArray(g_AttribLocationVtxColor));
+    GL_CALL(glVertexAttribPointer(g_AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, pos)));
+    GL_CALL(glVertexAttribPointer(g_AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, uv)));
+    GL_CALL(glVertexAttribPointer(g_AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col)));
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MULTI_DRAW
+    if (g_UseMultiDraw)
+    {
+        // Per-command clip rectangle, one 'instance' per command. Scissor covers the whole framebuffer, clipping happens in the fragment shader.
+        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, g_MultiDrawClipRectsHandle));
+        GL_CALL(glEnableVertexAttribArray(g_MultiDrawAttribLocationClipRect));
+        GL_CALL(glVertexAttribPointer(g_MultiDrawAttribLocationClipRect, 4, GL_FLOAT, GL_FALSE, sizeof(ImVec4), (GLvoid*)0));
+        GL_CALL(glVertexAttribDivisor(g_MultiDrawAttribLocationClipRect, 1));
+        GL_CALL(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, g_MultiDrawIndirectHandle));
+        GL_CALL(glScissor(0, 0, (GLsizei)fb_width, (GLsizei)fb_height));
+    }
+    else if (g_MultiDrawShaderHandle != 0)
+    {
+        GL_CALL(glDisableVertexAttribArray(g_MultiDrawAttribLocationClipRect));  // May have been enabled in our VAO by a previous frame
+    }
+#endif
+}
+
+// Bind the texture of the next draw calls. With a distance field font atlas, also tell the fragment shader whether it is the font texture.
+static void ImGui_ImplOpenGL3_BindTexture(GLuint texture)
+{
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, texture));
+    const bool font_sdf = g_SdfFontTexture && texture == g_FontTexture;
+    if (font_sdf == g_SdfUniformValue)
+        return;
+    GLint attrib_location_font_sdf = g_AttribLocationFontSdf;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MULTI_DRAW
+    if (g_UseMultiDraw)
+        attrib_location_font_sdf = g_MultiDrawAttribLocationFontSdf;
+#endif
+    GL_CALL(glUniform1i(attrib_location_font_sdf, font_sdf ? 1 : 0));
+    g_SdfUniformValue = font_sdf;
+}
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VAO_CACHE
+// Returns 0 if the current context can't be identified: the caller then uses a temporary VAO.
+static GLuint ImGui_ImplOpenGL3_GetContextVertexArray()
+{
+    void* context = IMGUI_IMPL_OPENGL_GET_CURRENT_CONTEXT();
+    if (context == NULL)
+        return 0;
+    for (int n = 0; n < g_ContextVaos.Size; n++)
+        if (g_ContextVaos[n].Context == context)
+            return g_ContextVaos[n].VertexArrayObject;
+
+    ImGui_ImplOpenGL3_ContextVao entry;
+    entry.Context = context;
+    entry.VertexArrayObject = 0;
+    GL_CALL(glGenVertexArrays(1, &entry.VertexArrayObject));
+    g_ContextVaos.push_back(entry);
+    return entry.VertexArrayObject;
+}
+
+static void ImGui_ImplOpenGL3_DestroyContextVertexArrays()
+{
+    // A VAO can only be deleted from its own context, the ones of other contexts are forgotten and released along with their context.
+    // (if a context is destroyed while we are still alive, call ImGui_ImplOpenGL3_DestroyDeviceObjects() so its handle can't be mistaken for a new context)
+    void* context = IMGUI_IMPL_OPENGL_GET_CURRENT_CONTEXT();
+    for (int n = 0; n < g_ContextVaos.Size; n++)
+        if (g_ContextVaos[n].Context == context)
+            glDeleteVertexArrays(1, &g_ContextVaos[n].VertexArrayObject);
+    g_ContextVaos.clear();
+}
+#endif
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+static void ImGui_ImplOpenGL3_DestroyRingBuffers()
+{
+    for (int i = 0; i < IMGUI_IMPL_OPENGL_RING_FRAMES; i++)
+        if (g_RingFences[i]) { glDeleteSync(g_RingFences[i]); g_RingFences[i] = NULL; }
+    if (g_RingVboHandle)        { glDeleteBuffers(1, &g_RingVboHandle); g_RingVboHandle = 0; }        // Deleting a buffer also unmaps it
+    if (g_RingElementsHandle)   { glDeleteBuffers(1, &g_RingElementsHandle); g_RingElementsHandle = 0; }
+    g_RingVtxMapped = NULL;
+    g_RingIdxMapped = NULL;
+    g_RingVtxCapacity = g_RingIdxCapacity = 0;
+    g_RingSegment = 0;
+}
+
+static void* ImGui_ImplOpenGL3_CreatePersistentBuffer(GLuint* handle, GLsizeiptr size)
+{
+    // Both buffers are created through GL_ARRAY_BUFFER: the GL_ELEMENT_ARRAY_BUFFER binding is part of the VAO state,
+    // and the VAO currently bound still belongs to the application. Buffer objects are typeless so this is fine.
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GL_CALL(glGenBuffers(1, handle));
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, *handle));
+    GL_CALL(glBufferStorage(GL_ARRAY_BUFFER, size, NULL, flags));
+    return GL_CALL(glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+}
+
+// Copy every command list of the frame into the next ring segment.
+// Outputs the vertex/index offsets of that segment. Returns false if the ring couldn't be used (caller falls back to glBufferData).
+static bool ImGui_ImplOpenGL3_UploadRingBuffers(ImDrawData* draw_data, int* out_vtx_offset, int* out_idx_offset)
+{
+    // Grow (and recreate) the ring when the frame doesn't fit in a segment.
+    // Old storage stays alive on the driver side until the GPU is done with it, so no need to wait here.
+    if (g_RingVboHandle == 0 || draw_data->TotalVtxCount > g_RingVtxCapacity || draw_data->TotalIdxCount > g_RingIdxCapacity)
+    {
+        // (the first frame may have no vertices at all, e.g. windows are hidden on their first frame: the headroom also keeps the buffers from being empty)
+        const int vtx_capacity = (g_RingVtxCapacity == 0 || draw_data->TotalVtxCount > g_RingVtxCapacity) ? draw_data->TotalVtxCount + 5000 : g_RingVtxCapacity;
+        const int idx_capacity = (g_RingIdxCapacity == 0 || draw_data->TotalIdxCount > g_RingIdxCapacity) ? draw_data->TotalIdxCount + 10000 : g_RingIdxCapacity;
+        ImGui_ImplOpenGL3_DestroyRingBuffers();
+        g_RingVtxMapped = (ImDrawVert*)ImGui_ImplOpenGL3_CreatePersistentBuffer(&g_RingVboHandle, (GLsizeiptr)vtx_capacity * IMGUI_IMPL_OPENGL_RING_FRAMES * (int)sizeof(ImDrawVert));
+        g_RingIdxMapped = (ImDrawIdx*)ImGui_ImplOpenGL3_CreatePersistentBuffer(&g_RingElementsHandle, (GLsizeiptr)idx_capacity * IMGUI_IMPL_OPENGL_RING_FRAMES * (int)sizeof(ImDrawIdx));
+        if (g_RingVtxMapped == NULL || g_RingIdxMapped == NULL)
+        {
+            // Driver advertised the feature but refused the mapping: never try again.
+            ImGui_ImplOpenGL3_DestroyRingBuffers();
+            g_HasBufferStorage = false;
+            return false;
+        }
+        g_RingVtxCapacity = vtx_capacity;
+        g_RingIdxCapacity = idx_capacity;
+    }
+
+    // Wait until the GPU is done reading the segment we are about to overwrite (normally signaled long ago)
+    GLsync fence = g_RingFences[g_RingSegment];
+    if (fence != NULL)
+    {
+        GLbitfield wait_flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+        while (GL_CALL(glClientWaitSync(fence, wait_flags, 1000000000)) == GL_TIMEOUT_EXPIRED)
+            wait_flags = 0;
+        GL_CALL(glDeleteSync(fence));
+        g_RingFences[g_RingSegment] = NULL;
+    }
+
+    // Coherent mapping: plain memory writes are visible to the GPU without explicit flushing
+    const int vtx_offset = g_RingSegment * g_RingVtxCapacity;
+    const int idx_offset = g_RingSegment * g_RingIdxCapacity;
+    ImDrawVert* vtx_dst = g_RingVtxMapped + vtx_offset;
+    ImDrawIdx* idx_dst = g_RingIdxMapped + idx_offset;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        memcpy(vtx_dst, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+        memcpy(idx_dst, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+        vtx_dst += cmd_list->VtxBuffer.Size;
+        idx_dst += cmd_list->IdxBuffer.Size;
+    }
+    *out_vtx_offset = vtx_offset;
+    *out_idx_offset = idx_offset;
+    return true;
+}
+#endif
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MULTI_DRAW
+bool    ImGui_ImplOpenGL3_SetMultiDraw(bool enable)
+{
+    g_MultiDrawEnabled = enable && g_HasMultiDraw;
+    g_HostStateValid = false;   // Adds GL_DRAW_INDIRECT_BUFFER_BINDING to the backed up state
+    return g_MultiDrawEnabled == enable;
+}
+
+static bool CheckShader(GLuint handle, const char* desc);
+static bool CheckProgram(GLuint handle, const char* desc);
+static const GLchar* ImGui_ImplOpenGL3_GetFragmentShaderDefines();
+
+static void ImGui_ImplOpenGL3_DestroyMultiDrawObjects()
+{
+    if (g_MultiDrawIndirectHandle)      { glDeleteBuffers(1, &g_MultiDrawIndirectHandle); g_MultiDrawIndirectHandle = 0; }
+    if (g_MultiDrawClipRectsHandle)     { glDeleteBuffers(1, &g_MultiDrawClipRectsHandle); g_MultiDrawClipRectsHandle = 0; }
+    if (g_MultiDrawShaderHandle && g_MultiDrawVertHandle) { glDetachShader(g_MultiDrawShaderHandle, g_MultiDrawVertHandle); }
+    if (g_MultiDrawShaderHandle && g_MultiDrawFragHandle) { glDetachShader(g_MultiDrawShaderHandle, g_MultiDrawFragHandle); }
+    if (g_MultiDrawVertHandle)          { glDeleteShader(g_MultiDrawVertHandle); g_MultiDrawVertHandle = 0; }
+    if (g_MultiDrawFragHandle)          { glDeleteShader(g_MultiDrawFragHandle); g_MultiDrawFragHandle = 0; }
+    if (g_MultiDrawShaderHandle)        { glDeleteProgram(g_MultiDrawShaderHandle); g_MultiDrawShaderHandle = 0; }
+    g_MultiDrawCommands.clear();
+    g_MultiDrawClipRects.clear();
+    g_MultiDrawBatches.clear();
+}
+
+// Created on first use, after the main shader program which gives us the vertex attributes locations.
+static bool ImGui_ImplOpenGL3_CreateMultiDrawObjects()
+{
+    const GLchar* vertex_shader =
+        "uniform mat4 ProjMtx;\n"
+        "in vec2 Position;\n"
+        "in vec2 UV;\n"
+        "in vec4 Color;\n"
+        "in vec4 ClipRect;\n"
+        "out vec2 Frag_UV;\n"
+        "out vec4 Frag_Color;\n"
+        "flat out vec4 Frag_ClipRect;\n"
+        "void main()\n"
+        "{\n"
+        "    Frag_UV = UV;\n"
+        "    Frag_Color = Color;\n"
+        "    Frag_ClipRect = ClipRect;\n"
+        "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
+        "}\n";
+
+    // Same test as the scissor: gl_FragCoord is the pixel center, clip rectangles are in whole pixels.
+    const GLchar* fragment_shader =
+        "uniform sampler2D Texture;\n"
+        "in vec2 Frag_UV;\n"
+        "in vec4 Frag_Color;\n"
+        "flat in vec4 Frag_ClipRect;\n"
+        "out vec4 Out_Color;\n"
+        "#ifdef IMGUI_IMPL_OPENGL_SDF_FONT\n"
+        "uniform bool FontSdf;\n"
+        "#endif\n"
+        "void main()\n"
+        "{\n"
+        "    if (gl_FragCoord.x < Frag_ClipRect.x || gl_FragCoord.y < Frag_ClipRect.y || gl_FragCoord.x >= Frag_ClipRect.z || gl_FragCoord.y >= Frag_ClipRect.w)\n"
+        "        discard;\n"
+        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "#ifdef IMGUI_IMPL_OPENGL_SDF_FONT\n"
+        "    if (FontSdf)\n"
+        "    {\n"
+        "        float d = texture(Texture, Frag_UV.st).a;\n"
+        "        float w = max(0.5 * fwidth(d), 1.0 / 255.0);\n"
+        "        Out_Color.a = Frag_Color.a * smoothstep(0.5 - w, 0.5 + w, d);\n"
+        "    }\n"
+        "#endif\n"
+        "}\n";
+
+    const GLchar* vertex_shader_with_version[2] = { g_GlslVersionString, vertex_shader };
+    g_MultiDrawVertHandle = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(g_MultiDrawVertHandle, 2, vertex_shader_with_version, NULL);
+    glCompileShader(g_MultiDrawVertHandle);
+    bool ok = CheckShader(g_MultiDrawVertHandle, "multi-draw vertex shader");
+
+    const GLchar* fragment_shader_with_version[3] = { g_GlslVersionString, ImGui_ImplOpenGL3_GetFragmentShaderDefines(), fragment_shader };
+    g_MultiDrawFragHandle = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(g_MultiDrawFragHandle, 3, fragment_shader_with_version, NULL);
+    glCompileShader(g_MultiDrawFragHandle);
+    ok &= CheckShader(g_MultiDrawFragHandle, "multi-draw fragment shader");
+
+    // Share the vertex layout of the main program so the same VAO setup works for both
+    g_MultiDrawAttribLocationClipRect = g_AttribLocationVtxPos;
+    if (g_AttribLocationVtxUV > g_MultiDrawAttribLocationClipRect)      g_MultiDrawAttribLocationClipRect = g_AttribLocationVtxUV;
+    if (g_AttribLocationVtxColor > g_MultiDrawAttribLocationClipRect)   g_MultiDrawAttribLocationClipRect = g_AttribLocationVtxColor;
+    g_MultiDrawAttribLocationClipRect++;
+    g_MultiDrawShaderHandle = glCreateProgram();
+    glAttachShader(g_MultiDrawShaderHandle, g_MultiDrawVertHandle);
+    glAttachShader(g_MultiDrawShaderHandle, g_MultiDrawFragHandle);
+    glBindAttribLocation(g_MultiDrawShaderHandle, g_AttribLocationVtxPos, "Position");
+    glBindAttribLocation(g_MultiDrawShaderHandle, g_AttribLocationVtxUV, "UV");
+    glBindAttribLocation(g_MultiDrawShaderHandle, g_AttribLocationVtxColor, "Color");
+    glBindAttribLocation(g_MultiDrawShaderHandle, g_MultiDrawAttribLocationClipRect, "ClipRect");
+    glLinkProgram(g_MultiDrawShaderHandle);
+    ok &= CheckProgram(g_MultiDrawShaderHandle, "multi-draw shader program");
+    if (!ok)
+    {
+        ImGui_ImplOpenGL3_DestroyMultiDrawObjects();
+        return false;
+    }
+
+    g_MultiDrawAttribLocationTex = glGetUniformLocation(g_MultiDrawShaderHandle, "Texture");
+    g_MultiDrawAttribLocationProjMtx = glGetUniformLocation(g_MultiDrawShaderHandle, "ProjMtx");
+    g_MultiDrawAttribLocationFontSdf = glGetUniformLocation(g_MultiDrawShaderHandle, "FontSdf");
+    glGenBuffers(1, &g_MultiDrawIndirectHandle);
+    glGenBuffers(1, &g_MultiDrawClipRectsHandle);
+    return true;
+}
+
+// Build indirect commands for the whole frame (which sits in the ring at global_vtx_offset/global_idx_offset) and upload them.
+// Batches are runs of consecutive commands sharing a texture, so submission order (and therefore blending) is unchanged.
+static void ImGui_ImplOpenGL3_SetupMultiDrawBatches(ImDrawData* draw_data, int fb_width, int fb_height, int global_vtx_offset, int global_idx_offset)
+{
+    g_MultiDrawCommands.resize(0);
+    g_MultiDrawClipRects.resize(0);
+    g_MultiDrawBatches.resize(0);
+
+    ImVec2 clip_off = draw_data->DisplayPos;
+    ImVec2 clip_scale = draw_data->FramebufferScale;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != NULL)
+            {
+                ImGui_ImplOpenGL3_MultiDrawBatch batch = { 0, g_MultiDrawCommands.Size, 0, cmd_list, pcmd };
+                g_MultiDrawBatches.push_back(batch);
+                continue;
+            }
+
+            // Project scissor/clipping rectangles into framebuffer space
+            ImVec4 clip_rect;
+            clip_rect.x = (pcmd->ClipRect.x - clip_off.x) * clip_scale.x;
+            clip_rect.y = (pcmd->ClipRect.y - clip_off.y) * clip_scale.y;
+            clip_rect.z = (pcmd->ClipRect.z - clip_off.x) * clip_scale.x;
+            clip_rect.w = (pcmd->ClipRect.w - clip_off.y) * clip_scale.y;
+            if (!(clip_rect.x < fb_width && clip_rect.y < fb_height && clip_rect.z >= 0.0f && clip_rect.w >= 0.0f))
+                continue;
+
+            // Same rounding as the glScissor() call of the regular path
+            const int x = (int)clip_rect.x;
+            const int y = (int)(fb_height - clip_rect.w);
+            g_MultiDrawClipRects.push_back(ImVec4((float)x, (float)y, (float)(x + (int)(clip_rect.z - clip_rect.x)), (float)(y + (int)(clip_rect.w - clip_rect.y))));
+
+            ImGui_ImplOpenGL3_DrawElementsIndirectCommand command;
+            command.Count = pcmd->ElemCount;
+            command.InstanceCount = 1;
+            command.FirstIndex = pcmd->IdxOffset + global_idx_offset;
+            command.BaseVertex = (GLint)(pcmd->VtxOffset + global_vtx_offset);
+            command.BaseInstance = (GLuint)(g_MultiDrawClipRects.Size - 1);
+            g_MultiDrawCommands.push_back(command);
+
+            ImTextureID tex_id = pcmd->GetTexID();
+            if (g_MultiDrawBatches.Size > 0 && g_MultiDrawBatches.back().CallbackCmd == NULL && g_MultiDrawBatches.back().TexId == tex_id)
+            {
+                g_MultiDrawBatches.back().CommandCount++;
+            }
+            else
+            {
+                ImGui_ImplOpenGL3_MultiDrawBatch batch = { tex_id, g_MultiDrawCommands.Size - 1, 1, NULL, NULL };
+                g_MultiDrawBatches.push_back(batch);
+            }
+        }
+        global_vtx_offset += cmd_list->VtxBuffer.Size;
+        global_idx_offset += cmd_list->IdxBuffer.Size;
+    }
+
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, g_MultiDrawClipRectsHandle));
+    GL_CALL(glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)g_MultiDrawClipRects.size_in_bytes(), (const GLvoid*)g_MultiDrawClipRects.Data, GL_STREAM_DRAW));
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, g_MultiDrawIndirectHandle));
+    GL_CALL(glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)g_MultiDrawCommands.size_in_bytes(), (const GLvoid*)g_MultiDrawCommands.Data, GL_STREAM_DRAW));
+}
+
+static void ImGui_ImplOpenGL3_RenderMultiDrawBatches(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
+{
+    for (int batch_i = 0; batch_i < g_MultiDrawBatches.Size; batch_i++)
+    {
+        const ImGui_ImplOpenGL3_MultiDrawBatch* batch = &g_MultiDrawBatches[batch_i];
+        if (batch->CallbackCmd != NULL)
+        {
+            if (batch->CallbackCmd->UserCallback == ImDrawCallback_ResetRenderState)
+                ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+            else
+                batch->CallbackCmd->UserCallback(batch->CallbackList, batch->CallbackCmd);
+            continue;
+        }
+        ImGui_ImplOpenGL3_BindTexture((GLuint)(intptr_t)batch->TexId);
+        GL_CALL(glMultiDrawElementsIndirect(GL_TRIANGLES, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (const void*)(intptr_t)(batch->FirstCommand * sizeof(ImGui_ImplOpenGL3_DrawElementsIndirectCommand)), (GLsizei)batch->CommandCount, 0));
+    }
+}
+#else
+bool    ImGui_ImplOpenGL3_SetMultiDraw(bool enable)
+{
+    return !enable;
+}
+#endif
+
+bool    ImGui_ImplOpenGL3_SetFontTextureCompression(bool compress)
+{
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_RGTC
+    g_FontTextureCompress = compress && g_HasTextureSwizzle;
+#else
+    g_FontTextureCompress = false;
+#endif
+    return g_FontTextureCompress == compress;
+}
+
+// Upload the parts of the font atlas modified since the last frame (glyphs rasterized on demand, see ImFontAtlasFlags_DynamicGlyphs).
+// Called after the host state backup: the texture binding of unit 0 is restored along with the rest.
+static void ImGui_ImplOpenGL3_UpdateFontsTexture()
+{
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    if (atlas->TexUpdates.empty() || g_FontTexture == 0)
+        return;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+    const bool single_channel = (g_FontTextureFormat == GL_R8);
+#else
+    const bool single_channel = false;
+#endif
+    if (single_channel ? (atlas->TexPixelsAlpha8 == NULL) : (atlas->TexPixelsRGBA32 == NULL || g_FontTextureFormat != GL_RGBA))
+        return;
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, g_FontTexture));
+    GLint last_unpack_alignment;
+    GL_CALL(glGetIntegerv(GL_UNPACK_ALIGNMENT, &last_unpack_alignment));
+    GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));  // GL_R8 rows are tightly packed
+#ifdef GL_UNPACK_ROW_LENGTH
+    GLint last_unpack_row_length;
+    GL_CALL(glGetIntegerv(GL_UNPACK_ROW_LENGTH, &last_unpack_row_length));
+    GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, atlas->TexWidth));
+#endif
+    for (int n = 0; n < atlas->TexUpdates.Size; n++)
+    {
+        const ImFontAtlasTexUpdate& r = atlas->TexUpdates[n];
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+        if (single_channel)
+        {
+            const unsigned char* pixels = atlas->TexPixelsAlpha8 + (size_t)r.Y * atlas->TexWidth + r.X;
+            GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.X, r.Y, r.Width, r.Height, GL_RED, GL_UNSIGNED_BYTE, pixels));
+            continue;
+        }
+#endif
+#ifdef GL_UNPACK_ROW_LENGTH
+        const unsigned int* pixels = atlas->TexPixelsRGBA32 + (size_t)r.Y * atlas->TexWidth + r.X;
+        GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.X, r.Y, r.Width, r.Height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+#else
+        // No GL_UNPACK_ROW_LENGTH on ES2: upload whole rows
+        const unsigned int* pixels = atlas->TexPixelsRGBA32 + (size_t)r.Y * atlas->TexWidth;
+        GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, r.Y, atlas->TexWidth, r.Height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+#endif
+    }
+#ifdef GL_UNPACK_ROW_LENGTH
+    GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, last_unpack_row_length));
+#endif
+    GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, last_unpack_alignment));
+    atlas->TexUpdates.resize(0);
 }
 
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
+// See ImGui_ImplOpenGL3_SetHostStateFlags()/ImGui_ImplOpenGL3_SetTrustedHost() to reduce that cost when the host cooperates.
 void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 {
     // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
@@ -348,146 +1074,149 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
     if (fb_width <= 0 || fb_height <= 0)
         return;
+    g_GlCallCount = 0;
 
     // Backup GL state
-    GLenum last_active_texture; glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
-    glActiveTexture(GL_TEXTURE0);
-    GLuint last_program; glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&last_program);
-    GLuint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&last_texture);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    GLuint last_sampler; if (g_GlVersion >= 330) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&last_sampler); } else { last_sampler = 0; }
-#endif
-    GLuint last_array_buffer; glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&last_array_buffer);
-#ifndef IMGUI_IMPL_OPENGL_ES2
-    GLuint last_vertex_array_object; glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&last_vertex_array_object);
-#endif
-#ifdef GL_POLYGON_MODE
-    GLint last_polygon_mode[2]; glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode);
-#endif
-    GLint last_viewport[4]; glGetIntegerv(GL_VIEWPORT, last_viewport);
-    GLint last_scissor_box[4]; glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
-    GLenum last_blend_src_rgb; glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb);
-    GLenum last_blend_dst_rgb; glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb);
-    GLenum last_blend_src_alpha; glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha);
-    GLenum last_blend_dst_alpha; glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha);
-    GLenum last_blend_equation_rgb; glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb);
-    GLenum last_blend_equation_alpha; glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha);
-    GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
-    GLboolean last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
-    GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
-    GLboolean last_enable_stencil_test = glIsEnabled(GL_STENCIL_TEST);
-    GLboolean last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    GLboolean last_enable_primitive_restart = (g_GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
-#endif
+    ImGui_ImplOpenGL3_BackupHostState(&g_HostState);
+    ImGui_ImplOpenGL3_UpdateFontsTexture();
 
     // Setup desired GL state
-    // Recreate the VAO every time (this is to easily allow multiple GL contexts to be rendered to. VAO are not shared among GL contexts)
+    // VAO are not shared among GL contexts: reuse the one of the current context, or recreate it every time if we can't identify the context.
     // The renderer would actually work without any VAO bound, but then our VertexAttrib calls would overwrite the default one currently bound.
     GLuint vertex_array_object = 0;
+#if defined(IMGUI_IMPL_OPENGL_MAY_HAVE_VAO_CACHE)
+    vertex_array_object = ImGui_ImplOpenGL3_GetContextVertexArray();
+#endif
 #ifndef IMGUI_IMPL_OPENGL_ES2
-    glGenVertexArrays(1, &vertex_array_object);
+    const bool temporary_vertex_array_object = (vertex_array_object == 0);
+    if (temporary_vertex_array_object)
+        GL_CALL(glGenVertexArrays(1, &vertex_array_object));
 #endif
-    ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
 
-    // Will project scissor/clipping rectangles into framebuffer space
-    ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
-    ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+    // Desktop GL 4.4+: upload the whole frame into the persistently mapped ring once, instead of once per command list.
+    // (global_vtx_offset/global_idx_offset then address each command list inside the ring segment)
+    int global_vtx_offset = 0;
+    int global_idx_offset = 0;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    g_UseRingBuffers = g_HasBufferStorage && ImGui_ImplOpenGL3_UploadRingBuffers(draw_data, &global_vtx_offset, &global_idx_offset);
+    const bool use_ring_buffers = g_UseRingBuffers;
+#else
+    const bool use_ring_buffers = false;
+#endif
 
-    // Render command lists
-    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    // Desktop GL 4.3+, opt-in: draw the frame with one glMultiDrawElementsIndirect() call per run of commands sharing a texture
+    bool use_multi_draw = false;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MULTI_DRAW
+    if (g_MultiDrawEnabled && use_ring_buffers && g_MultiDrawShaderHandle == 0 && !ImGui_ImplOpenGL3_CreateMultiDrawObjects())
+        g_MultiDrawEnabled = g_HasMultiDraw = false;
+    if (g_MultiDrawEnabled && use_ring_buffers)
     {
-        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        ImGui_ImplOpenGL3_SetupMultiDrawBatches(draw_data, fb_width, fb_height, global_vtx_offset, global_idx_offset);
+        use_multi_draw = g_UseMultiDraw = true;
+    }
+#endif
+    ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MULTI_DRAW
+    if (use_multi_draw)
+    {
+        ImGui_ImplOpenGL3_RenderMultiDrawBatches(draw_data, fb_width, fb_height, vertex_array_object);
+        g_UseMultiDraw = false;
+    }
+#endif
 
-        // Upload vertex/index buffers
-        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+    if (!use_multi_draw)
+    {
+        // Will project scissor/clipping rectangles into framebuffer space
+        ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
+        ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
-        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        // Render command lists
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
         {
-            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
-            if (pcmd->UserCallback != NULL)
+            const ImDrawList* cmd_list = draw_data->CmdLists[n];
+
+            // Upload vertex/index buffers
+            if (!use_ring_buffers)
             {
-                // User callback, registered via ImDrawList::AddCallback()
-                // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
-                if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
-                    ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
-                else
-                    pcmd->UserCallback(cmd_list, pcmd);
+                GL_CALL(glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW));
+                GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW));
             }
-            else
+
+            for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
             {
-                // Project scissor/clipping rectangles into framebuffer space
-                ImVec4 clip_rect;
-                clip_rect.x = (pcmd->ClipRect.x - clip_off.x) * clip_scale.x;
-                clip_rect.y = (pcmd->ClipRect.y - clip_off.y) * clip_scale.y;
-                clip_rect.z = (pcmd->ClipRect.z - clip_off.x) * clip_scale.x;
-                clip_rect.w = (pcmd->ClipRect.w - clip_off.y) * clip_scale.y;
-
-                if (clip_rect.x < fb_width && clip_rect.y < fb_height && clip_rect.z >= 0.0f && clip_rect.w >= 0.0f)
+                const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+                if (pcmd->UserCallback != NULL)
                 {
-                    // Apply scissor/clipping rectangle
-                    glScissor((int)clip_rect.x, (int)(fb_height - clip_rect.w), (int)(clip_rect.z - clip_rect.x), (int)(clip_rect.w - clip_rect.y));
-
-                    // Bind texture, Draw
-                    glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID());
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
-                    if (g_GlVersion >= 320)
-                        glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset);
+                    // User callback, registered via ImDrawList::AddCallback()
+                    // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                    if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                        ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
                     else
+                        pcmd->UserCallback(cmd_list, pcmd);
+                }
+                else
+                {
+                    // Project scissor/clipping rectangles into framebuffer space
+                    ImVec4 clip_rect;
+                    clip_rect.x = (pcmd->ClipRect.x - clip_off.x) * clip_scale.x;
+                    clip_rect.y = (pcmd->ClipRect.y - clip_off.y) * clip_scale.y;
+                    clip_rect.z = (pcmd->ClipRect.z - clip_off.x) * clip_scale.x;
+                    clip_rect.w = (pcmd->ClipRect.w - clip_off.y) * clip_scale.y;
+
+                    if (clip_rect.x < fb_width && clip_rect.y < fb_height && clip_rect.z >= 0.0f && clip_rect.w >= 0.0f)
+                    {
+                        // Apply scissor/clipping rectangle
+                        GL_CALL(glScissor((int)clip_rect.x, (int)(fb_height - clip_rect.w), (int)(clip_rect.z - clip_rect.x), (int)(clip_rect.w - clip_rect.y)));
+
+                        // Bind texture, Draw
+                        ImGui_ImplOpenGL3_BindTexture((GLuint)(intptr_t)pcmd->GetTexID());
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
+                        if (g_GlVersion >= 320)
+                            GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)((pcmd->IdxOffset + global_idx_offset) * sizeof(ImDrawIdx)), (GLint)(pcmd->VtxOffset + global_vtx_offset)));
+                        else
 #endif
-                    glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)));
+                        GL_CALL(glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx))));
+                    }
                 }
             }
+            if (use_ring_buffers)
+            {
+                global_vtx_offset += cmd_list->VtxBuffer.Size;
+                global_idx_offset += cmd_list->IdxBuffer.Size;
+            }
         }
     }
 
-    // Destroy the temporary VAO
-#ifndef IMGUI_IMPL_OPENGL_ES2
-    glDeleteVertexArrays(1, &vertex_array_object);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    // Mark the end of this frame's reads from the ring segment, and move on to the next one
+    if (use_ring_buffers)
+    {
+        g_RingFences[g_RingSegment] = GL_CALL(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        g_RingSegment = (g_RingSegment + 1) % IMGUI_IMPL_OPENGL_RING_FRAMES;
+        g_UseRingBuffers = false;
+    }
 #endif
 
-    // Restore modified GL state
-    glUseProgram(last_program);
-    glBindTexture(GL_TEXTURE_2D, last_texture);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    if (g_GlVersion >= 330)
-        glBindSampler(0, last_sampler);
-#endif
-    glActiveTexture(last_active_texture);
+    // Destroy the temporary VAO
 #ifndef IMGUI_IMPL_OPENGL_ES2
-    glBindVertexArray(last_vertex_array_object);
-#endif
-    glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
-    glBlendEquationSeparate(last_blend_equation_rgb, last_blend_equation_alpha);
-    glBlendFuncSeparate(last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha, last_blend_dst_alpha);
-    if (last_enable_blend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
-    if (last_enable_cull_face) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
-    if (last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
-    if (last_enable_stencil_test) glEnable(GL_STENCIL_TEST); else glDisable(GL_STENCIL_TEST);
-    if (last_enable_scissor_test) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    if (g_GlVersion >= 310) { if (last_enable_primitive_restart) glEnable(GL_PRIMITIVE_RESTART); else glDisable(GL_PRIMITIVE_RESTART); }
+    if (temporary_vertex_array_object)
+        GL_CALL(glDeleteVertexArrays(1, &vertex_array_object));
 #endif
 
-#ifdef GL_POLYGON_MODE
-    glPolygonMode(GL_FRONT_AND_BACK, (GLenum)last_polygon_mode[0]);
-#endif
-    glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
-    glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
+    // Restore modified GL state
+    ImGui_ImplOpenGL3_RestoreHostState(&g_HostState);
+    g_LastFrameGlCallCount = g_GlCallCount;
 }
 
 bool ImGui_ImplOpenGL3_CreateFontsTexture()
 {
-    // Build texture atlas
     ImGuiIO& io = ImGui::GetIO();
-    unsigned char* pixels;
-    int width, height;
-    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);   // Load as RGBA 32-bit (75% of the memory is wasted, but default font is so small) because it is more likely to be compatible with user's existing shaders. If your ImTextureId represent a higher-level concept than just a GL texture id, consider calling GetTexDataAsAlpha8() instead to save on GPU memory.
 
     // Upload texture to graphics system
-    GLint last_texture;
+    GLint last_texture, last_unpack_alignment;
     glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &last_unpack_alignment);
     glGenTextures(1, &g_FontTexture);
     glBindTexture(GL_TEXTURE_2D, g_FontTexture);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -495,13 +1224,54 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
 #ifdef GL_UNPACK_ROW_LENGTH
     glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 #endif
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // GL_R8 rows are tightly packed, whatever the width
+
+    // Build texture atlas
+    // The atlas is single channel: when texture swizzles are available, upload it as GL_R8 (or BC4) and sample it as (1,1,1,R), which is what the RGBA32 data holds.
+    // Keep RGBA when the atlas uses colors, or when RGBA32 data was requested before us (e.g. to write colored custom rectangles into it).
+    unsigned char* pixels;
+    int width, height;
+    g_FontTextureFormat = GL_RGBA;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+    if (g_HasTextureSwizzle && io.Fonts->TexPixelsRGBA32 == NULL)
+    {
+        io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+        if (!io.Fonts->TexPixelsUseColors)
+        {
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_ONE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_ONE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_ONE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED);
+            g_FontTextureFormat = GL_R8;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_RGTC
+            // BC4 blocks can't take the sub-rectangle updates of dynamic glyphs
+            if (g_FontTextureCompress && !(io.Fonts->Flags & ImFontAtlasFlags_DynamicGlyphs))
+            {
+                int blocks_size = 0;
+                io.Fonts->GetTexDataAsBC4(&pixels, &width, &height, &blocks_size);
+                glCompressedTexImage2D(GL_TEXTURE_2D, 0, GL_COMPRESSED_RED_RGTC1, width, height, 0, blocks_size, pixels);
+                g_FontTextureFormat = GL_COMPRESSED_RED_RGTC1;
+            }
+            else
+#endif
+            {
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, pixels);
+            }
+        }
+    }
+#endif
+    if (g_FontTextureFormat == GL_RGBA)
+    {
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);   // Load as RGBA 32-bit (75% of the memory is wasted, but default font is so small) because it is more likely to be compatible with user's existing shaders. If your ImTextureId represent a higher-level concept than just a GL texture id, consider calling GetTexDataAsAlpha8() instead to save on GPU memory.
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    }
 
     // Store our identifier
     io.Fonts->SetTexID((ImTextureID)(intptr_t)g_FontTexture);
 
     // Restore state
     glBindTexture(GL_TEXTURE_2D, last_texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, last_unpack_alignment);
 
     return true;
 }
@@ -514,6 +1284,7 @@ void ImGui_ImplOpenGL3_DestroyFontsTexture()
         glDeleteTextures(1, &g_FontTexture);
         io.Fonts->SetTexID(0);
         g_FontTexture = 0;
+        g_FontTextureFormat = 0;
     }
 }
 
@@ -553,6 +1324,11 @@ static bool CheckProgram(GLuint handle, const char* desc)
     return (GLboolean)status == GL_TRUE;
 }
 
+static const GLchar* ImGui_ImplOpenGL3_GetFragmentShaderDefines()
+{
+    return g_SdfFontTexture ? "#define IMGUI_IMPL_OPENGL_SDF_FONT\n" : "";
+}
+
 bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 {
     // Backup GL state
@@ -568,6 +1344,10 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
     int glsl_version = 130;
     sscanf(g_GlslVersionString, "#version %d", &glsl_version);
 
+    // Distance field variant of the fragment shaders, enabled by the 'FontSdf' uniform when drawing with the font texture.
+    // The atlas alpha then holds a distance to the glyph outline (0.5 on the outline), turned into coverage over about one screen pixel.
+    g_SdfFontTexture = (ImGui::GetIO().BackendFlags & ImGuiBackendFlags_RendererHasSdfFonts) && (ImGui::GetIO().Fonts->Flags & ImFontAtlasFlags_SDF);
+
     const GLchar* vertex_shader_glsl_120 =
         "uniform mat4 ProjMtx;\n"
         "attribute vec2 Position;\n"
@@ -632,9 +1412,20 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "uniform sampler2D Texture;\n"
         "varying vec2 Frag_UV;\n"
         "varying vec4 Frag_Color;\n"
+        "#ifdef IMGUI_IMPL_OPENGL_SDF_FONT\n"
+        "uniform bool FontSdf;\n"
+        "#endif\n"
         "void main()\n"
         "{\n"
         "    gl_FragColor = Frag_Color * texture2D(Texture, Frag_UV.st);\n"
+        "#ifdef IMGUI_IMPL_OPENGL_SDF_FONT\n"
+        "    if (FontSdf)\n"
+        "    {\n"
+        "        float d = texture2D(Texture, Frag_UV.st).a;\n"
+        "        float w = max(0.5 * fwidth(d), 1.0 / 255.0);\n"
+        "        gl_FragColor.a = Frag_Color.a * smoothstep(0.5 - w, 0.5 + w, d);\n"
+        "    }\n"
+        "#endif\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_130 =
@@ -642,9 +1433,20 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "out vec4 Out_Color;\n"
+        "#ifdef IMGUI_IMPL_OPENGL_SDF_FONT\n"
+        "uniform bool FontSdf;\n"
+        "#endif\n"
         "void main()\n"
         "{\n"
         "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "#ifdef IMGUI_IMPL_OPENGL_SDF_FONT\n"
+        "    if (FontSdf)\n"
+        "    {\n"
+        "        float d = texture(Texture, Frag_UV.st).a;\n"
+        "        float w = max(0.5 * fwidth(d), 1.0 / 255.0);\n"
+        "        Out_Color.a = Frag_Color.a * smoothstep(0.5 - w, 0.5 + w, d);\n"
+        "    }\n"
+        "#endif\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_300_es =
@@ -653,9 +1455,20 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
+        "#ifdef IMGUI_IMPL_OPENGL_SDF_FONT\n"
+        "uniform bool FontSdf;\n"
+        "#endif\n"
         "void main()\n"
         "{\n"
         "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "#ifdef IMGUI_IMPL_OPENGL_SDF_FONT\n"
+        "    if (FontSdf)\n"
+        "    {\n"
+        "        float d = texture(Texture, Frag_UV.st).a;\n"
+        "        float w = max(0.5 * fwidth(d), 1.0 / 255.0);\n"
+        "        Out_Color.a = Frag_Color.a * smoothstep(0.5 - w, 0.5 + w, d);\n"
+        "    }\n"
+        "#endif\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_410_core =
@@ -663,9 +1476,20 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "in vec4 Frag_Color;\n"
         "uniform sampler2D Texture;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
+        "#ifdef IMGUI_IMPL_OPENGL_SDF_FONT\n"
+        "uniform bool FontSdf;\n"
+        "#endif\n"
         "void main()\n"
         "{\n"
         "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "#ifdef IMGUI_IMPL_OPENGL_SDF_FONT\n"
+        "    if (FontSdf)\n"
+        "    {\n"
+        "        float d = texture(Texture, Frag_UV.st).a;\n"
+        "        float w = max(0.5 * fwidth(d), 1.0 / 255.0);\n"
+        "        Out_Color.a = Frag_Color.a * smoothstep(0.5 - w, 0.5 + w, d);\n"
+        "    }\n"
+        "#endif\n"
         "}\n";
 
     // Select shaders matching our GLSL versions
@@ -699,9 +1523,9 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
     glCompileShader(g_VertHandle);
     CheckShader(g_VertHandle, "vertex shader");
 
-    const GLchar* fragment_shader_with_version[2] = { g_GlslVersionString, fragment_shader };
+    const GLchar* fragment_shader_with_version[3] = { g_GlslVersionString, ImGui_ImplOpenGL3_GetFragmentShaderDefines(), fragment_shader };
     g_FragHandle = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(g_FragHandle, 2, fragment_shader_with_version, NULL);
+    glShaderSource(g_FragHandle, 3, fragment_shader_with_version, NULL);
     glCompileShader(g_FragHandle);
     CheckShader(g_FragHandle, "fragment shader");
 
@@ -713,6 +1537,7 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 
     g_AttribLocationTex = glGetUniformLocation(g_ShaderHandle, "Texture");
     g_AttribLocationProjMtx = glGetUniformLocation(g_ShaderHandle, "ProjMtx");
+    g_AttribLocationFontSdf = glGetUniformLocation(g_ShaderHandle, "FontSdf");
     g_AttribLocationVtxPos = (GLuint)glGetAttribLocation(g_ShaderHandle, "Position");
     g_AttribLocationVtxUV = (GLuint)glGetAttribLocation(g_ShaderHandle, "UV");
     g_AttribLocationVtxColor = (GLuint)glGetAttribLocation(g_ShaderHandle, "Color");
@@ -733,8 +1558,31 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
     return true;
 }
 
+void    ImGui_ImplOpenGL3_DestroyContextObjects()
+{
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VAO_CACHE
+    void* context = IMGUI_IMPL_OPENGL_GET_CURRENT_CONTEXT();
+    for (int n = 0; n < g_ContextVaos.Size; n++)
+        if (g_ContextVaos[n].Context == context)
+        {
+            glDeleteVertexArrays(1, &g_ContextVaos[n].VertexArrayObject);
+            g_ContextVaos.erase(g_ContextVaos.Data + n);
+            break;
+        }
+#endif
+}
+
 void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
 {
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VAO_CACHE
+    ImGui_ImplOpenGL3_DestroyContextVertexArrays();
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_MULTI_DRAW
+    ImGui_ImplOpenGL3_DestroyMultiDrawObjects();
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    ImGui_ImplOpenGL3_DestroyRingBuffers();
+#endif
     if (g_VboHandle)        { glDeleteBuffers(1, &g_VboHandle); g_VboHandle = 0; }
     if (g_ElementsHandle)   { glDeleteBuffers(1, &g_ElementsHandle); g_ElementsHandle = 0; }
     if (g_ShaderHandle && g_VertHandle) { glDetachShader(g_ShaderHandle, g_VertHandle); }
@@ -37,6 +37,40 @@ IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyFontsTexture();
 IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_CreateDeviceObjects();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyDeviceObjects();
 
+// (Optional) Rendering from several GL contexts: a VAO is kept for each context which called ImGui_ImplOpenGL3_RenderDrawData(), as VAO are not shared among contexts.
+// A VAO can only be deleted from its own context, so ImGui_ImplOpenGL3_DestroyDeviceObjects() and ImGui_ImplOpenGL3_Shutdown() only delete the one of the current
+// context and forget the others, which are then released when their context is destroyed. Call DestroyContextObjects() with a context current to release its VAO
+// earlier, e.g. before shutting down the backend from another context while this one stays alive.
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyContextObjects();
+
+// (Optional) Reduce the cost of backing up and restoring the host GL state in ImGui_ImplOpenGL3_RenderDrawData().
+// - SetHostStateFlags(): declare which groups of state the host may change between two frames (default: All).
+//   Other groups are only queried once, then restored from their shadowed value.
+// - SetTrustedHost(true): skip backup/restore entirely. The host must setup all of its own state after rendering the overlay.
+// - GetFrameGLCallCount(): number of GL calls issued by the last ImGui_ImplOpenGL3_RenderDrawData() call.
+enum ImGui_ImplOpenGL3_HostState_
+{
+    ImGui_ImplOpenGL3_HostState_None        = 0,
+    ImGui_ImplOpenGL3_HostState_Program     = 1 << 0,   // GL_CURRENT_PROGRAM
+    ImGui_ImplOpenGL3_HostState_Textures    = 1 << 1,   // GL_ACTIVE_TEXTURE, GL_TEXTURE_BINDING_2D, GL_SAMPLER_BINDING
+    ImGui_ImplOpenGL3_HostState_Buffers     = 1 << 2,   // GL_ARRAY_BUFFER_BINDING, GL_VERTEX_ARRAY_BINDING
+    ImGui_ImplOpenGL3_HostState_Blend       = 1 << 3,   // Blend functions and equations
+    ImGui_ImplOpenGL3_HostState_Enables     = 1 << 4,   // GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST, GL_STENCIL_TEST, GL_SCISSOR_TEST, GL_PRIMITIVE_RESTART
+    ImGui_ImplOpenGL3_HostState_Raster      = 1 << 5,   // GL_POLYGON_MODE, GL_VIEWPORT, GL_SCISSOR_BOX, GL_CLIP_ORIGIN
+    ImGui_ImplOpenGL3_HostState_All         = (1 << 6) - 1
+};
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetHostStateFlags(int flags);
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetTrustedHost(bool trusted_host);
+IMGUI_IMPL_API int      ImGui_ImplOpenGL3_GetFrameGLCallCount();
+
+// (Optional) Desktop GL 4.3+ with GL_ARB_buffer_storage (or 4.4+): draw each run of consecutive commands sharing a texture with a single glMultiDrawElementsIndirect() call.
+// Clipping is then done in the fragment shader instead of with glScissor(). Call after ImGui_ImplOpenGL3_Init(). Returns false if unsupported by the current context.
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_SetMultiDraw(bool enable);
+
+// (Optional) Desktop GL 3.3+: upload the font atlas as BC4 (GL_COMPRESSED_RED_RGTC1, 0.5 byte per pixel instead of 1 for GL_R8), at a small cost in glyph edge accuracy.
+// Ignored with ImFontAtlasFlags_DynamicGlyphs. Call after ImGui_ImplOpenGL3_Init() and before the font texture is created. Returns false if unsupported by the current context.
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_SetFontTextureCompression(bool compress);
+
 // Specific OpenGL ES versions
 //#define IMGUI_IMPL_OPENGL_ES2     // Auto-detected on Emscripten
 //#define IMGUI_IMPL_OPENGL_ES3     // Auto-detected on iOS/Android
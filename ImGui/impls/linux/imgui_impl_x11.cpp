@@ -15,10 +15,13 @@
 #include <X11/keysym.h>
 #include <GL/glew.h>
 
+#include <cfloat>
+#include <cstring>
 #include <ctime>
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2026-10-17: Added ImGui_ImplX11_SetEventDriven(): mouse position, modifiers and display size are taken from forwarded events, no per-frame server round-trips.
 //  2019-08-31: Initial X11 implementation
 
 // X11 Data
@@ -29,6 +32,9 @@ static uint64_t             g_TicksPerSecond = 0;
 static ImGuiMouseCursor     g_LastMouseCursor = ImGuiMouseCursor_COUNT;
 static bool                 g_HasGamepad = false;
 static bool                 g_WantUpdateHasGamepad = true;
+static bool                 g_EventDriven = false;
+static unsigned int         g_DisplayWidth = 0;
+static unsigned int         g_DisplayHeight = 0;
 
 bool GetKeyState(int keysym, char keys[32])
 {
@@ -110,6 +116,64 @@ void    ImGui_ImplX11_Shutdown()
 {
     g_Display = nullptr;
     g_Window = 0;
+    g_EventDriven = false;
+}
+
+static void ImGui_ImplX11_UpdateDisplaySize()
+{
+    Window unused_window;
+    int unused_int;
+    unsigned int unused_unsigned_int;
+
+    XGetGeometry(g_Display, (Window)g_Window, &unused_window, &unused_int, &unused_int, &g_DisplayWidth, &g_DisplayHeight, &unused_unsigned_int, &unused_unsigned_int);
+}
+
+// The state field of key/button/motion events holds the modifiers as they were *before* the event,
+// so a modifier key event also applies its own transition on top of it.
+static void ImGui_ImplX11_UpdateKeyModifiers(unsigned int state, KeySym key, bool down)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.KeyCtrl = (state & ControlMask) != 0;
+    io.KeyShift = (state & ShiftMask) != 0;
+    io.KeyAlt = (state & Mod1Mask) != 0;
+    io.KeySuper = (state & Mod4Mask) != 0;
+    switch (key)
+    {
+        case XK_Control_L: case XK_Control_R: io.KeyCtrl = down; break;
+        case XK_Shift_L:   case XK_Shift_R:   io.KeyShift = down; break;
+        case XK_Alt_L:     case XK_Alt_R:     io.KeyAlt = down; break;
+        case XK_Super_L:   case XK_Super_R:   io.KeySuper = down; break;
+    }
+}
+
+// In event-driven mode NewFrame() never talks to the X server: everything comes from the events forwarded to ImGui_ImplX11_EventHandler().
+// Enabling it does a few round-trips once (window attributes, geometry, pointer) to seed the state and to make sure the window reports
+// the events we rely on. XSelectInput() replaces our client's mask for the window, so we OR ours into the one already selected.
+void    ImGui_ImplX11_SetEventDriven(bool event_driven)
+{
+    g_EventDriven = event_driven;
+    if (!event_driven || g_Display == nullptr)
+        return;
+
+    XWindowAttributes attributes;
+    if (XGetWindowAttributes(g_Display, g_Window, &attributes))
+    {
+        const long wanted_mask = KeyPressMask | KeyReleaseMask | ButtonPressMask | ButtonReleaseMask | PointerMotionMask | EnterWindowMask | LeaveWindowMask | StructureNotifyMask | FocusChangeMask;
+        if ((attributes.your_event_mask & wanted_mask) != wanted_mask)
+            XSelectInput(g_Display, g_Window, attributes.your_event_mask | wanted_mask);
+    }
+
+    ImGui_ImplX11_UpdateDisplaySize();
+
+    ImGuiIO& io = ImGui::GetIO();
+    Window unused_window;
+    int rx, ry, x, y;
+    unsigned int mask;
+    if (XQueryPointer(g_Display, g_Window, &unused_window, &unused_window, &rx, &ry, &x, &y, &mask))
+    {
+        io.MousePos = ImVec2((float)x, (float)y);
+        ImGui_ImplX11_UpdateKeyModifiers(mask, NoSymbol, false);
+    }
 }
 
 static bool ImGui_ImplX11_UpdateMouseCursor()
@@ -222,15 +286,11 @@ void    ImGui_ImplX11_NewFrame()
     ImGuiIO& io = ImGui::GetIO();
     IM_ASSERT(io.Fonts->IsBuilt() && "Font atlas not built! It is generally built by the renderer back-end. Missing call to renderer _NewFrame() function? e.g. ImGui_ImplOpenGL3_NewFrame().");
 
-    unsigned int width, height;
-    Window unused_window;
-    int unused_int;
-    unsigned int unused_unsigned_int;
-
-    XGetGeometry(g_Display, (Window)g_Window, &unused_window, &unused_int, &unused_int, &width, &height, &unused_unsigned_int, &unused_unsigned_int);
-
-    io.DisplaySize.x = width;
-    io.DisplaySize.y = height;
+    // Setup display size (every frame to accommodate for window resizing, from ConfigureNotify in event-driven mode)
+    if (!g_EventDriven)
+        ImGui_ImplX11_UpdateDisplaySize();
+    io.DisplaySize.x = g_DisplayWidth;
+    io.DisplaySize.y = g_DisplayHeight;
 
     timespec ts, tsres;
     clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
@@ -240,18 +300,22 @@ void    ImGui_ImplX11_NewFrame()
     io.DeltaTime = (float)(current_time - g_Time) / g_TicksPerSecond;
     g_Time = current_time;
 
-    // Read keyboard modifiers inputs
-    char keys[32];
-    XQueryKeymap(g_Display, keys);
-
-    io.KeyCtrl = GetKeyState(XK_Control_L, keys);
-    io.KeyShift = GetKeyState(XK_Shift_L, keys);
-    io.KeyAlt = GetKeyState(XK_Alt_L, keys);
-    io.KeySuper = false;
-    // io.KeysDown[], io.MousePos, io.MouseDown[], io.MouseWheel: filled by the WndProc handler below.
-
-    // Update OS mouse position
-    ImGui_ImplX11_UpdateMousePos();
+    // In event-driven mode modifiers and mouse position are kept up to date by ImGui_ImplX11_EventHandler()
+    if (!g_EventDriven)
+    {
+        // Read keyboard modifiers inputs
+        char keys[32];
+        XQueryKeymap(g_Display, keys);
+
+        io.KeyCtrl = GetKeyState(XK_Control_L, keys);
+        io.KeyShift = GetKeyState(XK_Shift_L, keys);
+        io.KeyAlt = GetKeyState(XK_Alt_L, keys);
+        io.KeySuper = false;
+        // io.KeysDown[], io.MousePos, io.MouseDown[], io.MouseWheel: filled by the WndProc handler below.
+
+        // Update OS mouse position
+        ImGui_ImplX11_UpdateMousePos();
+    }
     /*
     // Update OS mouse cursor with the cursor requested by imgui
     ImGuiMouseCursor mouse_cursor = io.MouseDrawCursor ? ImGuiMouseCursor_None : ImGui::GetMouseCursor();
@@ -281,6 +345,11 @@ IMGUI_IMPL_API int ImGui_ImplX11_EventHandler(XEvent &event)
     {
         case ButtonPress:
         case ButtonRelease:
+            if (g_EventDriven)
+            {
+                io.MousePos = ImVec2((float)event.xbutton.x, (float)event.xbutton.y);
+                ImGui_ImplX11_UpdateKeyModifiers(event.xbutton.state, NoSymbol, false);
+            }
             switch(event.xbutton.button)
             {
                 case Button1:
@@ -308,9 +377,46 @@ IMGUI_IMPL_API int ImGui_ImplX11_EventHandler(XEvent &event)
 
             break;
 
+        case MotionNotify:
+            if (g_EventDriven)
+            {
+                io.MousePos = ImVec2((float)event.xmotion.x, (float)event.xmotion.y);
+                ImGui_ImplX11_UpdateKeyModifiers(event.xmotion.state, NoSymbol, false);
+            }
+            return 0;
+
+        case EnterNotify:
+            if (g_EventDriven)
+                io.MousePos = ImVec2((float)event.xcrossing.x, (float)event.xcrossing.y);
+            return 0;
+
+        case LeaveNotify:
+            if (g_EventDriven)
+                io.MousePos = ImVec2(-FLT_MAX, -FLT_MAX);
+            return 0;
+
+        case ConfigureNotify:
+            if (g_EventDriven && event.xconfigure.window == g_Window)
+            {
+                g_DisplayWidth = event.xconfigure.width;
+                g_DisplayHeight = event.xconfigure.height;
+            }
+            return 0;
+
+        case FocusOut:
+            // Key releases sent while another window has the focus never reach us
+            if (g_EventDriven)
+            {
+                memset(io.KeysDown, 0, sizeof(io.KeysDown));
+                io.KeyCtrl = io.KeyShift = io.KeyAlt = io.KeySuper = false;
+            }
+            return 0;
+
         case KeyPress:
         {
             int key = XKeycodeToKeysym(g_Display, event.xkey.keycode, event.xkey.state & ShiftMask ? 1 : 0);
+            if (g_EventDriven)
+                ImGui_ImplX11_UpdateKeyModifiers(event.xkey.state, key, true);
             if( IsKeySys(key) )
                 io.KeysDown[event.xkey.keycode] = true;
             else
@@ -321,6 +427,8 @@ IMGUI_IMPL_API int ImGui_ImplX11_EventHandler(XEvent &event)
         case KeyRelease:
         {
             int key = XKeycodeToKeysym(g_Display, event.xkey.keycode, event.xkey.state & ShiftMask ? 1 : 0);
+            if (g_EventDriven)
+                ImGui_ImplX11_UpdateKeyModifiers(event.xkey.state, key, false);
             if( IsKeySys(key) )
                 io.KeysDown[event.xkey.keycode] = false;
             return 0;
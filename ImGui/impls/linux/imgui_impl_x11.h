@@ -13,6 +13,11 @@ IMGUI_IMPL_API bool     ImGui_ImplX11_Init(void* display, void* window);
 IMGUI_IMPL_API void     ImGui_ImplX11_Shutdown();
 IMGUI_IMPL_API void     ImGui_ImplX11_NewFrame();
 
+// Event-driven input: mouse position, modifiers and display size are taken from the events passed to ImGui_ImplX11_EventHandler()
+// (MotionNotify, EnterNotify/LeaveNotify, ConfigureNotify, FocusOut, key and button events) instead of XQueryPointer/XQueryKeymap/XGetGeometry
+// round-trips every frame. Call after Init(). The required events are added to the window's event mask when enabling.
+IMGUI_IMPL_API void     ImGui_ImplX11_SetEventDriven(bool event_driven);
+
 // Handler for Win32 messages, update mouse/keyboard data.
 // You may or not need this for your implementation, but it can serve as reference for handling inputs.
 // Intentionally commented out to avoid dragging dependencies on <windows.h> types. You can COPY this line into your .cpp code instead.
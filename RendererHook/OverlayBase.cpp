@@ -2,7 +2,9 @@
 #include "RendererDetector.h"
 #include <imgui.h>
 #include "Windows/WindowsHook.h"
+#include <ShlObj.h>
 #include <cmath>
+#include <filesystem>
 
 OverlayBase* OverlayBase::Instance = nullptr;
 
@@ -18,6 +20,22 @@ void OverlayBase::HookReady()
 	}
 }
 
+// %LOCALAPPDATA%\OHook\fonts.cache: a per-user directory, unlike the temp directory which other accounts may be able to write to.
+// Returns an empty path if the directory can't be found or created (the atlas is then built without the cache).
+static std::filesystem::path GetFontCachePath()
+{
+	PWSTR local_app_data = nullptr;
+	std::filesystem::path cache_dir;
+	if (SUCCEEDED(SHGetKnownFolderPath(FOLDERID_LocalAppData, KF_FLAG_DEFAULT, nullptr, &local_app_data)))
+		cache_dir = std::filesystem::path(local_app_data) / "OHook";
+	CoTaskMemFree(local_app_data);
+
+	std::error_code ec;
+	if (cache_dir.empty() || (!std::filesystem::create_directories(cache_dir, ec) && ec))
+		return {};
+	return cache_dir / "fonts.cache";
+}
+
 void OverlayBase::CreateFonts()
 {
 	ImGuiIO& io = ImGui::GetIO();
@@ -27,11 +45,34 @@ void OverlayBase::CreateFonts()
 	fontcfg.PixelSnapH = true;
 	fontcfg.GlyphRanges = io.Fonts->GetGlyphRangesDefault();
 
-	fontcfg.SizePixels = std::round(io.DisplaySize.y / 68);
-	FontDefault = io.Fonts->AddFontDefault(&fontcfg);
+	if (io.BackendFlags & ImGuiBackendFlags_RendererHasSdfFonts)
+	{
+		// One distance field font for both, scaled in OverlayProc() so it follows the display size without rebuilding the atlas
+		io.Fonts->Flags |= ImFontAtlasFlags_SDF;
+		FontSdfSize = 32.0f;
+		fontcfg.SizePixels = FontSdfSize;
+		FontDefault = FontHUD = io.Fonts->AddFontDefault(&fontcfg);
+	}
+	else
+	{
+		fontcfg.SizePixels = std::round(io.DisplaySize.y / 68);
+		FontDefault = io.Fonts->AddFontDefault(&fontcfg);
+
+		fontcfg.SizePixels = std::round(io.DisplaySize.y / 60);
+		FontHUD = io.Fonts->AddFontDefault(&fontcfg);
+	}
 
-	fontcfg.SizePixels = std::round(io.DisplaySize.y / 60);
-	FontHUD = io.Fonts->AddFontDefault(&fontcfg);
+	// Reuse the atlas built by a previous run when fonts and sizes match, otherwise build it now and save it for the next one
+	// (ImFileOpen() expects UTF-8 file names: the profile path may not be representable in the ANSI code page)
+	const std::u8string cache_path = GetFontCachePath().u8string();
+	const char* cache_filename = reinterpret_cast<const char*>(cache_path.c_str());
+	if (cache_path.empty())
+		io.Fonts->Build();
+	else if (!io.Fonts->LoadCache(cache_filename))
+	{
+		io.Fonts->Build();
+		io.Fonts->SaveCache(cache_filename);
+	}
 
 	ImGuiStyle& style = ImGui::GetStyle();
 	style.WindowRounding = 0.0; // Disable round window
@@ -43,6 +84,8 @@ void OverlayBase::OverlayProc()
 
 	ImGuiIO& io = ImGui::GetIO();
 
+	if (FontSdfSize > 0.0f)
+		FontHUD->Scale = std::round(io.DisplaySize.y / 60) / FontSdfSize;
 	ImGui::PushFont(FontHUD);
 	DrawHUD();
 	ImGui::PopFont();
@@ -51,6 +94,8 @@ void OverlayBase::OverlayProc()
 	{
 		io.ConfigFlags &= ~ImGuiConfigFlags_NoMouseCursorChange;
 
+		if (FontSdfSize > 0.0f)
+			FontDefault->Scale = std::round(io.DisplaySize.y / 68) / FontSdfSize;
 		ImGui::PushFont(FontDefault);
 		DrawOverlay();
 		ImGui::PopFont();
@@ -33,4 +33,5 @@ protected:
 	bool bShowOverlay;
 	ImFont* FontDefault;
 	ImFont* FontHUD;
+	float FontSdfSize = 0.0f; // Size of the distance field font shared by FontDefault and FontHUD, 0 when they are separate fonts
 };
\ No newline at end of file
@@ -0,0 +1,82 @@
+// Batched ImDrawList primitives (AddRectsFilled(), AddLines(), AddTexts()) vs one AddRectFilled()/AddLine()/AddText() call per element,
+// 10,000 elements per frame. Lines are measured in each stroke path. Output parity is checked by test_draw_batched.
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+
+static const int COUNT = 10000;
+static const char* const g_Labels[] = { "OK", "Cancel", "Frame time: 16.67 ms", "Player position: 1024.5, -37.25, 880.0" };
+
+static void ResetDrawList(ImDrawList* draw_list, ImDrawListFlags flags)
+{
+    draw_list->_ResetForNewFrame();
+    draw_list->PushClipRectFullScreen();
+    draw_list->PushTextureID(ImGui::GetIO().Fonts->TexID);
+    draw_list->Flags = flags | ImDrawListFlags_AllowVtxOffset;
+}
+
+static void PrintRow(const char* name, double t_single, double t_batched)
+{
+    printf("%-28s %12.3f %12.3f %7.2fx\n", name, t_single * 1e3, t_batched * 1e3, t_single / t_batched);
+}
+
+int main()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    unsigned char* pixels = NULL;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    ImDrawListSharedData* shared_data = ImGui::GetDrawListSharedData();
+    shared_data->TexUvWhitePixel = io.Fonts->TexUvWhitePixel;
+    shared_data->TexUvLines = io.Fonts->TexUvLines;
+    shared_data->ClipRectFullscreen = ImVec4(0.0f, 0.0f, 1920.0f, 1080.0f); // Set by NewFrame() otherwise: everything would be clipped
+    ImFont* font = io.Fonts->Fonts[0];
+
+    BenchRng rng;
+    ImVector<ImVec2> a, b;
+    ImVector<ImU32> cols;
+    ImVector<const char*> texts;
+    a.resize(COUNT); b.resize(COUNT); cols.resize(COUNT); texts.resize(COUNT);
+    for (int n = 0; n < COUNT; n++)
+    {
+        a[n] = ImVec2(rng.Float(0.0f, 1900.0f), rng.Float(0.0f, 1060.0f));
+        b[n] = a[n] + ImVec2(rng.Float(-20.0f, 20.0f), rng.Float(-20.0f, 20.0f));
+        cols[n] = rng.Next() | IM_COL32_A_MASK;
+        texts[n] = g_Labels[rng.Int(0, IM_ARRAYSIZE(g_Labels) - 1)];
+    }
+
+    ImDrawList draw_list(shared_data);
+    const int runs = BenchGetRuns(20);
+    printf("%d elements per call, best of %d runs\n", COUNT, runs);
+    printf("%-28s %12s %12s %8s\n", "", "single (ms)", "batched (ms)", "speedup");
+
+    double t_single = BenchBestOf(runs, [&]() { ResetDrawList(&draw_list, ImDrawListFlags_None); for (int n = 0; n < COUNT; n++) draw_list.AddRectFilled(a[n], b[n], cols[n]); BenchKeep(draw_list.VtxBuffer.Size); });
+    double t_batched = BenchBestOf(runs, [&]() { ResetDrawList(&draw_list, ImDrawListFlags_None); draw_list.AddRectsFilled(a.Data, b.Data, cols.Data, COUNT); BenchKeep(draw_list.VtxBuffer.Size); });
+    PrintRow("AddRectsFilled()", t_single, t_batched);
+
+    struct LineCase { const char* Name; ImDrawListFlags Flags; float Thickness; };
+    const LineCase line_cases[] =
+    {
+        { "AddLines() AA tex, 1.0",     ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex, 1.0f },
+        { "AddLines() AA thin, 1.0",    ImDrawListFlags_AntiAliasedLines, 1.0f },
+        { "AddLines() AA thick, 2.5",   ImDrawListFlags_AntiAliasedLines, 2.5f },
+        { "AddLines() no AA, 1.0",      ImDrawListFlags_None, 1.0f },
+    };
+    for (const LineCase& c : line_cases)
+    {
+        t_single = BenchBestOf(runs, [&]() { ResetDrawList(&draw_list, c.Flags); for (int n = 0; n < COUNT; n++) draw_list.AddLine(a[n], b[n], cols[n], c.Thickness); BenchKeep(draw_list.VtxBuffer.Size); });
+        t_batched = BenchBestOf(runs, [&]() { ResetDrawList(&draw_list, c.Flags); draw_list.AddLines(a.Data, b.Data, cols.Data, COUNT, c.Thickness); BenchKeep(draw_list.VtxBuffer.Size); });
+        PrintRow(c.Name, t_single, t_batched);
+    }
+
+    t_single = BenchBestOf(runs, [&]() { ResetDrawList(&draw_list, ImDrawListFlags_None); for (int n = 0; n < COUNT; n++) draw_list.AddText(font, font->FontSize, a[n], cols[n], texts[n]); BenchKeep(draw_list.VtxBuffer.Size); });
+    t_batched = BenchBestOf(runs, [&]() { ResetDrawList(&draw_list, ImDrawListFlags_None); draw_list.AddTexts(font, font->FontSize, a.Data, cols.Data, texts.Data, COUNT); BenchKeep(draw_list.VtxBuffer.Size); });
+    PrintRow("AddTexts()", t_single, t_batched);
+
+    ImGui::DestroyContext();
+    return 0;
+}
@@ -0,0 +1,86 @@
+// 16-bit vs 32-bit draw indices (ImDrawIdx) on a large frame: 25,000 anti-aliased lines in the background draw list (~200k vertices).
+// The same source is built twice: 'bench_draw_indices' with the default 16-bit indices (large lists are split with ImDrawCmd::VtxOffset),
+// 'bench_draw_indices_32' with config/draw_idx32.h.
+// Reports the number of draw commands, the size of the index data, and the best CPU time of building the frame (NewFrame() to Render())
+// and of ImGui_ImplOpenGL3_RenderDrawData() + glFinish() over BENCH_RUNS frames.
+
+#include "imgui.h"
+#include "impls/imgui_impl_opengl3.h"
+#include "common/bench.h"
+#include "common/gl_context.h"
+
+static const int LINES = 25000;
+
+static void BuildFrame()
+{
+    ImGui_ImplOpenGL3_NewFrame();
+    ImGui::NewFrame();
+    for (int n = 0; n < 4; n++)
+    {
+        char name[16];
+        snprintf(name, sizeof(name), "Window %d", n);
+        ImGui::SetNextWindowPos(ImVec2(20.0f + n * 150.0f, 20.0f + n * 100.0f));
+        ImGui::SetNextWindowSize(ImVec2(300.0f, 200.0f));
+        ImGui::Begin(name);
+        ImGui::Text("Some text in window %d", n);
+        ImGui::Button("Button");
+        ImGui::End();
+    }
+    ImDrawList* draw_list = ImGui::GetBackgroundDrawList();
+    for (int n = 0; n < LINES; n++)
+    {
+        const ImVec2 p((float)(n % 800), (float)((n * 7) % 600));
+        draw_list->AddLine(p, ImVec2(p.x + 4.0f, p.y + 4.0f), IM_COL32(n & 255, 80, 200, 255), 1.5f);
+    }
+    ImGui::Render();
+}
+
+int main()
+{
+    if (!BenchGL_CreateContext(4, 5, 800, 600))
+    {
+        printf("No OpenGL 4.5 context available, skipped.\n");
+        return BENCH_EXIT_SKIPPED;
+    }
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(800.0f, 600.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui_ImplOpenGL3_Init("#version 330 core");
+
+    // Warm up: first frames create windows and grow buffers
+    for (int n = 0; n < 3; n++)
+    {
+        BuildFrame();
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        glFinish();
+    }
+
+    double best_build = 1e30, best_render = 1e30;
+    for (int n = 0; n < BenchGetRuns(15); n++)
+    {
+        const double t0 = BenchGetTime();
+        BuildFrame();
+        const double t1 = BenchGetTime(), t2 = BenchGetWallTime();
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        glFinish();
+        const double t3 = BenchGetWallTime();
+        if (t1 - t0 < best_build)
+            best_build = t1 - t0;
+        if (t3 - t2 < best_render)
+            best_render = t3 - t2;
+    }
+
+    const ImDrawData* draw_data = ImGui::GetDrawData();
+    int cmd_count = 0;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+        cmd_count += draw_data->CmdLists[n]->CmdBuffer.Size;
+    printf("%d-bit indices: %d vertices, %d draw commands, %.2f MB of indices, build %.2f ms, render %.2f ms (wall, includes rasterization)\n",
+        (int)sizeof(ImDrawIdx) * 8, draw_data->TotalVtxCount, cmd_count, draw_data->TotalIdxCount * sizeof(ImDrawIdx) / (1024.0 * 1024.0), best_build * 1e3, best_render * 1e3);
+
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui::DestroyContext();
+    BenchGL_DestroyContext();
+    return 0;
+}
@@ -0,0 +1,98 @@
+// Startup cost of the font atlas: cold (Build() then SaveCache(), no cache yet) vs warm (LoadCache() of the file saved by the cold run).
+// 12 fonts at sizes 13 to 35. With IMGUI_BENCH_FONT: that font, glyphs 0x0020-0xFFFF, OversampleH = 3 (a large atlas, like a CJK or symbol font).
+// Without it: the embedded ProggyClean font and its default glyph ranges.
+// Wall clock time, the cache file being read from the page cache after the first run.
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+
+static const char*      CACHE_FILENAME = "bench_font_cache.tmp";
+static const ImWchar    g_Ranges[] = { 0x0020, 0xFFFF, 0 };
+static void*            g_FontData = NULL;
+static int              g_FontDataSize = 0;
+
+static void AddFonts(ImFontAtlas* atlas)
+{
+    for (int n = 0; n < 12; n++)
+    {
+        ImFontConfig cfg;
+        cfg.SizePixels = 13.0f + n * 2.0f;
+        if (g_FontData != NULL)
+        {
+            cfg.FontDataOwnedByAtlas = false;
+            cfg.OversampleH = 3;
+            atlas->AddFontFromMemoryTTF(g_FontData, g_FontDataSize, cfg.SizePixels, &cfg, g_Ranges);
+        }
+        else
+        {
+            atlas->AddFontDefault(&cfg);
+        }
+    }
+}
+
+template<typename FUNC>
+static double BestWallTime(int runs, FUNC func)
+{
+    double best = 1e30;
+    for (int n = 0; n < runs; n++)
+    {
+        const double t0 = BenchGetWallTime();
+        func();
+        const double t = BenchGetWallTime() - t0;
+        best = (t < best) ? t : best;
+    }
+    return best;
+}
+
+int main()
+{
+    const char* font_path = BenchGetFontPath();
+    if (font_path != NULL)
+    {
+        size_t size = 0;
+        g_FontData = ImFileLoadToMemory(font_path, "rb", &size);
+        g_FontDataSize = (int)size;
+        if (g_FontData == NULL)
+        {
+            fprintf(stderr, "Unable to load '%s'.\n", font_path);
+            return 1;
+        }
+    }
+
+    const int runs = BenchGetRuns(5);
+    int tex_width = 0, tex_height = 0, glyphs_count = 0;
+    bool loaded = true;
+    const double t_cold = BestWallTime(runs, [&]()
+    {
+        ImFontAtlas atlas;
+        AddFonts(&atlas);
+        atlas.Build();
+        atlas.SaveCache(CACHE_FILENAME);
+        tex_width = atlas.TexWidth;
+        tex_height = atlas.TexHeight;
+        glyphs_count = 0;
+        for (ImFont* font : atlas.Fonts)
+            glyphs_count += font->Glyphs.Size;
+    });
+    const double t_warm = BestWallTime(runs, [&]()
+    {
+        ImFontAtlas atlas;
+        AddFonts(&atlas);
+        loaded &= atlas.LoadCache(CACHE_FILENAME);
+    });
+
+    size_t cache_size = 0;
+    if (ImFileHandle f = ImFileOpen(CACHE_FILENAME, "rb"))
+    {
+        cache_size = (size_t)ImFileGetSize(f);
+        ImFileClose(f);
+    }
+    remove(CACHE_FILENAME);
+
+    printf("%s, 12 sizes: %d glyphs, %dx%d texture, %.1f MB cache, best of %d runs\n", font_path ? font_path : "ProggyClean (embedded)", glyphs_count, tex_width, tex_height, cache_size / (1024.0 * 1024.0), runs);
+    printf("cold, Build() + SaveCache(): %8.2f ms\n", t_cold * 1e3);
+    printf("warm, LoadCache():           %8.2f ms (%.1fx)%s\n", t_warm * 1e3, t_cold / t_warm, loaded ? "" : " LOAD FAILED");
+    IM_FREE(g_FontData);
+    return loaded ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+// Vertex/index upload cost of ImGui_ImplOpenGL3_RenderDrawData() (persistently mapped ring vs glBufferData() per draw list).
+// The same source is built twice: 'bench_gl_upload' uses the ring when the context supports it (GL 4.4+ or GL_ARB_buffer_storage),
+// 'bench_gl_upload_buffer_data' builds the backend with IMGUI_IMPL_OPENGL_DISABLE_BUFFER_STORAGE.
+// Reports the CPU time of the calling thread per RenderDrawData() + glFlush() call, best of BENCH_RUNS runs of 200 frames.
+// glFlush() stands for the flush done by SwapBuffers(): without it, the cost of the ring's fence (which flushes) would be compared against
+// the glBufferData() path deferring all of its work to the untimed glFinish() that drains the GPU between frames.
+
+#include "imgui.h"
+#include "impls/imgui_impl_opengl3.h"
+#include "common/bench.h"
+#include "common/gl_context.h"
+
+#ifndef BENCH_VARIANT
+#define BENCH_VARIANT "ring"
+#endif
+
+static const int    FRAMES = 200;
+static const int    DRAW_LISTS = 8;     // A few windows worth of draw lists, each uploaded separately by the glBufferData() path
+
+// Fill the draw lists with 'vtx_count' vertices of small filled rectangles (4 vertices, 6 indices each).
+static void BuildDrawData(ImDrawList** draw_lists, ImDrawData* draw_data, int vtx_count)
+{
+    const ImGuiIO& io = ImGui::GetIO();
+    int total_vtx = 0, total_idx = 0;
+    for (int n = 0; n < DRAW_LISTS; n++)
+    {
+        ImDrawList* draw_list = draw_lists[n];
+        draw_list->_ResetForNewFrame();
+        draw_list->PushClipRectFullScreen();
+        draw_list->PushTextureID(io.Fonts->TexID);
+        const int rect_count = vtx_count / 4 / DRAW_LISTS;
+        for (int i = 0; i < rect_count; i++)
+        {
+            const float x = (float)((i * 13) % 780), y = (float)((i * 7 + n * 50) % 580);
+            draw_list->AddRectFilled(ImVec2(x, y), ImVec2(x + 4.0f, y + 4.0f), IM_COL32(i & 255, 128, 255 - (i & 255), 255));
+        }
+        draw_list->PopTextureID();
+        draw_list->PopClipRect();
+        total_vtx += draw_list->VtxBuffer.Size;
+        total_idx += draw_list->IdxBuffer.Size;
+    }
+    draw_data->Valid = true;
+    draw_data->CmdLists = draw_lists;
+    draw_data->CmdListsCount = DRAW_LISTS;
+    draw_data->TotalVtxCount = total_vtx;
+    draw_data->TotalIdxCount = total_idx;
+    draw_data->DisplayPos = ImVec2(0.0f, 0.0f);
+    draw_data->DisplaySize = io.DisplaySize;
+    draw_data->FramebufferScale = ImVec2(1.0f, 1.0f);
+}
+
+int main(int argc, char** argv)
+{
+    const int gl_major = (argc > 1) ? atoi(argv[1]) : 4;
+    const int gl_minor = (argc > 2) ? atoi(argv[2]) : 5;
+    if (!BenchGL_CreateContext(gl_major, gl_minor, 800, 600))
+    {
+        printf("No OpenGL %d.%d context available, skipped.\n", gl_major, gl_minor);
+        return BENCH_EXIT_SKIPPED;
+    }
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(800.0f, 600.0f);
+    ImGui_ImplOpenGL3_Init("#version 330 core");
+    ImGui_ImplOpenGL3_NewFrame();
+
+    ImDrawList* draw_lists[DRAW_LISTS];
+    for (int n = 0; n < DRAW_LISTS; n++)
+        draw_lists[n] = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+
+    printf("OpenGL %s, %s path, %d draw lists, best of %d runs of %d frames\n", (const char*)glGetString(GL_VERSION), BENCH_VARIANT, DRAW_LISTS, BenchGetRuns(5), FRAMES);
+    printf("%10s  %12s  %14s\n", "vertices", "us/frame", "GL calls/frame");
+    const int vtx_counts[] = { 1000, 10000, 100000 };
+    for (int vtx_count : vtx_counts)
+    {
+        ImDrawData draw_data;
+        BuildDrawData(draw_lists, &draw_data, vtx_count);
+        double best = 1e30;
+        for (int run = 0; run < BenchGetRuns(5); run++)
+        {
+            double total = 0.0;
+            for (int frame = 0; frame < FRAMES; frame++)
+            {
+                glClear(GL_COLOR_BUFFER_BIT);
+                const double t0 = BenchGetTime();
+                ImGui_ImplOpenGL3_RenderDrawData(&draw_data);
+                glFlush();
+                total += BenchGetTime() - t0;
+                glFinish();
+            }
+            if (total < best)
+                best = total;
+        }
+        printf("%10d  %12.1f  %14d\n", draw_data.TotalVtxCount, best * 1e6 / FRAMES, ImGui_ImplOpenGL3_GetFrameGLCallCount());
+    }
+
+    for (int n = 0; n < DRAW_LISTS; n++)
+        IM_DELETE(draw_lists[n]);
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui::DestroyContext();
+    BenchGL_DestroyContext();
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Glyph index: memory and lookup time of the paged index vs the dense 1.84 index (reference/glyph_index_1_84.h).
+// Synthetic fonts, no rasterization:
+//   1k:   ASCII, Latin-1 and 800 icons at U+F000 (a UI font merged with an icon font)
+//   20k:  1k + 19,000 CJK ideographs at U+4E00
+//   100k: 20k + 80,000 glyphs from U+20000 (CJK extensions), only with IMGUI_USE_WCHAR32 (bench_glyph_index_wchar32)
+// Lookups are of random glyphs present in the font. Both indices are compared on every codepoint before timing.
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+#include "reference/glyph_index_1_84.h"
+
+static const int LOOKUPS_COUNT = 1 << 16;
+
+struct GlyphSet { const char* Name; unsigned int Ranges[4][2]; };
+
+static const GlyphSet g_GlyphSets[] =
+{
+    { "1k",   { { 0x0020, 0x007E }, { 0x00A0, 0x00FF }, { 0xF000, 0xF31F }, { 0, 0 } } },
+    { "20k",  { { 0x0020, 0x007E }, { 0x00A0, 0x00FF }, { 0xF000, 0xF31F }, { 0x4E00, 0x4E00 + 19000 - 1 } } },
+#ifdef IMGUI_USE_WCHAR32
+    { "100k", { { 0x0020, 0x00FF }, { 0xF000, 0xF31F }, { 0x4E00, 0x4E00 + 19000 - 1 }, { 0x20000, 0x20000 + 80000 - 1 } } },
+#endif
+};
+
+static ImFont* BuildFont(ImFontAtlas* atlas, const GlyphSet& set, ImVector<ImWchar>& codepoints)
+{
+    BenchRng rng;
+    ImFont* font = IM_NEW(ImFont)();
+    font->ContainerAtlas = atlas;
+    font->FontSize = 16.0f;
+    codepoints.resize(0);
+    for (const auto& range : set.Ranges)
+        for (unsigned int c = range[0]; c <= range[1] && range[1] != 0; c++)
+        {
+            const float advance_x = (float)rng.Int(4, 16);
+            font->AddGlyph(NULL, (ImWchar)c, 0.0f, 0.0f, advance_x, 16.0f, 0.0f, 0.0f, 0.01f, 0.01f, advance_x);
+            codepoints.push_back((ImWchar)c);
+        }
+    font->BuildLookupTable();
+    return font;
+}
+
+static int GetIndexBytes(const ImFont* font)
+{
+    return font->IndexAdvanceX.size_in_bytes() + font->IndexLookup.size_in_bytes() + font->IndexPages.size_in_bytes();
+}
+
+int main()
+{
+    ImFontAtlas atlas;
+    atlas.TexWidth = atlas.TexHeight = 4096; // Only read by ImFont::AddGlyph() for MetricsTotalSurface
+
+    const int runs = BenchGetRuns(15);
+    printf("sizeof(ImWchar) = %d, %d lookups of random present glyphs, best of %d runs\n", (int)sizeof(ImWchar), LOOKUPS_COUNT, runs);
+    printf("%-6s %7s %10s %10s %9s %9s %9s %9s %10s %10s\n", "", "glyphs", "bytes 1.84", "paged", "Find 1.84", "paged", "Adv 1.84", "paged", "Build 1.84", "paged");
+    int mismatches = 0;
+    for (const GlyphSet& set : g_GlyphSets)
+    {
+        ImVector<ImWchar> codepoints;
+        ImFont* font = BuildFont(&atlas, set, codepoints);
+        ReferenceGlyphIndex ref;
+        ReferenceBuildLookupTable(&ref, font);
+
+        // Parity, up to past the last page
+        const unsigned int c_end = ImMin((unsigned int)ref.IndexLookup.Size + IM_FONT_INDEX_PAGE_SIZE * 2, (unsigned int)IM_UNICODE_CODEPOINT_MAX + 1);
+        for (unsigned int c = 0; c < c_end; c++)
+            mismatches += (font->FindGlyph((ImWchar)c) != ReferenceFindGlyph(&ref, (ImWchar)c)) || (font->GetCharAdvance((ImWchar)c) != ref.GetCharAdvance((ImWchar)c));
+
+        BenchRng rng;
+        ImVector<ImWchar> lookups;
+        lookups.resize(LOOKUPS_COUNT);
+        for (ImWchar& c : lookups)
+            c = codepoints[rng.Int(0, codepoints.Size - 1)];
+
+        const double t_find_ref = BenchBestOf(runs, [&]() { float sum = 0.0f; for (ImWchar c : lookups) sum += ReferenceFindGlyph(&ref, c)->AdvanceX; BenchKeep(sum); });
+        const double t_find = BenchBestOf(runs, [&]() { float sum = 0.0f; for (ImWchar c : lookups) sum += font->FindGlyph(c)->AdvanceX; BenchKeep(sum); });
+        const double t_adv_ref = BenchBestOf(runs, [&]() { float sum = 0.0f; for (ImWchar c : lookups) sum += ref.GetCharAdvance(c); BenchKeep(sum); });
+        const double t_adv = BenchBestOf(runs, [&]() { float sum = 0.0f; for (ImWchar c : lookups) sum += font->GetCharAdvance(c); BenchKeep(sum); });
+        const double t_build_ref = BenchBestOf(runs, [&]() { ReferenceBuildLookupTable(&ref, font); });
+        const double t_build = BenchBestOf(runs, [&]() { font->BuildLookupTable(); });
+
+        const double ns = 1e9 / LOOKUPS_COUNT;
+        printf("%-6s %7d %10d %10d %6.2f ns %6.2f ns %6.2f ns %6.2f ns %7.3f ms %7.3f ms\n", set.Name, font->Glyphs.Size, ref.GetMemoryBytes(), GetIndexBytes(font),
+            t_find_ref * ns, t_find * ns, t_adv_ref * ns, t_adv * ns, t_build_ref * 1e3, t_build * 1e3);
+        IM_DELETE(font);
+    }
+    printf("FindGlyph(), GetCharAdvance(): %s\n", mismatches ? "DIFFERENT" : "identical");
+    return mismatches ? 1 : 0;
+}
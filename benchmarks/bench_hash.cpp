@@ -0,0 +1,78 @@
+// ID hashing: ImHashStr()/ImHashData() vs the 1.84 byte at a time CRC32 (reference/hash_1_84.h), in ns per call.
+// 30 typical widget labels (some with ## and ###), hashed zero-terminated (Button("label")) and with a known length (GetID(begin, end)),
+// and int and pointer keys as hashed by PushID(int) and PushID(const void*).
+// Each run is timed twice: chained through the seed like nested PushID() scopes (latency), and with a fixed seed (throughput).
+// bench_hash uses the default CRC32 backend, bench_hash_fast is built with IMGUI_USE_FAST_HASH.
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+#include "reference/hash_1_84.h"
+#include <string.h>
+
+#ifdef IMGUI_USE_FAST_HASH
+#define BENCH_VARIANT "fast hash"
+#else
+#define BENCH_VARIANT "CRC32"
+#endif
+
+static const int REPEAT = 1000;
+
+static const char* const g_Labels[] =
+{
+    "OK", "Cancel", "Apply", "Close", "File", "Edit", "View", "Options", "Help", "Settings",
+    "Enable feature", "Show demo window", "Player", "Inventory", "Teleport", "##hidden", "Name##input", "Delete##item",
+    "Speed multiplier", "Field of view", "Window title###MainWindow", "Frame time###FrameTime", "Color", "Position", "Velocity",
+    "Draw distance", "Overlay", "Hotkey##toggle", "Save", "Load",
+};
+
+int main()
+{
+    const int labels_count = IM_ARRAYSIZE(g_Labels);
+    size_t lengths[IM_ARRAYSIZE(g_Labels)];
+    size_t total_length = 0;
+    for (int n = 0; n < labels_count; n++)
+        total_length += (lengths[n] = strlen(g_Labels[n]));
+
+    BenchRng rng;
+    int ints[64];
+    void* ptrs[64];
+    for (int n = 0; n < 64; n++)
+    {
+        ints[n] = rng.Int(0, 1000);
+        ptrs[n] = (void*)(size_t)((((ImU64)rng.Next() << 32) | rng.Next()) & ~(ImU64)7);
+    }
+
+    const int runs = BenchGetRuns(15);
+    const ImU32 seed = 0x12345678;
+    const double calls_labels = (double)labels_count * REPEAT;
+    const double calls_keys = 64.0 * REPEAT;
+    printf("%d labels (average %.1f bytes), %d int and pointer keys, best of %d runs, ns per call\n", labels_count, (double)total_length / labels_count, 64, runs);
+    printf("%-12s %-28s %s\n", "", "chained", "independent");
+    printf("%-12s %8s %10s %8s %8s %10s %8s\n", "", "1.84", BENCH_VARIANT, "speedup", "1.84", BENCH_VARIANT, "speedup");
+
+    // Chained: each ID is the seed of the next one, like nested PushID() scopes, so that calls can't overlap (latency).
+    // Independent: same seed for all, so that the CPU can overlap consecutive calls (throughput).
+    auto print_row = [&](const char* name, double calls, auto hash_ref, auto hash_new)
+    {
+        const double t_ref_chained = BenchBestOf(runs, [&]() { ImGuiID h = seed; for (int r = 0; r < REPEAT; r++) h = hash_ref(h); BenchKeep(h); }) / calls;
+        const double t_new_chained = BenchBestOf(runs, [&]() { ImGuiID h = seed; for (int r = 0; r < REPEAT; r++) h = hash_new(h); BenchKeep(h); }) / calls;
+        const double t_ref = BenchBestOf(runs, [&]() { ImGuiID h = 0; for (int r = 0; r < REPEAT; r++) h += hash_ref(seed); BenchKeep(h); }) / calls;
+        const double t_new = BenchBestOf(runs, [&]() { ImGuiID h = 0; for (int r = 0; r < REPEAT; r++) h += hash_new(seed); BenchKeep(h); }) / calls;
+        printf("%-12s %8.1f %10.1f %7.2fx %8.1f %10.1f %7.2fx\n", name, t_ref_chained * 1e9, t_new_chained * 1e9, t_ref_chained / t_new_chained, t_ref * 1e9, t_new * 1e9, t_ref / t_new);
+    };
+    // Each call hashes all the labels or keys, chained from 'h'
+    print_row("label\\0", calls_labels,
+        [&](ImGuiID h) { for (int n = 0; n < labels_count; n++) h = ReferenceHashStr(g_Labels[n], 0, h); return h; },
+        [&](ImGuiID h) { for (int n = 0; n < labels_count; n++) h = ImHashStr(g_Labels[n], 0, h); return h; });
+    print_row("label+len", calls_labels,
+        [&](ImGuiID h) { for (int n = 0; n < labels_count; n++) h = ReferenceHashStr(g_Labels[n], lengths[n], h); return h; },
+        [&](ImGuiID h) { for (int n = 0; n < labels_count; n++) h = ImHashStr(g_Labels[n], lengths[n], h); return h; });
+    print_row("int", calls_keys,
+        [&](ImGuiID h) { for (int n = 0; n < 64; n++) h = ReferenceHashData(&ints[n], sizeof(int), h); return h; },
+        [&](ImGuiID h) { for (int n = 0; n < 64; n++) h = ImHashData(&ints[n], sizeof(int), h); return h; });
+    print_row("pointer", calls_keys,
+        [&](ImGuiID h) { for (int n = 0; n < 64; n++) h = ReferenceHashData(&ptrs[n], sizeof(void*), h); return h; },
+        [&](ImGuiID h) { for (int n = 0; n < 64; n++) h = ImHashData(&ptrs[n], sizeof(void*), h); return h; });
+    return 0;
+}
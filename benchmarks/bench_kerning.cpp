@@ -0,0 +1,171 @@
+// Cost of kerning in text measurement and rendering, and check that fonts without kerning pairs don't pay for it.
+// One frame worth of text: 300 short labels and 30 paragraphs of about 400 characters wrapped at 300 pixels.
+// "before" is the single loop version without kerning (reference/text_pre_kerning.h), "no kerning" the current code on the same font,
+// "kerning" the current code on the same font built with ImFontConfig::Kerning. The kerning column needs a TrueType font with a 'kern'
+// or GPOS table in IMGUI_BENCH_FONT (e.g. Lato), otherwise the embedded ProggyClean font is used and only the first two columns are measured.
+// The text layout cache is off: every call goes through the loops. Outputs of "before" and "no kerning" are compared before timing.
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+#include "reference/text_pre_kerning.h"
+#include <string.h>
+#include <string>
+
+static const int    LABELS_COUNT = 300;
+static const int    PARAGRAPHS_COUNT = 30;
+static const float  WRAP_WIDTH = 300.0f;
+
+static const char* const g_Words[] = { "Player", "position", "Velocity", "Tools", "Window", "AVATAR", "Yaw", "Fov", "ToWeR", "LATE", "Vault", "Toggle", "World", "Waypoint", "Teleport", "away", "from", "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "16.67", "ms", "(empty)", "Ready." };
+
+static std::string MakeText(BenchRng& rng, int min_length)
+{
+    std::string text;
+    while ((int)text.size() < min_length)
+    {
+        if (!text.empty())
+            text += ' ';
+        text += g_Words[rng.Int(0, IM_ARRAYSIZE(g_Words) - 1)];
+    }
+    return text;
+}
+
+static void ResetDrawList(ImDrawList* draw_list)
+{
+    draw_list->_ResetForNewFrame();
+    draw_list->PushClipRectFullScreen();
+    draw_list->PushTextureID(ImGui::GetIO().Fonts->TexID);
+    draw_list->Flags = ImDrawListFlags_AllowVtxOffset; // No ImDrawListFlags_TextLayoutCache
+}
+
+static bool SameDrawList(const ImDrawList* a, const ImDrawList* b)
+{
+    return a->VtxBuffer.Size == b->VtxBuffer.Size && a->IdxBuffer.Size == b->IdxBuffer.Size
+        && memcmp(a->VtxBuffer.Data, b->VtxBuffer.Data, (size_t)a->VtxBuffer.size_in_bytes()) == 0
+        && memcmp(a->IdxBuffer.Data, b->IdxBuffer.Data, (size_t)a->IdxBuffer.size_in_bytes()) == 0;
+}
+
+int main()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+
+    // Same font twice, without and with kerning
+    const char* font_path = BenchGetFontPath();
+    ImFont* font = NULL;
+    ImFont* font_kerning = NULL;
+    if (font_path != NULL)
+    {
+        ImFontConfig cfg;
+        font = io.Fonts->AddFontFromFileTTF(font_path, 16.0f, &cfg);
+        cfg.Kerning = true;
+        font_kerning = io.Fonts->AddFontFromFileTTF(font_path, 16.0f, &cfg);
+        if (font == NULL || font_kerning == NULL)
+        {
+            fprintf(stderr, "Unable to load '%s'.\n", font_path);
+            return 1;
+        }
+    }
+    else
+    {
+        font = io.Fonts->AddFontDefault();
+    }
+    unsigned char* pixels = NULL;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    ImDrawListSharedData* shared_data = ImGui::GetDrawListSharedData();
+    shared_data->TexUvWhitePixel = io.Fonts->TexUvWhitePixel;
+    shared_data->TexUvLines = io.Fonts->TexUvLines;
+    shared_data->ClipRectFullscreen = ImVec4(0.0f, 0.0f, 1920.0f, 1080.0f); // Set by NewFrame() otherwise: everything would be clipped
+    const ImVec4 clip_rect = shared_data->ClipRectFullscreen;
+
+    BenchRng rng;
+    std::string labels[LABELS_COUNT], paragraphs[PARAGRAPHS_COUNT];
+    ImVec2 positions[LABELS_COUNT];
+    for (int n = 0; n < LABELS_COUNT; n++)
+    {
+        labels[n] = MakeText(rng, rng.Int(4, 24));
+        positions[n] = ImVec2(rng.Float(0.0f, 1700.0f), rng.Float(0.0f, 1060.0f));
+    }
+    for (int n = 0; n < PARAGRAPHS_COUNT; n++)
+        paragraphs[n] = MakeText(rng, 400);
+
+    // Measurement of one frame of text with each implementation
+    auto calc_labels = [&](const ImFont* f, bool reference)
+    {
+        float w = 0.0f;
+        for (const std::string& label : labels)
+            w += reference ? ReferenceCalcTextSizeA(f, f->FontSize, FLT_MAX, 0.0f, label.c_str(), label.c_str() + label.size()).x : f->CalcTextSizeA(f->FontSize, FLT_MAX, 0.0f, label.c_str(), label.c_str() + label.size()).x;
+        return w;
+    };
+    auto calc_wrapped = [&](const ImFont* f, bool reference)
+    {
+        float h = 0.0f;
+        for (const std::string& paragraph : paragraphs)
+            h += reference ? ReferenceCalcTextSizeA(f, f->FontSize, FLT_MAX, WRAP_WIDTH, paragraph.c_str(), paragraph.c_str() + paragraph.size()).y : f->CalcTextSizeA(f->FontSize, FLT_MAX, WRAP_WIDTH, paragraph.c_str(), paragraph.c_str() + paragraph.size()).y;
+        return h;
+    };
+    auto render = [&](ImDrawList* draw_list, const ImFont* f, bool reference)
+    {
+        ResetDrawList(draw_list);
+        for (int n = 0; n < LABELS_COUNT; n++)
+        {
+            const char* text = labels[n].c_str();
+            if (reference)
+                ReferenceRenderText(f, draw_list, f->FontSize, positions[n], IM_COL32_WHITE, clip_rect, text, text + labels[n].size());
+            else
+                f->RenderText(draw_list, f->FontSize, positions[n], IM_COL32_WHITE, clip_rect, text, text + labels[n].size());
+        }
+        for (int n = 0; n < PARAGRAPHS_COUNT; n++)
+        {
+            const char* text = paragraphs[n].c_str();
+            const ImVec2 pos((n % 5) * 320.0f, (n / 5) * 160.0f);
+            if (reference)
+                ReferenceRenderText(f, draw_list, f->FontSize, pos, IM_COL32_WHITE, clip_rect, text, text + paragraphs[n].size(), WRAP_WIDTH);
+            else
+                f->RenderText(draw_list, f->FontSize, pos, IM_COL32_WHITE, clip_rect, text, text + paragraphs[n].size(), WRAP_WIDTH);
+        }
+        return draw_list->VtxBuffer.Size;
+    };
+
+    // Parity of the single loop version and the no kerning instance
+    ImDrawList draw_list_ref(shared_data), draw_list(shared_data);
+    render(&draw_list_ref, font, true);
+    render(&draw_list, font, false);
+    const bool same = calc_labels(font, true) == calc_labels(font, false) && calc_wrapped(font, true) == calc_wrapped(font, false) && SameDrawList(&draw_list_ref, &draw_list);
+
+    const int runs = BenchGetRuns(200);
+    printf("%s, %d px: %d labels + %d paragraphs wrapped at %.0f px, best of %d runs\n", font_path ? font_path : "ProggyClean (embedded)", (int)font->FontSize, LABELS_COUNT, PARAGRAPHS_COUNT, WRAP_WIDTH, runs);
+    if (font_kerning != NULL)
+    {
+        int pairs_count = 0;
+        for (const ImFontKerningPair& pair : font_kerning->KerningPairs)
+            pairs_count += (pair.Left != 0);
+        printf("%d kerning pairs\n", pairs_count);
+    }
+    printf("%-24s %10s %12s %10s\n", "", "before", "no kerning", "kerning");
+    auto print_row = [&](const char* name, auto func)
+    {
+        // Variants are interleaved within each run, so that they see the same machine state
+        double t_before = 1e30, t_no_kerning = 1e30, t_kerning = 1e30;
+        for (int n = 0; n < runs; n++)
+        {
+            t_before = ImMin(t_before, BenchBestOf(1, [&]() { BenchKeep(func(font, true)); }));
+            t_no_kerning = ImMin(t_no_kerning, BenchBestOf(1, [&]() { BenchKeep(func(font, false)); }));
+            if (font_kerning != NULL)
+                t_kerning = ImMin(t_kerning, BenchBestOf(1, [&]() { BenchKeep(func(font_kerning, false)); }));
+        }
+        printf("%-24s %8.1f us %9.1f us", name, t_before * 1e6, t_no_kerning * 1e6);
+        if (font_kerning != NULL)
+            printf(" %7.1f us", t_kerning * 1e6);
+        printf("   no kerning / before: %.3f\n", t_no_kerning / t_before);
+    };
+    print_row("CalcTextSizeA() labels", calc_labels);
+    print_row("CalcTextSizeA() wrapped", calc_wrapped);
+    print_row("RenderText() all", [&](const ImFont* f, bool reference) { return render(reference ? &draw_list_ref : &draw_list, f, reference); });
+    printf("before / no kerning outputs: %s\n", same ? "identical" : "DIFFERENT");
+
+    ImGui::DestroyContext();
+    return same ? 0 : 1;
+}
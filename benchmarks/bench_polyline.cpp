@@ -0,0 +1,51 @@
+// Stroking a 100k segment polyline with ImDrawList::AddPolyline() (SSE kernels) vs the scalar 1.84 version (reference/polyline_1_84.h),
+// anti-aliased, at thicknesses 1 to 6. Thickness 1 and other integer thicknesses use the textured path, fractional ones the geometry paths.
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+#include "reference/polyline_1_84.h"
+
+static const int SEGMENTS = 100000;
+
+static void ResetDrawList(ImDrawList* draw_list)
+{
+    draw_list->_ResetForNewFrame();
+    draw_list->PushClipRectFullScreen();
+    draw_list->PushTextureID(ImGui::GetIO().Fonts->TexID);
+    draw_list->Flags = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex;
+}
+
+int main()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    unsigned char* pixels = NULL;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    ImGui::GetDrawListSharedData()->TexUvWhitePixel = io.Fonts->TexUvWhitePixel;
+    ImGui::GetDrawListSharedData()->TexUvLines = io.Fonts->TexUvLines;
+
+    BenchRng rng;
+    ImVector<ImVec2> points;
+    points.resize(SEGMENTS + 1);
+    for (int n = 0; n < points.Size; n++)
+        points[n] = ImVec2(rng.Float(0.0f, 1920.0f), rng.Float(0.0f, 1080.0f));
+
+    ImDrawList draw_list(ImGui::GetDrawListSharedData());
+    const int runs = BenchGetRuns(20);
+    printf("AddPolyline(), %d segments, anti-aliased, best of %d runs\n", SEGMENTS, runs);
+    printf("%-10s %12s %12s %8s\n", "thickness", "1.84 (ms)", "SSE (ms)", "speedup");
+    const float thicknesses[] = { 1.0f, 1.5f, 2.0f, 3.0f, 4.5f, 6.0f };
+    for (float thickness : thicknesses)
+    {
+        const double t_reference = BenchBestOf(runs, [&]() { ResetDrawList(&draw_list); ReferenceAddPolyline(&draw_list, points.Data, points.Size, IM_COL32_WHITE, ImDrawFlags_None, thickness); BenchKeep(draw_list.VtxBuffer.Size); });
+        const double t_sse = BenchBestOf(runs, [&]() { ResetDrawList(&draw_list); draw_list.AddPolyline(points.Data, points.Size, IM_COL32_WHITE, ImDrawFlags_None, thickness); BenchKeep(draw_list.VtxBuffer.Size); });
+        printf("%-10.1f %12.3f %12.3f %7.2fx\n", thickness, t_reference * 1e3, t_sse * 1e3, t_reference / t_sse);
+    }
+
+    ImGui::DestroyContext();
+    return 0;
+}
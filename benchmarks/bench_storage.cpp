@@ -0,0 +1,96 @@
+// ImGuiStorage: hash index vs the sorted 1.84 storage (reference/storage_1_84.h), on storages of N random 32-bit keys (IDs are hashes).
+// - insert: SetInt() of 1,000 new keys into the filled storage (the copy made before each run is not timed, and has room for the new keys)
+// - hit, miss: GetInt() of 65,536 random keys present, absent
+// - bytes: Data, plus Slots for the hash index
+// Times are in ns per operation. Both storages are compared on every key before timing.
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+#include "reference/storage_1_84.h"
+
+static const int INSERTS_COUNT = 1000;
+static const int LOOKUPS_COUNT = 1 << 16;
+
+// Best time of 'func' over 'runs' runs, calling the untimed 'setup' before each of them.
+template<typename SETUP, typename FUNC>
+static double BenchBestOfWithSetup(int runs, SETUP setup, FUNC func)
+{
+    double best = 1e30;
+    for (int n = 0; n < runs; n++)
+    {
+        setup();
+        const double t0 = BenchGetTime();
+        func();
+        best = ImMin(best, BenchGetTime() - t0);
+    }
+    return best;
+}
+
+int main()
+{
+    static const int sizes[] = { 8, 1000, 100000, 1000000 };
+    const int runs = BenchGetRuns(9);
+    printf("random 32-bit keys, best of %d runs, ns per operation\n", runs);
+    printf("%-9s %9s %9s %8s %8s %8s %8s %10s %10s\n", "N", "insert 1.84", "hash", "hit 1.84", "hash", "miss 1.84", "hash", "bytes 1.84", "hash");
+    int mismatches = 0;
+    for (int size : sizes)
+    {
+        // Distinct random keys: the first 'size' are present, the rest are absent or inserted
+        BenchRng rng;
+        ImGuiStorage seen;
+        ImVector<ImGuiID> keys;
+        while (keys.Size < size + INSERTS_COUNT + LOOKUPS_COUNT)
+        {
+            const ImGuiID key = rng.Next();
+            int* p = seen.GetIntRef(key, 0);
+            if (*p == 0)
+            {
+                *p = 1;
+                keys.push_back(key);
+            }
+        }
+        const ImGuiID* keys_present = keys.Data;
+        const ImGuiID* keys_inserted = keys.Data + size;
+        const ImGuiID* keys_absent = keys.Data + size + INSERTS_COUNT;
+
+        ImGuiStorage storage;
+        ReferenceStorage ref;
+        for (int n = 0; n < size; n++)
+        {
+            storage.SetInt(keys_present[n], n + 1);
+            ref.Data.push_back(ImGuiStorage::ImGuiStoragePair(keys_present[n], n + 1));
+        }
+        ReferenceStorageBuildSortByKey(&ref); // Sorted insertion of 1M keys would take minutes
+        for (int n = 0; n < size + INSERTS_COUNT + LOOKUPS_COUNT; n++)
+            mismatches += (storage.GetInt(keys[n]) != ReferenceStorageGetInt(&ref, keys[n]));
+
+        ImVector<ImGuiID> lookups_hit, lookups_miss;
+        lookups_hit.resize(LOOKUPS_COUNT);
+        lookups_miss.resize(LOOKUPS_COUNT);
+        for (int n = 0; n < LOOKUPS_COUNT; n++)
+        {
+            lookups_hit[n] = keys_present[rng.Int(0, size - 1)];
+            lookups_miss[n] = keys_absent[n];
+        }
+
+        // The 1.84 storage shifts its tail on every insertion: fewer runs at 1M keys, where one run takes about 0.5 s.
+        const int runs_insert = (size >= 1000000) ? ImMin(runs, 3) : runs;
+        ImGuiStorage storage_copy;
+        ReferenceStorage ref_copy;
+        const double t_insert_ref = BenchBestOfWithSetup(runs_insert, [&]() { ref_copy.Data = ref.Data; ref_copy.Data.reserve(size + INSERTS_COUNT); },
+            [&]() { for (int n = 0; n < INSERTS_COUNT; n++) ReferenceStorageSetInt(&ref_copy, keys_inserted[n], n); });
+        const double t_insert = BenchBestOfWithSetup(runs_insert, [&]() { storage_copy.Data = storage.Data; storage_copy.Slots = storage.Slots; storage_copy.SlotsCount = storage.SlotsCount; storage_copy.Data.reserve(size + INSERTS_COUNT); },
+            [&]() { for (int n = 0; n < INSERTS_COUNT; n++) storage_copy.SetInt(keys_inserted[n], n); });
+        const double t_hit_ref = BenchBestOf(runs, [&]() { int sum = 0; for (ImGuiID key : lookups_hit) sum += ReferenceStorageGetInt(&ref, key); BenchKeep(sum); });
+        const double t_hit = BenchBestOf(runs, [&]() { int sum = 0; for (ImGuiID key : lookups_hit) sum += storage.GetInt(key); BenchKeep(sum); });
+        const double t_miss_ref = BenchBestOf(runs, [&]() { int sum = 0; for (ImGuiID key : lookups_miss) sum += ReferenceStorageGetInt(&ref, key); BenchKeep(sum); });
+        const double t_miss = BenchBestOf(runs, [&]() { int sum = 0; for (ImGuiID key : lookups_miss) sum += storage.GetInt(key); BenchKeep(sum); });
+
+        printf("%-9d %11.1f %9.1f %8.1f %8.1f %9.1f %8.1f %10d %10d\n", size,
+            t_insert_ref * 1e9 / INSERTS_COUNT, t_insert * 1e9 / INSERTS_COUNT, t_hit_ref * 1e9 / LOOKUPS_COUNT, t_hit * 1e9 / LOOKUPS_COUNT,
+            t_miss_ref * 1e9 / LOOKUPS_COUNT, t_miss * 1e9 / LOOKUPS_COUNT, ref.GetMemoryBytes(), storage.Data.size_in_bytes() + storage.Slots.size_in_bytes());
+    }
+    printf("GetInt(): %s\n", mismatches ? "DIFFERENT" : "identical");
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,77 @@
+// ImGuiTextFilter::PassFilter() vs 1.84 (reference/text_filter_1_84.h) on 100,000 log lines of about 70 bytes, in ms per pass over all lines.
+// Filters from 1 to 12 terms: with IM_TEXT_FILTER_MATCHER_MIN_TERMS (8) terms or more the current code uses the automaton.
+// Both are checked to pass the same lines before timing.
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+#include "reference/text_filter_1_84.h"
+
+static const int LINES_COUNT = 100000;
+
+static const char* const g_Channels[] = { "render", "input", "net", "audio", "script", "physics" };
+static const char* const g_Messages[] =
+{
+    "texture atlas uploaded in %d.%02d ms (%d glyphs)",
+    "shader program %d linked, latency %d.%02d ms",
+    "frame %d: %d draw calls, %d vertices",
+    "ERROR: socket %d closed by peer after %d bytes (%d retries)",
+    "player moved to %d,%d,%d",
+    "warning: %d events dropped, queue full for %d ms",
+    "loaded script module_%d.lua (%d functions, %d KB)",
+};
+
+static const char* const g_Filters[] =
+{
+    "texture",
+    "shader,latency,-error",
+    "-frame",
+    "render,net,-warning,-socket",
+    "alpha,beta,gamma,delta,epsilon,zeta,eta,theta,iota,kappa,lambda,omicron",  // 12 terms, no match
+    "alpha,beta,gamma,delta,epsilon,zeta,eta,-theta,iota,kappa,lambda,texture", // 12 terms, last one matches often
+};
+
+int main()
+{
+    BenchRng rng;
+    ImGuiTextBuffer buf;
+    ImVector<int> line_offsets;
+    for (int n = 0; n < LINES_COUNT; n++)
+    {
+        line_offsets.push_back(buf.size());
+        buf.appendf("[%02d:%02d:%02d.%03d] [%s] ", rng.Int(0, 23), rng.Int(0, 59), rng.Int(0, 59), rng.Int(0, 999), g_Channels[rng.Int(0, IM_ARRAYSIZE(g_Channels) - 1)]);
+        buf.appendf(g_Messages[rng.Int(0, IM_ARRAYSIZE(g_Messages) - 1)], rng.Int(0, 99999), rng.Int(0, 99), rng.Int(0, 9999));
+        buf.append("\n");
+    }
+    line_offsets.push_back(buf.size());
+    const char* buf_begin = buf.begin();
+
+    const int runs = BenchGetRuns(9);
+    printf("%d lines, %.1f bytes per line, best of %d runs, sizeof(ImGuiTextFilter) = %d\n", LINES_COUNT, (double)buf.size() / LINES_COUNT, runs, (int)sizeof(ImGuiTextFilter));
+    printf("%-72s %6s %8s %8s %8s %8s\n", "filter", "passed", "1.84", "current", "speedup", "matcher");
+    int mismatches = 0;
+    for (const char* filter_text : g_Filters)
+    {
+        ImGuiTextFilter filter(filter_text);
+        int passed = 0;
+        for (int n = 0; n < LINES_COUNT; n++)
+        {
+            const char* line = buf_begin + line_offsets[n];
+            const char* line_end = buf_begin + line_offsets[n + 1] - 1;
+            const bool pass = filter.PassFilter(line, line_end);
+            mismatches += (pass != ReferencePassFilter(&filter, line, line_end));
+            passed += pass;
+        }
+        // Lines as in ImGuiTextFilter use of the demo log: ranges of the log buffer, one line after the other
+        const double t_ref = BenchBestOf(runs, [&]() { int count = 0; for (int n = 0; n < LINES_COUNT; n++) count += ReferencePassFilter(&filter, buf_begin + line_offsets[n], buf_begin + line_offsets[n + 1] - 1); BenchKeep(count); });
+        const double t_new = BenchBestOf(runs, [&]() { int count = 0; for (int n = 0; n < LINES_COUNT; n++) count += filter.PassFilter(buf_begin + line_offsets[n], buf_begin + line_offsets[n + 1] - 1); BenchKeep(count); });
+        char matcher_desc[32];
+        if (filter.MatcherClassCount > 0)
+            ImFormatString(matcher_desc, IM_ARRAYSIZE(matcher_desc), "%d B", filter.Matcher.Size);
+        else
+            ImFormatString(matcher_desc, IM_ARRAYSIZE(matcher_desc), "-");
+        printf("%-72s %6d %5.1f ms %5.1f ms %7.2fx %8s\n", filter_text, passed, t_ref * 1e3, t_new * 1e3, t_ref / t_new, matcher_desc);
+    }
+    printf("PassFilter(): %s\n", mismatches ? "DIFFERENT" : "identical");
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,99 @@
+// Throughput of UTF-8 decoding and text measurement, SSE2 ASCII fast paths vs the 1.84 scalar code (reference/text_1_84.h).
+// ImTextStrFromUtf8(), ImTextCountCharsFromUtf8() and ImFont::CalcTextSizeA() on three 1 MB corpora of 60 byte lines:
+// ASCII, Latin-1 (French, about 1 accented letter in 20) and CJK (Japanese, 3 bytes per character).
+// Outputs of both versions are compared on every corpus, and with max_width cut-offs, before timing.
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+#include "reference/text_1_84.h"
+#include <string>
+
+static const int CORPUS_SIZE = 1 << 20;
+
+static std::string MakeCorpus(const char* const* words, int words_count)
+{
+    BenchRng rng;
+    std::string corpus, line;
+    while ((int)corpus.size() < CORPUS_SIZE)
+    {
+        line.clear();
+        while (line.size() < 60)
+        {
+            line += words[rng.Int(0, words_count - 1)];
+            line += ' ';
+        }
+        line.back() = '\n';
+        corpus += line;
+    }
+    return corpus;
+}
+
+int main()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    const ImFont* font = io.Fonts->AddFontDefault();
+    io.Fonts->Build();
+
+    static const char* const ascii_words[] = { "Player", "position:", "1024.5,", "-37.25,", "health", "100/100", "Inventory", "(empty)", "Frame", "time:", "16.67", "ms", "the", "quick", "brown", "fox" };
+    static const char* const latin1_words[] = { "Le", "joueur", "est", "arrivé", "à", "la", "forêt", "près", "du", "château", "avec", "son", "épée", "et", "trois", "pièces", "d'or", "dans", "le", "sac", "de", "voyage" };
+    static const char* const cjk_words[] = { "プレイヤー", "の", "位置", "は", "森", "の", "近く", "です", "体力", "インベントリ", "空", "フレーム", "時間" };
+    struct Corpus { const char* Name; std::string Text; };
+    const Corpus corpora[] =
+    {
+        { "ASCII",   MakeCorpus(ascii_words, IM_ARRAYSIZE(ascii_words)) },
+        { "Latin-1", MakeCorpus(latin1_words, IM_ARRAYSIZE(latin1_words)) },
+        { "CJK",     MakeCorpus(cjk_words, IM_ARRAYSIZE(cjk_words)) },
+    };
+
+    ImVector<ImWchar> wbuf_new, wbuf_ref;
+    wbuf_new.resize(CORPUS_SIZE + 16);
+    wbuf_ref.resize(CORPUS_SIZE + 16);
+    const int runs = BenchGetRuns(15);
+    int mismatches = 0;
+    printf("1 MB corpora, throughput in MB/s, best of %d runs\n", runs);
+    printf("%-8s %-26s %10s %10s %8s\n", "", "", "1.84", "SSE2", "speedup");
+    for (const Corpus& corpus : corpora)
+    {
+        const char* text = corpus.Text.c_str();
+        const char* text_end = text + corpus.Text.size();
+        const double mb = corpus.Text.size() / (1024.0 * 1024.0);
+
+        // Parity
+        const int n_new = ImTextStrFromUtf8(wbuf_new.Data, wbuf_new.Size, text, text_end);
+        const int n_ref = ReferenceTextStrFromUtf8(wbuf_ref.Data, wbuf_ref.Size, text, text_end);
+        mismatches += (n_new != n_ref || memcmp(wbuf_new.Data, wbuf_ref.Data, (size_t)n_new * sizeof(ImWchar)) != 0);
+        mismatches += ImTextCountCharsFromUtf8(text, text_end) != ReferenceTextCountCharsFromUtf8(text, text_end);
+        const float max_widths[] = { FLT_MAX, 1000.0f, 37.0f };
+        for (float max_width : max_widths)
+        {
+            const char* remaining_new = NULL;
+            const char* remaining_ref = NULL;
+            const ImVec2 size_new = font->CalcTextSizeA(font->FontSize, max_width, 0.0f, text, text_end, &remaining_new);
+            const ImVec2 size_ref = ReferenceCalcTextSizeA(font, font->FontSize, max_width, 0.0f, text, text_end, &remaining_ref);
+            mismatches += (size_new.x != size_ref.x || size_new.y != size_ref.y || remaining_new != remaining_ref);
+        }
+
+        struct Row { const char* Name; double Ref, New; };
+        const Row rows[] =
+        {
+            { "ImTextStrFromUtf8()",
+                BenchBestOf(runs, [&]() { BenchKeep(ReferenceTextStrFromUtf8(wbuf_ref.Data, wbuf_ref.Size, text, text_end)); }),
+                BenchBestOf(runs, [&]() { BenchKeep(ImTextStrFromUtf8(wbuf_new.Data, wbuf_new.Size, text, text_end)); }) },
+            { "ImTextCountCharsFromUtf8()",
+                BenchBestOf(runs, [&]() { BenchKeep(ReferenceTextCountCharsFromUtf8(text, text_end)); }),
+                BenchBestOf(runs, [&]() { BenchKeep(ImTextCountCharsFromUtf8(text, text_end)); }) },
+            { "CalcTextSizeA()",
+                BenchBestOf(runs, [&]() { BenchKeep(ReferenceCalcTextSizeA(font, font->FontSize, FLT_MAX, 0.0f, text, text_end).x); }),
+                BenchBestOf(runs, [&]() { BenchKeep(font->CalcTextSizeA(font->FontSize, FLT_MAX, 0.0f, text, text_end).x); }) },
+        };
+        for (const Row& row : rows)
+            printf("%-8s %-26s %10.0f %10.0f %7.2fx\n", corpus.Name, row.Name, mb / row.Ref, mb / row.New, row.Ref / row.New);
+    }
+    printf("outputs: %s\n", mismatches ? "DIFFERENT" : "identical");
+
+    ImGui::DestroyContext();
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,91 @@
+// Helpers shared by the benchmarks and tests: timing, random numbers, test exit codes.
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <chrono>
+#if defined(__linux__) || defined(__APPLE__)
+#include <time.h>           // clock_gettime()
+#endif
+
+// Baselines in reference/ are compiled in the benchmark itself: keep them out of line like the library functions they are compared to,
+// otherwise they would be specialized for the constant arguments of the benchmark.
+// (noclone: GCC would otherwise still make specialized copies of a static function for constant arguments)
+#if defined(_MSC_VER)
+#define BENCH_NOINLINE      __declspec(noinline)
+#elif defined(__clang__)
+#define BENCH_NOINLINE      __attribute__((noinline))
+#else
+#define BENCH_NOINLINE      __attribute__((noinline, noclone))
+#endif
+
+// Exit code of a test which can't run on this machine (no GL context, no X server...). Registered as SKIP_RETURN_CODE in CMakeLists.txt.
+#define BENCH_EXIT_SKIPPED  77
+
+// CPU time of the calling thread in seconds, so that a noisy machine doesn't inflate the results. Falls back to wall clock time.
+static inline double BenchGetTime()
+{
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#else
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Wall clock time in seconds, for measurements which include waiting on the GPU or on I/O.
+static inline double BenchGetWallTime()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Run 'func' 'runs' times and return the best time in seconds. Best-of-N filters out preemption and cache warmup.
+template<typename FUNC>
+static double BenchBestOf(int runs, FUNC func)
+{
+    double best = 1e30;
+    for (int n = 0; n < runs; n++)
+    {
+        const double t0 = BenchGetTime();
+        func();
+        const double t = BenchGetTime() - t0;
+        if (t < best)
+            best = t;
+    }
+    return best;
+}
+
+// Number of runs for BenchBestOf(). Override with the BENCH_RUNS environment variable.
+static inline int BenchGetRuns(int default_runs)
+{
+    const char* env = getenv("BENCH_RUNS");
+    return (env && atoi(env) > 0) ? atoi(env) : default_runs;
+}
+
+// Keep the optimizer from discarding a result (scalars).
+template<typename T>
+static inline void BenchKeep(T value)
+{
+    static volatile T sink;
+    sink = value;
+}
+
+// Small deterministic random number generator (xorshift64*), so that every run and every variant sees the same inputs.
+struct BenchRng
+{
+    uint64_t State;
+    BenchRng(uint64_t seed = 0x9E3779B97F4A7C15ull) { State = seed ? seed : 1; }
+    uint32_t    Next()                      { State ^= State >> 12; State ^= State << 25; State ^= State >> 27; return (uint32_t)((State * 0x2545F4914F6CDD1Dull) >> 32); }
+    int         Int(int lo, int hi)         { return lo + (int)(Next() % (uint32_t)(hi - lo + 1)); }   // [lo, hi]
+    float       Float(float lo, float hi)   { return lo + (hi - lo) * (float)(Next() >> 8) * (1.0f / 16777216.0f); }
+};
+
+// Font used by the benchmarks that need a real TrueType font (kerning, large glyph ranges).
+// Set the IMGUI_BENCH_FONT environment variable to the path of a .ttf file. Returns NULL when not set.
+static inline const char* BenchGetFontPath()
+{
+    const char* path = getenv("IMGUI_BENCH_FONT");
+    return (path && path[0]) ? path : NULL;
+}
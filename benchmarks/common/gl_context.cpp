@@ -0,0 +1,94 @@
+#include "gl_context.h"
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <stdio.h>
+
+static EGLDisplay   g_Display = EGL_NO_DISPLAY;
+static EGLContext   g_Context = EGL_NO_CONTEXT;
+static GLuint       g_Framebuffer = 0, g_Renderbuffer = 0;
+
+static EGLContext BenchGL_CreateEGLContext(int major, int minor, EGLContext share_context)
+{
+    const EGLint attribs[] =
+    {
+        EGL_CONTEXT_MAJOR_VERSION, major,
+        EGL_CONTEXT_MINOR_VERSION, minor,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    return eglCreateContext(g_Display, EGL_NO_CONFIG_KHR, share_context, attribs);
+}
+
+bool BenchGL_CreateContext(int major, int minor, int width, int height)
+{
+    PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (get_platform_display == NULL)
+        return false;
+    g_Display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    EGLint egl_major = 0, egl_minor = 0;
+    if (g_Display == EGL_NO_DISPLAY || !eglInitialize(g_Display, &egl_major, &egl_minor) || !eglBindAPI(EGL_OPENGL_API))
+        return false;
+    g_Context = BenchGL_CreateEGLContext(major, minor, EGL_NO_CONTEXT);
+    if (g_Context == EGL_NO_CONTEXT || !eglMakeCurrent(g_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, g_Context))
+    {
+        fprintf(stderr, "Unable to create an OpenGL %d.%d core context.\n", major, minor);
+        return false;
+    }
+
+    // glewInit() also loads the EGL extensions, which may fail without a surface: only the GL entry points matter here.
+    glewExperimental = GL_TRUE;
+    glewInit();
+    if (glGenVertexArrays == NULL || glGenFramebuffers == NULL)
+        return false;
+
+    glGenFramebuffers(1, &g_Framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, g_Framebuffer);
+    glGenRenderbuffers(1, &g_Renderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, g_Renderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, g_Renderbuffer);
+    glViewport(0, 0, width, height);
+    return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+}
+
+void BenchGL_DestroyContext()
+{
+    if (g_Context != EGL_NO_CONTEXT)
+    {
+        eglMakeCurrent(g_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, g_Context);
+        if (g_Framebuffer)  { glDeleteFramebuffers(1, &g_Framebuffer); g_Framebuffer = 0; }
+        if (g_Renderbuffer) { glDeleteRenderbuffers(1, &g_Renderbuffer); g_Renderbuffer = 0; }
+        eglMakeCurrent(g_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(g_Display, g_Context);
+        g_Context = EGL_NO_CONTEXT;
+    }
+    if (g_Display != EGL_NO_DISPLAY)
+    {
+        eglTerminate(g_Display);
+        g_Display = EGL_NO_DISPLAY;
+    }
+}
+
+void* BenchGL_CreateSharedContext(int major, int minor)
+{
+    EGLContext context = BenchGL_CreateEGLContext(major, minor, g_Context);
+    return (context != EGL_NO_CONTEXT) ? (void*)context : NULL;
+}
+
+// Framebuffer objects aren't shared among contexts: the other contexts render to the default (null) framebuffer, which is enough for our tests.
+void BenchGL_MakeCurrent(void* context)
+{
+    eglMakeCurrent(g_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, context ? (EGLContext)context : g_Context);
+}
+
+void BenchGL_DestroySharedContext(void* context)
+{
+    if (eglGetCurrentContext() == (EGLContext)context)
+        BenchGL_MakeCurrent(NULL);
+    eglDestroyContext(g_Display, (EGLContext)context);
+}
+
+void* BenchGL_GetMainContext()
+{
+    return (void*)g_Context;
+}
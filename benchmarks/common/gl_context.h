@@ -0,0 +1,16 @@
+// Offscreen OpenGL context for the benchmarks and tests.
+// Uses EGL on the Mesa surfaceless platform, so no window or display server is needed (llvmpipe works).
+#pragma once
+
+#include <GL/glew.h>
+
+// Create a core profile context of the requested version, make it current, initialize GLEW, then create and bind a
+// 'width' x 'height' RGBA8 framebuffer. Returns false if EGL or the requested GL version isn't available.
+bool    BenchGL_CreateContext(int major, int minor, int width, int height);
+void    BenchGL_DestroyContext();
+
+// Create another context sharing objects with the first one, e.g. to test per-context state. Returns an opaque handle, NULL on failure.
+void*   BenchGL_CreateSharedContext(int major, int minor);
+void    BenchGL_MakeCurrent(void* context);     // NULL: back to the first context
+void    BenchGL_DestroySharedContext(void* context);
+void*   BenchGL_GetMainContext();
@@ -0,0 +1,4 @@
+// IMGUI_USER_CONFIG of the 32-bit index variants (imgui_idx32): same as uncommenting '#define ImDrawIdx unsigned int' in imconfig.h.
+#pragma once
+
+#define ImDrawIdx unsigned int
@@ -0,0 +1,5 @@
+// IMGUI_USER_CONFIG of the OpenGL3 backend built for test_vao_cache_unknown_context:
+// a platform where the current GL context can't be identified.
+#pragma once
+
+#define IMGUI_IMPL_OPENGL_GET_CURRENT_CONTEXT()     ((void*)NULL)
@@ -0,0 +1,51 @@
+// Glyph index as of Dear ImGui 1.84: IndexAdvanceX[] and IndexLookup[] sized densely up to the highest codepoint, before the paged index
+// of imgui_draw.cpp. Used as the baseline of bench_glyph_index. Built from the glyphs of an ImFont, after its own BuildLookupTable()
+// (the TAB glyph and FallbackGlyph are already set up), so that both indices return pointers into the same ImFont::Glyphs[].
+#pragma once
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+
+struct ReferenceGlyphIndex
+{
+    const ImFont*       Font;
+    ImVector<float>     IndexAdvanceX;
+    ImVector<ImWchar>   IndexLookup;
+
+    ReferenceGlyphIndex() { Font = NULL; }
+    float               GetCharAdvance(ImWchar c) const { return ((int)c < IndexAdvanceX.Size) ? IndexAdvanceX[(int)c] : Font->FallbackAdvanceX; }
+    int                 GetMemoryBytes() const          { return IndexAdvanceX.size_in_bytes() + IndexLookup.size_in_bytes(); }
+};
+
+static BENCH_NOINLINE void ReferenceBuildLookupTable(ReferenceGlyphIndex* index, const ImFont* font)
+{
+    int max_codepoint = 0;
+    for (int i = 0; i != font->Glyphs.Size; i++)
+        max_codepoint = ImMax(max_codepoint, (int)font->Glyphs[i].Codepoint);
+
+    index->Font = font;
+    index->IndexAdvanceX.clear();
+    index->IndexLookup.clear();
+    index->IndexAdvanceX.resize(max_codepoint + 1, -1.0f);
+    index->IndexLookup.resize(max_codepoint + 1, (ImWchar)-1);
+    for (int i = 0; i < font->Glyphs.Size; i++)
+    {
+        int codepoint = (int)font->Glyphs[i].Codepoint;
+        index->IndexAdvanceX[codepoint] = font->Glyphs[i].AdvanceX;
+        index->IndexLookup[codepoint] = (ImWchar)i;
+    }
+    for (int i = 0; i < max_codepoint + 1; i++)
+        if (index->IndexAdvanceX[i] < 0.0f)
+            index->IndexAdvanceX[i] = font->FallbackAdvanceX;
+}
+
+static BENCH_NOINLINE const ImFontGlyph* ReferenceFindGlyph(const ReferenceGlyphIndex* index, ImWchar c)
+{
+    if (c >= (size_t)index->IndexLookup.Size)
+        return index->Font->FallbackGlyph;
+    const ImWchar i = index->IndexLookup.Data[c];
+    if (i == (ImWchar)-1)
+        return index->Font->FallbackGlyph;
+    return &index->Font->Glyphs.Data[i];
+}
@@ -0,0 +1,281 @@
+// ImDrawList::AddPolyline() as of Dear ImGui 1.84 (scalar normals and miters), before the SSE kernels of imgui_draw.cpp.
+// Used as the baseline of test_polyline_parity and bench_polyline. Only the member accesses were rewritten to go through 'draw_list'.
+#pragma once
+
+#ifndef IMGUI_DEFINE_MATH_OPERATORS
+#define IMGUI_DEFINE_MATH_OPERATORS
+#endif
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+#if !defined(alloca)
+#if defined(__GLIBC__) || defined(__sun) || defined(__APPLE__) || defined(__NEWLIB__)
+#include <alloca.h>     // alloca
+#elif defined(_WIN32)
+#include <malloc.h>     // alloca
+#if !defined(alloca)
+#define alloca _alloca  // for clang with MS Codegen
+#endif
+#else
+#include <stdlib.h>     // alloca
+#endif
+#endif
+
+#define REF_NORMALIZE2F_OVER_ZERO(VX,VY)    do { float d2 = VX*VX + VY*VY; if (d2 > 0.0f) { float inv_len = ImRsqrt(d2); VX *= inv_len; VY *= inv_len; } } while (0)
+#define REF_FIXNORMAL2F_MAX_INVLEN2         100.0f
+#define REF_FIXNORMAL2F(VX,VY)              do { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > REF_FIXNORMAL2F_MAX_INVLEN2) inv_len2 = REF_FIXNORMAL2F_MAX_INVLEN2; VX *= inv_len2; VY *= inv_len2; } } while (0)
+
+static BENCH_NOINLINE void ReferenceAddPolyline(ImDrawList* draw_list, const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
+{
+    if (points_count < 2)
+        return;
+
+    const bool closed = (flags & ImDrawFlags_Closed) != 0;
+    const ImVec2 opaque_uv = draw_list->_Data->TexUvWhitePixel;
+    const int count = closed ? points_count : points_count - 1; // The number of line segments we need to draw
+    const bool thick_line = (thickness > draw_list->_FringeScale);
+
+    if (draw_list->Flags & ImDrawListFlags_AntiAliasedLines)
+    {
+        // Anti-aliased stroke
+        const float AA_SIZE = draw_list->_FringeScale;
+        const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+
+        // Thicknesses <1.0 should behave like thickness 1.0
+        thickness = ImMax(thickness, 1.0f);
+        const int integer_thickness = (int)thickness;
+        const float fractional_thickness = thickness - integer_thickness;
+
+        // Do we want to draw this line using a texture?
+        // - For now, only draw integer-width lines using textures to avoid issues with the way scaling occurs, could be improved.
+        // - If AA_SIZE is not 1.0f we cannot use the texture path.
+        const bool use_texture = (draw_list->Flags & ImDrawListFlags_AntiAliasedLinesUseTex) && (integer_thickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX) && (fractional_thickness <= 0.00001f) && (AA_SIZE == 1.0f);
+
+        // We should never hit this, because NewFrame() doesn't set ImDrawListFlags_AntiAliasedLinesUseTex unless ImFontAtlasFlags_NoBakedLines is off
+        IM_ASSERT_PARANOID(!use_texture || !(draw_list->_Data->Font->ContainerAtlas->Flags & ImFontAtlasFlags_NoBakedLines));
+
+        const int idx_count = use_texture ? (count * 6) : (thick_line ? count * 18 : count * 12);
+        const int vtx_count = use_texture ? (points_count * 2) : (thick_line ? points_count * 4 : points_count * 3);
+        draw_list->PrimReserve(idx_count, vtx_count);
+
+        // Temporary buffer
+        // The first <points_count> items are normals at each line point, then after that there are either 2 or 4 temp points for each line point
+        ImVec2* temp_normals = (ImVec2*)alloca(points_count * ((use_texture || !thick_line) ? 3 : 5) * sizeof(ImVec2)); //-V630
+        ImVec2* temp_points = temp_normals + points_count;
+
+        // Calculate normals (tangents) for each line segment
+        for (int i1 = 0; i1 < count; i1++)
+        {
+            const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
+            float dx = points[i2].x - points[i1].x;
+            float dy = points[i2].y - points[i1].y;
+            REF_NORMALIZE2F_OVER_ZERO(dx, dy);
+            temp_normals[i1].x = dy;
+            temp_normals[i1].y = -dx;
+        }
+        if (!closed)
+            temp_normals[points_count - 1] = temp_normals[points_count - 2];
+
+        // If we are drawing a one-pixel-wide line without a texture, or a textured line of any width, we only need 2 or 3 vertices per point
+        if (use_texture || !thick_line)
+        {
+            // [PATH 1] Texture-based lines (thick or non-thick)
+            // [PATH 2] Non texture-based lines (non-thick)
+
+            // The width of the geometry we need to draw - this is essentially <thickness> pixels for the line itself, plus "one pixel" for AA.
+            // - In the texture-based path, we don't use AA_SIZE here because the +1 is tied to the generated texture
+            //   (see ImFontAtlasBuildRenderLinesTexData() function), and so alternate values won't work without changes to that code.
+            // - In the non texture-based paths, we would allow AA_SIZE to potentially be != 1.0f with a patch (e.g. fringe_scale patch to
+            //   allow scaling geometry while preserving one-screen-pixel AA fringe).
+            const float half_draw_size = use_texture ? ((thickness * 0.5f) + 1) : AA_SIZE;
+
+            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
+            if (!closed)
+            {
+                temp_points[0] = points[0] + temp_normals[0] * half_draw_size;
+                temp_points[1] = points[0] - temp_normals[0] * half_draw_size;
+                temp_points[(points_count-1)*2+0] = points[points_count-1] + temp_normals[points_count-1] * half_draw_size;
+                temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * half_draw_size;
+            }
+
+            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
+            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
+            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+            unsigned int idx1 = draw_list->_VtxCurrentIdx; // Vertex index for start of line segment
+            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            {
+                const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
+                const unsigned int idx2 = ((i1 + 1) == points_count) ? draw_list->_VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
+
+                // Average normals
+                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
+                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
+                REF_FIXNORMAL2F(dm_x, dm_y);
+                dm_x *= half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
+                dm_y *= half_draw_size;
+
+                // Add temporary vertexes for the outer edges
+                ImVec2* out_vtx = &temp_points[i2 * 2];
+                out_vtx[0].x = points[i2].x + dm_x;
+                out_vtx[0].y = points[i2].y + dm_y;
+                out_vtx[1].x = points[i2].x - dm_x;
+                out_vtx[1].y = points[i2].y - dm_y;
+
+                if (use_texture)
+                {
+                    // Add indices for two triangles
+                    draw_list->_IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); draw_list->_IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); draw_list->_IdxWritePtr[2] = (ImDrawIdx)(idx1 + 1); // Right tri
+                    draw_list->_IdxWritePtr[3] = (ImDrawIdx)(idx2 + 1); draw_list->_IdxWritePtr[4] = (ImDrawIdx)(idx1 + 1); draw_list->_IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0); // Left tri
+                    draw_list->_IdxWritePtr += 6;
+                }
+                else
+                {
+                    // Add indexes for four triangles
+                    draw_list->_IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); draw_list->_IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); draw_list->_IdxWritePtr[2] = (ImDrawIdx)(idx1 + 2); // Right tri 1
+                    draw_list->_IdxWritePtr[3] = (ImDrawIdx)(idx1 + 2); draw_list->_IdxWritePtr[4] = (ImDrawIdx)(idx2 + 2); draw_list->_IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0); // Right tri 2
+                    draw_list->_IdxWritePtr[6] = (ImDrawIdx)(idx2 + 1); draw_list->_IdxWritePtr[7] = (ImDrawIdx)(idx1 + 1); draw_list->_IdxWritePtr[8] = (ImDrawIdx)(idx1 + 0); // Left tri 1
+                    draw_list->_IdxWritePtr[9] = (ImDrawIdx)(idx1 + 0); draw_list->_IdxWritePtr[10] = (ImDrawIdx)(idx2 + 0); draw_list->_IdxWritePtr[11] = (ImDrawIdx)(idx2 + 1); // Left tri 2
+                    draw_list->_IdxWritePtr += 12;
+                }
+
+                idx1 = idx2;
+            }
+
+            // Add vertexes for each point on the line
+            if (use_texture)
+            {
+                // If we're using textures we only need to emit the left/right edge vertices
+                ImVec4 tex_uvs = draw_list->_Data->TexUvLines[integer_thickness];
+                /*if (fractional_thickness != 0.0f) // Currently always zero when use_texture==false!
+                {
+                    const ImVec4 tex_uvs_1 = draw_list->_Data->TexUvLines[integer_thickness + 1];
+                    tex_uvs.x = tex_uvs.x + (tex_uvs_1.x - tex_uvs.x) * fractional_thickness; // inlined ImLerp()
+                    tex_uvs.y = tex_uvs.y + (tex_uvs_1.y - tex_uvs.y) * fractional_thickness;
+                    tex_uvs.z = tex_uvs.z + (tex_uvs_1.z - tex_uvs.z) * fractional_thickness;
+                    tex_uvs.w = tex_uvs.w + (tex_uvs_1.w - tex_uvs.w) * fractional_thickness;
+                }*/
+                ImVec2 tex_uv0(tex_uvs.x, tex_uvs.y);
+                ImVec2 tex_uv1(tex_uvs.z, tex_uvs.w);
+                for (int i = 0; i < points_count; i++)
+                {
+                    draw_list->_VtxWritePtr[0].pos = temp_points[i * 2 + 0]; draw_list->_VtxWritePtr[0].uv = tex_uv0; draw_list->_VtxWritePtr[0].col = col; // Left-side outer edge
+                    draw_list->_VtxWritePtr[1].pos = temp_points[i * 2 + 1]; draw_list->_VtxWritePtr[1].uv = tex_uv1; draw_list->_VtxWritePtr[1].col = col; // Right-side outer edge
+                    draw_list->_VtxWritePtr += 2;
+                }
+            }
+            else
+            {
+                // If we're not using a texture, we need the center vertex as well
+                for (int i = 0; i < points_count; i++)
+                {
+                    draw_list->_VtxWritePtr[0].pos = points[i];              draw_list->_VtxWritePtr[0].uv = opaque_uv; draw_list->_VtxWritePtr[0].col = col;       // Center of line
+                    draw_list->_VtxWritePtr[1].pos = temp_points[i * 2 + 0]; draw_list->_VtxWritePtr[1].uv = opaque_uv; draw_list->_VtxWritePtr[1].col = col_trans; // Left-side outer edge
+                    draw_list->_VtxWritePtr[2].pos = temp_points[i * 2 + 1]; draw_list->_VtxWritePtr[2].uv = opaque_uv; draw_list->_VtxWritePtr[2].col = col_trans; // Right-side outer edge
+                    draw_list->_VtxWritePtr += 3;
+                }
+            }
+        }
+        else
+        {
+            // [PATH 2] Non texture-based lines (thick): we need to draw the solid line core and thus require four vertices per point
+            const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
+
+            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
+            if (!closed)
+            {
+                const int points_last = points_count - 1;
+                temp_points[0] = points[0] + temp_normals[0] * (half_inner_thickness + AA_SIZE);
+                temp_points[1] = points[0] + temp_normals[0] * (half_inner_thickness);
+                temp_points[2] = points[0] - temp_normals[0] * (half_inner_thickness);
+                temp_points[3] = points[0] - temp_normals[0] * (half_inner_thickness + AA_SIZE);
+                temp_points[points_last * 4 + 0] = points[points_last] + temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
+                temp_points[points_last * 4 + 1] = points[points_last] + temp_normals[points_last] * (half_inner_thickness);
+                temp_points[points_last * 4 + 2] = points[points_last] - temp_normals[points_last] * (half_inner_thickness);
+                temp_points[points_last * 4 + 3] = points[points_last] - temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
+            }
+
+            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
+            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
+            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+            unsigned int idx1 = draw_list->_VtxCurrentIdx; // Vertex index for start of line segment
+            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            {
+                const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
+                const unsigned int idx2 = (i1 + 1) == points_count ? draw_list->_VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
+
+                // Average normals
+                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
+                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
+                REF_FIXNORMAL2F(dm_x, dm_y);
+                float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
+                float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
+                float dm_in_x = dm_x * half_inner_thickness;
+                float dm_in_y = dm_y * half_inner_thickness;
+
+                // Add temporary vertices
+                ImVec2* out_vtx = &temp_points[i2 * 4];
+                out_vtx[0].x = points[i2].x + dm_out_x;
+                out_vtx[0].y = points[i2].y + dm_out_y;
+                out_vtx[1].x = points[i2].x + dm_in_x;
+                out_vtx[1].y = points[i2].y + dm_in_y;
+                out_vtx[2].x = points[i2].x - dm_in_x;
+                out_vtx[2].y = points[i2].y - dm_in_y;
+                out_vtx[3].x = points[i2].x - dm_out_x;
+                out_vtx[3].y = points[i2].y - dm_out_y;
+
+                // Add indexes
+                draw_list->_IdxWritePtr[0]  = (ImDrawIdx)(idx2 + 1); draw_list->_IdxWritePtr[1]  = (ImDrawIdx)(idx1 + 1); draw_list->_IdxWritePtr[2]  = (ImDrawIdx)(idx1 + 2);
+                draw_list->_IdxWritePtr[3]  = (ImDrawIdx)(idx1 + 2); draw_list->_IdxWritePtr[4]  = (ImDrawIdx)(idx2 + 2); draw_list->_IdxWritePtr[5]  = (ImDrawIdx)(idx2 + 1);
+                draw_list->_IdxWritePtr[6]  = (ImDrawIdx)(idx2 + 1); draw_list->_IdxWritePtr[7]  = (ImDrawIdx)(idx1 + 1); draw_list->_IdxWritePtr[8]  = (ImDrawIdx)(idx1 + 0);
+                draw_list->_IdxWritePtr[9]  = (ImDrawIdx)(idx1 + 0); draw_list->_IdxWritePtr[10] = (ImDrawIdx)(idx2 + 0); draw_list->_IdxWritePtr[11] = (ImDrawIdx)(idx2 + 1);
+                draw_list->_IdxWritePtr[12] = (ImDrawIdx)(idx2 + 2); draw_list->_IdxWritePtr[13] = (ImDrawIdx)(idx1 + 2); draw_list->_IdxWritePtr[14] = (ImDrawIdx)(idx1 + 3);
+                draw_list->_IdxWritePtr[15] = (ImDrawIdx)(idx1 + 3); draw_list->_IdxWritePtr[16] = (ImDrawIdx)(idx2 + 3); draw_list->_IdxWritePtr[17] = (ImDrawIdx)(idx2 + 2);
+                draw_list->_IdxWritePtr += 18;
+
+                idx1 = idx2;
+            }
+
+            // Add vertices
+            for (int i = 0; i < points_count; i++)
+            {
+                draw_list->_VtxWritePtr[0].pos = temp_points[i * 4 + 0]; draw_list->_VtxWritePtr[0].uv = opaque_uv; draw_list->_VtxWritePtr[0].col = col_trans;
+                draw_list->_VtxWritePtr[1].pos = temp_points[i * 4 + 1]; draw_list->_VtxWritePtr[1].uv = opaque_uv; draw_list->_VtxWritePtr[1].col = col;
+                draw_list->_VtxWritePtr[2].pos = temp_points[i * 4 + 2]; draw_list->_VtxWritePtr[2].uv = opaque_uv; draw_list->_VtxWritePtr[2].col = col;
+                draw_list->_VtxWritePtr[3].pos = temp_points[i * 4 + 3]; draw_list->_VtxWritePtr[3].uv = opaque_uv; draw_list->_VtxWritePtr[3].col = col_trans;
+                draw_list->_VtxWritePtr += 4;
+            }
+        }
+        draw_list->_VtxCurrentIdx += (ImDrawIdx)vtx_count;
+    }
+    else
+    {
+        // [PATH 4] Non texture-based, Non anti-aliased lines
+        const int idx_count = count * 6;
+        const int vtx_count = count * 4;    // FIXME-OPT: Not sharing edges
+        draw_list->PrimReserve(idx_count, vtx_count);
+
+        for (int i1 = 0; i1 < count; i1++)
+        {
+            const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
+            const ImVec2& p1 = points[i1];
+            const ImVec2& p2 = points[i2];
+
+            float dx = p2.x - p1.x;
+            float dy = p2.y - p1.y;
+            REF_NORMALIZE2F_OVER_ZERO(dx, dy);
+            dx *= (thickness * 0.5f);
+            dy *= (thickness * 0.5f);
+
+            draw_list->_VtxWritePtr[0].pos.x = p1.x + dy; draw_list->_VtxWritePtr[0].pos.y = p1.y - dx; draw_list->_VtxWritePtr[0].uv = opaque_uv; draw_list->_VtxWritePtr[0].col = col;
+            draw_list->_VtxWritePtr[1].pos.x = p2.x + dy; draw_list->_VtxWritePtr[1].pos.y = p2.y - dx; draw_list->_VtxWritePtr[1].uv = opaque_uv; draw_list->_VtxWritePtr[1].col = col;
+            draw_list->_VtxWritePtr[2].pos.x = p2.x - dy; draw_list->_VtxWritePtr[2].pos.y = p2.y + dx; draw_list->_VtxWritePtr[2].uv = opaque_uv; draw_list->_VtxWritePtr[2].col = col;
+            draw_list->_VtxWritePtr[3].pos.x = p1.x - dy; draw_list->_VtxWritePtr[3].pos.y = p1.y + dx; draw_list->_VtxWritePtr[3].uv = opaque_uv; draw_list->_VtxWritePtr[3].col = col;
+            draw_list->_VtxWritePtr += 4;
+
+            draw_list->_IdxWritePtr[0] = (ImDrawIdx)(draw_list->_VtxCurrentIdx); draw_list->_IdxWritePtr[1] = (ImDrawIdx)(draw_list->_VtxCurrentIdx + 1); draw_list->_IdxWritePtr[2] = (ImDrawIdx)(draw_list->_VtxCurrentIdx + 2);
+            draw_list->_IdxWritePtr[3] = (ImDrawIdx)(draw_list->_VtxCurrentIdx); draw_list->_IdxWritePtr[4] = (ImDrawIdx)(draw_list->_VtxCurrentIdx + 2); draw_list->_IdxWritePtr[5] = (ImDrawIdx)(draw_list->_VtxCurrentIdx + 3);
+            draw_list->_IdxWritePtr += 6;
+            draw_list->_VtxCurrentIdx += 4;
+        }
+    }
+}
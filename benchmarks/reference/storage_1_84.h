@@ -0,0 +1,101 @@
+// ImGuiStorage as of Dear ImGui 1.84: pairs kept sorted by key, binary search on lookup, sorted insertion.
+// Used as the baseline of test_storage (same values for every key) and bench_storage. Only the int and void* accessors are kept.
+#pragma once
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+
+struct ReferenceStorage
+{
+    typedef ImGuiStorage::ImGuiStoragePair ImGuiStoragePair;
+    ImVector<ImGuiStoragePair>  Data;
+
+    void                        Clear()                     { Data.clear(); }
+    int                         GetMemoryBytes() const      { return Data.size_in_bytes(); }
+};
+
+// std::lower_bound but without the bullshit
+static ImGuiStorage::ImGuiStoragePair* ReferenceLowerBound(ImVector<ImGuiStorage::ImGuiStoragePair>& data, ImGuiID key)
+{
+    ImGuiStorage::ImGuiStoragePair* first = data.Data;
+    ImGuiStorage::ImGuiStoragePair* last = data.Data + data.Size;
+    size_t count = (size_t)(last - first);
+    while (count > 0)
+    {
+        size_t count2 = count >> 1;
+        ImGuiStorage::ImGuiStoragePair* mid = first + count2;
+        if (mid->key < key)
+        {
+            first = ++mid;
+            count -= count2 + 1;
+        }
+        else
+        {
+            count = count2;
+        }
+    }
+    return first;
+}
+
+static BENCH_NOINLINE void ReferenceStorageBuildSortByKey(ReferenceStorage* storage)
+{
+    struct StaticFunc
+    {
+        static int IMGUI_CDECL PairCompareByID(const void* lhs, const void* rhs)
+        {
+            // We can't just do a subtraction because qsort uses signed integers and subtracting our ID doesn't play well with that.
+            if (((const ImGuiStorage::ImGuiStoragePair*)lhs)->key > ((const ImGuiStorage::ImGuiStoragePair*)rhs)->key) return +1;
+            if (((const ImGuiStorage::ImGuiStoragePair*)lhs)->key < ((const ImGuiStorage::ImGuiStoragePair*)rhs)->key) return -1;
+            return 0;
+        }
+    };
+    if (storage->Data.Size > 1)
+        ImQsort(storage->Data.Data, (size_t)storage->Data.Size, sizeof(ImGuiStorage::ImGuiStoragePair), StaticFunc::PairCompareByID);
+}
+
+static BENCH_NOINLINE int ReferenceStorageGetInt(ReferenceStorage* storage, ImGuiID key, int default_val = 0)
+{
+    ImGuiStorage::ImGuiStoragePair* it = ReferenceLowerBound(storage->Data, key);
+    if (it == storage->Data.end() || it->key != key)
+        return default_val;
+    return it->val_i;
+}
+
+static BENCH_NOINLINE void* ReferenceStorageGetVoidPtr(ReferenceStorage* storage, ImGuiID key)
+{
+    ImGuiStorage::ImGuiStoragePair* it = ReferenceLowerBound(storage->Data, key);
+    if (it == storage->Data.end() || it->key != key)
+        return NULL;
+    return it->val_p;
+}
+
+static BENCH_NOINLINE int* ReferenceStorageGetIntRef(ReferenceStorage* storage, ImGuiID key, int default_val = 0)
+{
+    ImGuiStorage::ImGuiStoragePair* it = ReferenceLowerBound(storage->Data, key);
+    if (it == storage->Data.end() || it->key != key)
+        it = storage->Data.insert(it, ImGuiStorage::ImGuiStoragePair(key, default_val));
+    return &it->val_i;
+}
+
+static BENCH_NOINLINE void ReferenceStorageSetInt(ReferenceStorage* storage, ImGuiID key, int val)
+{
+    ImGuiStorage::ImGuiStoragePair* it = ReferenceLowerBound(storage->Data, key);
+    if (it == storage->Data.end() || it->key != key)
+    {
+        storage->Data.insert(it, ImGuiStorage::ImGuiStoragePair(key, val));
+        return;
+    }
+    it->val_i = val;
+}
+
+static BENCH_NOINLINE void ReferenceStorageSetVoidPtr(ReferenceStorage* storage, ImGuiID key, void* val)
+{
+    ImGuiStorage::ImGuiStoragePair* it = ReferenceLowerBound(storage->Data, key);
+    if (it == storage->Data.end() || it->key != key)
+    {
+        storage->Data.insert(it, ImGuiStorage::ImGuiStoragePair(key, val));
+        return;
+    }
+    it->val_p = val;
+}
@@ -0,0 +1,67 @@
+// ImStristr() and ImGuiTextFilter::PassFilter() as of Dear ImGui 1.84: toupper() on every byte, one term after the other.
+// Used as the baseline of test_text_filter and bench_text_filter. ImGuiTextFilter::Build() still splits and trims terms the same way,
+// so the reference reads Filters[] and CountGrep from a current ImGuiTextFilter.
+// Note: with a haystack_end, this ImStristr() compares the needle past haystack_end (until a mismatch), so it may match a needle which
+// overruns the range.
+#pragma once
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+#include <ctype.h>
+
+static BENCH_NOINLINE const char* ReferenceStristr(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end)
+{
+    if (!needle_end)
+        needle_end = needle + strlen(needle);
+
+    const char un0 = (char)toupper(*needle);
+    while ((!haystack_end && *haystack) || (haystack_end && haystack < haystack_end))
+    {
+        if (toupper(*haystack) == un0)
+        {
+            const char* b = needle + 1;
+            for (const char* a = haystack + 1; b < needle_end; a++, b++)
+                if (toupper(*a) != toupper(*b))
+                    break;
+            if (b == needle_end)
+                return haystack;
+        }
+        haystack++;
+    }
+    return NULL;
+}
+
+static BENCH_NOINLINE bool ReferencePassFilter(const ImGuiTextFilter* filter, const char* text, const char* text_end = NULL)
+{
+    if (filter->Filters.empty())
+        return true;
+
+    if (text == NULL)
+        text = "";
+
+    for (int i = 0; i != filter->Filters.Size; i++)
+    {
+        const ImGuiTextFilter::ImGuiTextRange& f = filter->Filters[i];
+        if (f.empty())
+            continue;
+        if (f.b[0] == '-')
+        {
+            // Subtract
+            if (ReferenceStristr(text, text_end, f.b + 1, f.e) != NULL)
+                return false;
+        }
+        else
+        {
+            // Grep
+            if (ReferenceStristr(text, text_end, f.b, f.e) != NULL)
+                return true;
+        }
+    }
+
+    // Implicit * grep
+    if (filter->CountGrep == 0)
+        return true;
+
+    return false;
+}
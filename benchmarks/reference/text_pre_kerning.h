@@ -0,0 +1,470 @@
+// ImFont::CalcWordWrapPositionA(), CalcTextSizeA() and RenderText() as they were before kerning, with a single loop and no template instances.
+// Used as the baseline of bench_kerning, to check that fonts without kerning pairs don't pay for them.
+// Later changes to these loops are applied so that only kerning differs: paged glyph index (GetCharAdvance(), GetIndexSlot()),
+// the 2 character minimum of the SSE2 ASCII run, and the colored glyph tracking of RenderText().
+// Two helpers of RenderText() are private to imgui_draw.cpp. ImFontRenderTextLayout() is replaced by its scalar path, and
+// ImFontAtlasBuildDynamicTouchGlyph() by a no-op: the benchmark uses neither the text layout cache nor dynamic glyphs, the loop keeps their tests.
+#pragma once
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+
+static BENCH_NOINLINE void ReferenceDynamicTouchGlyph(ImFontAtlasDynamicData*, const ImFontGlyph*)
+{
+}
+
+static BENCH_NOINLINE void ReferenceRenderTextLayout(ImDrawList* draw_list, const ImTextLayoutCacheEntry* layout, ImVec2 pos, ImU32 col)
+{
+    const int vtx_count = layout->Vertices.Size;
+    if (vtx_count == 0)
+        return;
+    draw_list->PrimReserve(vtx_count / 4 * 6, vtx_count);
+    const ImDrawVert* src = layout->Vertices.Data;
+    const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
+    for (int n = 0; n < vtx_count; n += 4)
+    {
+        for (int i = 0; i < 4; i++)
+            draw_list->PrimWriteVtx(ImVec2(src[n + i].pos.x + pos.x, src[n + i].pos.y + pos.y), src[n + i].uv, src[n + i].col ? col_untinted : col);
+        const ImDrawIdx idx = (ImDrawIdx)(draw_list->_VtxCurrentIdx - 4);
+        draw_list->PrimWriteIdx(idx); draw_list->PrimWriteIdx((ImDrawIdx)(idx + 1)); draw_list->PrimWriteIdx((ImDrawIdx)(idx + 2));
+        draw_list->PrimWriteIdx(idx); draw_list->PrimWriteIdx((ImDrawIdx)(idx + 2)); draw_list->PrimWriteIdx((ImDrawIdx)(idx + 3));
+    }
+}
+
+static BENCH_NOINLINE const char* ReferenceCalcWordWrapPositionA(const ImFont* font, float scale, const char* text, const char* text_end, float wrap_width)
+{
+    float line_width = 0.0f;
+    float word_width = 0.0f;
+    float blank_width = 0.0f;
+    wrap_width /= scale; // We work with unscaled widths to avoid scaling every characters
+
+    const char* word_end = text;
+    const char* prev_word_end = NULL;
+    bool inside_word = true;
+    const bool dynamic_glyphs = font->ContainerAtlas && font->ContainerAtlas->DynamicData;
+
+    const char* s = text;
+    while (s < text_end)
+    {
+        unsigned int c = (unsigned int)*s;
+        const char* next_s;
+        if (c < 0x80)
+            next_s = s + 1;
+        else
+            next_s = s + ImTextCharFromUtf8(&c, s, text_end);
+        if (c == 0)
+            break;
+
+        if (c < 32)
+        {
+            if (c == '\n')
+            {
+                line_width = word_width = blank_width = 0.0f;
+                inside_word = true;
+                s = next_s;
+                continue;
+            }
+            if (c == '\r')
+            {
+                s = next_s;
+                continue;
+            }
+        }
+
+        if (dynamic_glyphs && !font->FindGlyphNoFallback((ImWchar)c))
+            font->FindGlyph((ImWchar)c); // Rasterize now so that IndexAdvanceX[] holds its real advance
+        const float char_width = font->GetCharAdvance((ImWchar)c);
+        if (ImCharIsBlankW(c))
+        {
+            if (inside_word)
+            {
+                line_width += blank_width;
+                blank_width = 0.0f;
+                word_end = s;
+            }
+            blank_width += char_width;
+            inside_word = false;
+        }
+        else
+        {
+            word_width += char_width;
+            if (inside_word)
+            {
+                word_end = next_s;
+            }
+            else
+            {
+                prev_word_end = word_end;
+                line_width += word_width + blank_width;
+                word_width = blank_width = 0.0f;
+            }
+
+            // Allow wrapping after punctuation.
+            inside_word = (c != '.' && c != ',' && c != ';' && c != '!' && c != '?' && c != '\"');
+        }
+
+        // We ignore blank width at the end of the line (they can be skipped)
+        if (line_width + word_width > wrap_width)
+        {
+            // Words that cannot possibly fit within an entire line will be cut anywhere.
+            if (word_width < wrap_width)
+                s = prev_word_end ? prev_word_end : word_end;
+            break;
+        }
+
+        s = next_s;
+    }
+
+    return s;
+}
+
+static BENCH_NOINLINE ImVec2 ReferenceCalcTextSizeA(const ImFont* font, float size, float max_width, float wrap_width, const char* text_begin, const char* text_end = NULL, const char** remaining = NULL)
+{
+    if (!text_end)
+        text_end = text_begin + strlen(text_begin); // FIXME-OPT: Need to avoid this.
+
+    const float line_height = size;
+    const float scale = size / font->FontSize;
+
+    ImVec2 text_size = ImVec2(0, 0);
+    float line_width = 0.0f;
+
+    const bool word_wrap_enabled = (wrap_width > 0.0f);
+    const char* word_wrap_eol = NULL;
+    const bool dynamic_glyphs = font->ContainerAtlas && font->ContainerAtlas->DynamicData;
+    const bool ascii_fast_path = !word_wrap_enabled && !dynamic_glyphs && font->IndexAdvanceX.Size >= 0x80;
+
+    const char* s = text_begin;
+    while (s < text_end)
+    {
+        if (word_wrap_enabled)
+        {
+            // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
+            if (!word_wrap_eol)
+            {
+                word_wrap_eol = ReferenceCalcWordWrapPositionA(font, scale, s, text_end, wrap_width - line_width);
+                if (word_wrap_eol == s) // Wrap_width is too small to fit anything. Force displaying 1 character to minimize the height discontinuity.
+                    word_wrap_eol++;    // +1 may not be a character start point in UTF-8 but it's ok because we use s >= word_wrap_eol below
+            }
+
+            if (s >= word_wrap_eol)
+            {
+                if (text_size.x < line_width)
+                    text_size.x = line_width;
+                text_size.y += line_height;
+                line_width = 0.0f;
+                word_wrap_eol = NULL;
+
+                // Wrapping skips upcoming blanks
+                while (s < text_end)
+                {
+                    const char c = *s;
+                    if (ImCharIsBlankA(c)) { s++; } else if (c == '\n') { s++; break; } else { break; }
+                }
+                continue;
+            }
+        }
+
+#ifdef IMGUI_ENABLE_SSE
+        if (ascii_fast_path && s + 1 < text_end && (unsigned char)(s[0] - 0x20) < 0x60 && (unsigned char)(s[1] - 0x20) < 0x60)
+        {
+            while (s + 16 <= text_end)
+            {
+                const __m128i v = _mm_loadu_si128((const __m128i*)(const void*)s);
+                const int mask = _mm_movemask_epi8(_mm_cmplt_epi8(v, _mm_set1_epi8(0x20))); // Signed compare: bytes >= 0x80 are negative
+                const char* run_end = s + (mask ? ImCountTrailingZeros((unsigned int)mask) : 16);
+                for (; s < run_end; s++)
+                {
+                    const float char_width = font->IndexAdvanceX.Data[(unsigned char)*s] * scale;
+                    if (line_width + char_width >= max_width)
+                        break;
+                    line_width += char_width;
+                }
+                if (s != run_end || mask != 0)
+                    break;
+            }
+            if (s >= text_end)
+                break;
+        }
+#endif
+
+        // Decode and advance source
+        const char* prev_s = s;
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+        {
+            s += 1;
+        }
+        else
+        {
+            s += ImTextCharFromUtf8(&c, s, text_end);
+            if (c == 0) // Malformed UTF-8?
+                break;
+        }
+
+        if (c < 32)
+        {
+            if (c == '\n')
+            {
+                text_size.x = ImMax(text_size.x, line_width);
+                text_size.y += line_height;
+                line_width = 0.0f;
+                continue;
+            }
+            if (c == '\r')
+                continue;
+        }
+
+        if (dynamic_glyphs && !font->FindGlyphNoFallback((ImWchar)c))
+            font->FindGlyph((ImWchar)c); // Rasterize now so that IndexAdvanceX[] holds its real advance
+        const float char_width = font->GetCharAdvance((ImWchar)c) * scale;
+        if (line_width + char_width >= max_width)
+        {
+            s = prev_s;
+            break;
+        }
+
+        line_width += char_width;
+    }
+
+    if (text_size.x < line_width)
+        text_size.x = line_width;
+
+    if (line_width > 0 || text_size.y == 0.0f)
+        text_size.y += line_height;
+
+    if (remaining)
+        *remaining = s;
+
+    return text_size;
+}
+
+static BENCH_NOINLINE void ReferenceRenderText(const ImFont* font, ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width = 0.0f, bool cpu_fine_clip = false)
+{
+    if (!text_end)
+        text_end = text_begin + strlen(text_begin); // ImGui:: functions generally already provides a valid text_end, so this is merely to handle direct calls.
+
+    // Align to be pixel perfect
+    pos.x = IM_FLOOR(pos.x);
+    pos.y = IM_FLOOR(pos.y);
+    float x = pos.x;
+    float y = pos.y;
+    if (y > clip_rect.w)
+        return;
+
+    // Copy the glyph quads of a string drawn in a previous call when none of them can be clipped
+    ImTextLayoutCacheEntry* layout = NULL;
+    if ((draw_list->Flags & ImDrawListFlags_TextLayoutCache) && draw_list->_Data->TextLayoutCache)
+        layout = draw_list->_Data->TextLayoutCache->GetOrAdd(font, size, wrap_width, text_begin, text_end);
+    if (layout && layout->HasVertices)
+    {
+        const ImRect bb(layout->Bounds.Min.x + pos.x, layout->Bounds.Min.y + pos.y, layout->Bounds.Max.x + pos.x, layout->Bounds.Max.y + pos.y);
+        if (bb.Min.x >= clip_rect.x && bb.Min.y >= clip_rect.y && bb.Max.x <= clip_rect.z && bb.Max.y <= clip_rect.w)
+        {
+            ReferenceRenderTextLayout(draw_list, layout, pos, col);
+            return;
+        }
+    }
+
+    const float scale = size / font->FontSize;
+    const float line_height = font->FontSize * scale;
+    const bool word_wrap_enabled = (wrap_width > 0.0f);
+    const char* word_wrap_eol = NULL;
+
+    // Fast-forward to first visible line
+    const char* s = text_begin;
+    if (y + line_height < clip_rect.y && !word_wrap_enabled)
+        while (y + line_height < clip_rect.y && s < text_end)
+        {
+            s = (const char*)memchr(s, '\n', text_end - s);
+            s = s ? s + 1 : text_end;
+            y += line_height;
+        }
+
+    // For large text, scan for the last visible line in order to avoid over-reserving in the call to PrimReserve()
+    if (text_end - s > 10000 && !word_wrap_enabled)
+    {
+        const char* s_end = s;
+        float y_end = y;
+        while (y_end < clip_rect.w && s_end < text_end)
+        {
+            s_end = (const char*)memchr(s_end, '\n', text_end - s_end);
+            s_end = s_end ? s_end + 1 : text_end;
+            y_end += line_height;
+        }
+        text_end = s_end;
+    }
+    if (s == text_end)
+        return;
+
+    // Reserve vertices for remaining worse case (over-reserving is useful and easily amortized)
+    const int vtx_count_max = (int)(text_end - s) * 4;
+    const int idx_count_max = (int)(text_end - s) * 6;
+    const int idx_expected_size = draw_list->IdxBuffer.Size + idx_count_max;
+    draw_list->PrimReserve(idx_count_max, vtx_count_max);
+
+    ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+    const ImDrawVert* vtx_begin = vtx_write;
+    const char* s_begin = s;
+    bool clipped = false;
+    bool has_colored_glyphs = false;
+
+    const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
+    ImFontAtlasDynamicData* dynamic_data = font->ContainerAtlas ? font->ContainerAtlas->DynamicData : NULL;
+
+    while (s < text_end)
+    {
+        if (word_wrap_enabled)
+        {
+            // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
+            if (!word_wrap_eol)
+            {
+                word_wrap_eol = ReferenceCalcWordWrapPositionA(font, scale, s, text_end, wrap_width - (x - pos.x));
+                if (word_wrap_eol == s) // Wrap_width is too small to fit anything. Force displaying 1 character to minimize the height discontinuity.
+                    word_wrap_eol++;    // +1 may not be a character start point in UTF-8 but it's ok because we use s >= word_wrap_eol below
+            }
+
+            if (s >= word_wrap_eol)
+            {
+                x = pos.x;
+                y += line_height;
+                word_wrap_eol = NULL;
+
+                // Wrapping skips upcoming blanks
+                while (s < text_end)
+                {
+                    const char c = *s;
+                    if (ImCharIsBlankA(c)) { s++; } else if (c == '\n') { s++; break; } else { break; }
+                }
+                continue;
+            }
+        }
+
+        // Decode and advance source
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+        {
+            s += 1;
+        }
+        else
+        {
+            s += ImTextCharFromUtf8(&c, s, text_end);
+            if (c == 0) // Malformed UTF-8?
+                break;
+        }
+
+        if (c < 32)
+        {
+            if (c == '\n')
+            {
+                x = pos.x;
+                y += line_height;
+                if (y > clip_rect.w)
+                {
+                    clipped = true;
+                    break; // break out of main loop
+                }
+                continue;
+            }
+            if (c == '\r')
+                continue;
+        }
+
+        // Inlined FindGlyph() for glyphs already in the index
+        const int glyph_slot = font->GetIndexSlot(c);
+        const ImFontGlyph* glyph = (glyph_slot >= 0 && font->IndexLookup.Data[glyph_slot] != (ImWchar)-1) ? &font->Glyphs.Data[font->IndexLookup.Data[glyph_slot]] : font->FindGlyph((ImWchar)c);
+        if (glyph == NULL)
+            continue;
+        if (dynamic_data)
+            ReferenceDynamicTouchGlyph(dynamic_data, glyph);
+
+        float char_width = glyph->AdvanceX * scale;
+        if (glyph->Visible)
+        {
+            // We don't do a second finer clipping test on the Y axis as we've already skipped anything before clip_rect.y and exit once we pass clip_rect.w
+            float x1 = x + glyph->X0 * scale;
+            float x2 = x + glyph->X1 * scale;
+            float y1 = y + glyph->Y0 * scale;
+            float y2 = y + glyph->Y1 * scale;
+            if (x1 <= clip_rect.z && x2 >= clip_rect.x)
+            {
+                // Render a character
+                float u1 = glyph->U0;
+                float v1 = glyph->V0;
+                float u2 = glyph->U1;
+                float v2 = glyph->V1;
+
+                // CPU side clipping used to fit text in their frame when the frame is too small. Only does clipping for axis aligned quads.
+                if (cpu_fine_clip)
+                {
+                    if (x1 < clip_rect.x)
+                    {
+                        u1 = u1 + (1.0f - (x2 - clip_rect.x) / (x2 - x1)) * (u2 - u1);
+                        x1 = clip_rect.x;
+                    }
+                    if (y1 < clip_rect.y)
+                    {
+                        v1 = v1 + (1.0f - (y2 - clip_rect.y) / (y2 - y1)) * (v2 - v1);
+                        y1 = clip_rect.y;
+                    }
+                    if (x2 > clip_rect.z)
+                    {
+                        u2 = u1 + ((clip_rect.z - x1) / (x2 - x1)) * (u2 - u1);
+                        x2 = clip_rect.z;
+                    }
+                    if (y2 > clip_rect.w)
+                    {
+                        v2 = v1 + ((clip_rect.w - y1) / (y2 - y1)) * (v2 - v1);
+                        y2 = clip_rect.w;
+                    }
+                    if (y1 >= y2)
+                    {
+                        x += char_width;
+                        continue;
+                    }
+                }
+
+                // Support for untinted glyphs
+                ImU32 glyph_col = col;
+                if (glyph->Colored)
+                {
+                    glyph_col = col_untinted;
+                    has_colored_glyphs = true;
+                }
+
+                // We are NOT calling PrimRectUV() here because non-inlined causes too much overhead in a debug builds. Inlined here:
+                {
+                    idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
+                    idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
+                    vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
+                    vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
+                    vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = glyph_col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
+                    vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = glyph_col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+                    vtx_write += 4;
+                    vtx_current_idx += 4;
+                    idx_write += 6;
+                }
+            }
+            else
+            {
+                clipped = true;
+            }
+        }
+        x += char_width;
+    }
+
+    // Give back unused vertices (clipped ones, blanks) ~ this is essentially a PrimUnreserve() action.
+    draw_list->VtxBuffer.Size = (int)(vtx_write - draw_list->VtxBuffer.Data); // Same as calling shrink()
+    draw_list->IdxBuffer.Size = (int)(idx_write - draw_list->IdxBuffer.Data);
+    draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
+    draw_list->_VtxWritePtr = vtx_write;
+    draw_list->_IdxWritePtr = idx_write;
+    draw_list->_VtxCurrentIdx = vtx_current_idx;
+
+    // Store the quads for the next calls, provided that nothing was skipped or clipped
+    if (layout && !clipped && !cpu_fine_clip && s_begin == text_begin)
+        draw_list->_Data->TextLayoutCache->SetVertices(layout, vtx_begin, (int)(vtx_write - vtx_begin), pos, col, has_colored_glyphs);
+}
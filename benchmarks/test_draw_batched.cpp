@@ -0,0 +1,133 @@
+// Parity test of the batched ImDrawList primitives (AddRectsFilled(), AddLines(), AddTexts()) against one AddRectFilled()/AddLine()/AddText()
+// call per element. 10,000 random elements per case, 1 in 8 with a zero alpha color (skipped), with and without anti-aliasing, with and without
+// line textures, at several thicknesses and at fringe scale 1 and 2. Vertex buffers, index buffers and draw commands must be identical.
+// Each case is run with the 64K vertex limit of 16-bit indices crossed, so the batched versions must split commands with VtxOffset like the single ones.
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+#include <string.h>
+
+static const int    COUNT = 10000;
+static int          g_Failures = 0;
+
+struct Elements
+{
+    ImVector<ImVec2>        A, B;
+    ImVector<ImU32>         Cols;
+    ImVector<const char*>   Texts;
+};
+
+static const char* const g_Labels[] = { "", "OK", "Cancel", "Frame time: 16.67 ms", "Player position: 1024.5, -37.25, 880.0", "The quick brown fox jumps over the lazy dog" };
+
+static void GenerateElements(Elements& e)
+{
+    BenchRng rng;
+    e.A.resize(COUNT); e.B.resize(COUNT); e.Cols.resize(COUNT); e.Texts.resize(COUNT);
+    for (int n = 0; n < COUNT; n++)
+    {
+        e.A[n] = ImVec2(rng.Float(0.0f, 1900.0f), rng.Float(0.0f, 1060.0f));
+        e.B[n] = (n % 50 == 0) ? e.A[n] : e.A[n] + ImVec2(rng.Float(-20.0f, 20.0f), rng.Float(-20.0f, 20.0f)); // Some zero length lines
+        e.Cols[n] = (rng.Int(0, 7) == 0) ? IM_COL32(255, 255, 255, 0) : (rng.Next() | IM_COL32_A_MASK);
+        e.Texts[n] = g_Labels[rng.Int(0, IM_ARRAYSIZE(g_Labels) - 1)];
+    }
+}
+
+static void ResetDrawList(ImDrawList* draw_list, ImDrawListFlags flags, float fringe_scale)
+{
+    draw_list->_ResetForNewFrame();
+    draw_list->PushClipRectFullScreen();
+    draw_list->PushTextureID(ImGui::GetIO().Fonts->TexID);
+    draw_list->Flags = flags | ImDrawListFlags_AllowVtxOffset;
+    draw_list->_FringeScale = fringe_scale;
+}
+
+static bool SameOutput(ImDrawList* a, ImDrawList* b)
+{
+    a->_PopUnusedDrawCmd();
+    b->_PopUnusedDrawCmd();
+    if (a->VtxBuffer.Size != b->VtxBuffer.Size || a->IdxBuffer.Size != b->IdxBuffer.Size || a->CmdBuffer.Size != b->CmdBuffer.Size)
+        return false;
+    if (memcmp(a->VtxBuffer.Data, b->VtxBuffer.Data, (size_t)a->VtxBuffer.size_in_bytes()) != 0 || memcmp(a->IdxBuffer.Data, b->IdxBuffer.Data, (size_t)a->IdxBuffer.size_in_bytes()) != 0)
+        return false;
+    for (int n = 0; n < a->CmdBuffer.Size; n++)
+    {
+        const ImDrawCmd& ca = a->CmdBuffer[n];
+        const ImDrawCmd& cb = b->CmdBuffer[n];
+        if (ca.ElemCount != cb.ElemCount || ca.IdxOffset != cb.IdxOffset || ca.VtxOffset != cb.VtxOffset || ca.TextureId != cb.TextureId || memcmp(&ca.ClipRect, &cb.ClipRect, sizeof(ImVec4)) != 0)
+            return false;
+    }
+    return true;
+}
+
+static void Check(ImDrawList* single, ImDrawList* batched, const char* what)
+{
+    const bool ok = SameOutput(single, batched);
+    printf("%-4s %-52s %6d vertices, %d commands\n", ok ? "OK" : "FAIL", what, single->VtxBuffer.Size, single->CmdBuffer.Size);
+    if (!ok)
+        g_Failures++;
+}
+
+int main()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    unsigned char* pixels = NULL;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    ImDrawListSharedData* shared_data = ImGui::GetDrawListSharedData();
+    shared_data->TexUvWhitePixel = io.Fonts->TexUvWhitePixel;
+    shared_data->TexUvLines = io.Fonts->TexUvLines;
+    shared_data->ClipRectFullscreen = ImVec4(0.0f, 0.0f, 1920.0f, 1080.0f); // Set by NewFrame() otherwise: everything would be clipped
+    ImFont* font = io.Fonts->Fonts[0];
+
+    Elements e;
+    GenerateElements(e);
+    ImDrawList single(shared_data), batched(shared_data);
+    char what[64];
+
+    // Rectangles: 40k vertices, twice to cross the 64K vertex limit
+    ResetDrawList(&single, ImDrawListFlags_None, 1.0f);
+    ResetDrawList(&batched, ImDrawListFlags_None, 1.0f);
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int n = 0; n < COUNT; n++)
+            single.AddRectFilled(e.A[n], e.B[n], e.Cols[n]);
+        batched.AddRectsFilled(e.A.Data, e.B.Data, e.Cols.Data, COUNT);
+    }
+    Check(&single, &batched, "AddRectsFilled()");
+
+    // Lines, in each stroke path
+    const ImDrawListFlags line_flags[] = { ImDrawListFlags_None, ImDrawListFlags_AntiAliasedLines, ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex };
+    const float thicknesses[] = { 1.0f, 1.5f, 2.0f, 4.0f };
+    const float fringe_scales[] = { 1.0f, 2.0f };
+    for (ImDrawListFlags flags : line_flags)
+        for (float thickness : thicknesses)
+            for (float fringe_scale : fringe_scales)
+            {
+                ResetDrawList(&single, flags, fringe_scale);
+                ResetDrawList(&batched, flags, fringe_scale);
+                for (int pass = 0; pass < 2; pass++)
+                {
+                    for (int n = 0; n < COUNT; n++)
+                        single.AddLine(e.A[n], e.B[n], e.Cols[n], thickness);
+                    batched.AddLines(e.A.Data, e.B.Data, e.Cols.Data, COUNT, thickness);
+                }
+                snprintf(what, sizeof(what), "AddLines() %s%s, thickness %.1f, fringe %.0f", (flags & ImDrawListFlags_AntiAliasedLines) ? "AA" : "no AA",
+                    (flags & ImDrawListFlags_AntiAliasedLinesUseTex) ? " tex" : "", thickness, fringe_scale);
+                Check(&single, &batched, what);
+            }
+
+    // Texts
+    ResetDrawList(&single, ImDrawListFlags_None, 1.0f);
+    ResetDrawList(&batched, ImDrawListFlags_None, 1.0f);
+    for (int n = 0; n < COUNT; n++)
+        single.AddText(font, font->FontSize, e.A[n], e.Cols[n], e.Texts[n]);
+    batched.AddTexts(font, font->FontSize, e.A.Data, e.Cols.Data, e.Texts.Data, COUNT);
+    Check(&single, &batched, "AddTexts()");
+
+    ImGui::DestroyContext();
+    return g_Failures ? 1 : 0;
+}
@@ -0,0 +1,249 @@
+// ImFontAtlas::LoadCache()/SaveCache(): round trip, and rejection of crafted files.
+// Each crafted file is a valid cache with one value changed, then re-hashed (PayloadHash and PayloadSize updated), so that only the
+// checks on the contents can reject it. A rejected file must leave the atlas untouched: not built, no texture.
+// The file layout below mirrors the one documented above ImFontAtlasCacheHeader in imgui_draw.cpp.
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+struct CacheHeader
+{
+    char        Magic[8];
+    ImU32       Version;
+    ImU32       LayoutKey;
+    ImU32       ConfigKey;
+    ImU32       PayloadHash;
+    ImU64       PayloadSize;
+    int         TexWidth, TexHeight;
+    int         TexPackedSurface;
+    int         TexPixelsUseColors;
+    int         FontsCount;
+    int         GlyphsCount;
+    int         KerningPairsCount;
+    int         CustomRectsCount;
+    ImVec2      TexUvWhitePixel;
+    ImVec4      TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+};
+
+struct CacheFont
+{
+    float       FontSize;
+    float       Ascent, Descent;
+    int         GlyphsCount;
+    int         KerningPairsCount;
+    int         ConfigDataCount;
+    int         MetricsTotalSurface;
+    int         FallbackChar;
+    int         EllipsisChar;
+};
+
+// A cache file split in its sections, to be modified then written back
+struct CacheFile
+{
+    CacheHeader                     Header;
+    std::vector<CacheFont>          Fonts;
+    std::vector<ImFontGlyph>        Glyphs;
+    std::vector<ImFontKerningPair>  KerningPairs;
+    std::vector<ImU16>              CustomRects;    // X, Y
+    std::vector<unsigned char>      Pixels;
+};
+
+static const char*  CACHE_FILENAME = "test_font_cache.tmp";
+static const char*  CRAFTED_FILENAME = "test_font_cache_crafted.tmp";
+static int          g_Failures = 0;
+
+static void Check(bool ok, const char* what)
+{
+    printf("%-4s %s\n", ok ? "OK" : "FAIL", what);
+    if (!ok)
+        g_Failures++;
+}
+
+// Two fonts, so that per-font counts can be made to wrap around while their sum stays equal to the header totals
+static void AddFonts(ImFontAtlas* atlas)
+{
+    ImFontConfig cfg;
+    cfg.SizePixels = 13.0f;
+    atlas->AddFontDefault(&cfg);
+    cfg.SizePixels = 20.0f;
+    atlas->AddFontDefault(&cfg);
+}
+
+template<typename T>
+static void ReadSection(const unsigned char*& p, std::vector<T>& out, size_t count)
+{
+    out.resize(count);
+    memcpy(out.data(), p, count * sizeof(T));
+    p += count * sizeof(T);
+}
+
+static bool ReadCacheFile(const char* filename, CacheFile& out)
+{
+    size_t size = 0;
+    unsigned char* data = (unsigned char*)ImFileLoadToMemory(filename, "rb", &size);
+    if (data == NULL || size < sizeof(CacheHeader))
+        return false;
+    const unsigned char* p = data;
+    memcpy(&out.Header, p, sizeof(CacheHeader));
+    p += sizeof(CacheHeader);
+    const CacheHeader& h = out.Header;
+    ReadSection(p, out.Fonts, (size_t)h.FontsCount);
+    ReadSection(p, out.Glyphs, (size_t)h.GlyphsCount);
+    ReadSection(p, out.KerningPairs, (size_t)h.KerningPairsCount);
+    ReadSection(p, out.CustomRects, (size_t)h.CustomRectsCount * 2);
+    ReadSection(p, out.Pixels, (size_t)h.TexWidth * h.TexHeight);
+    const bool ok = (size_t)(p - data) == size;
+    IM_FREE(data);
+    return ok;
+}
+
+template<typename T>
+static void AppendSection(std::vector<unsigned char>& buf, const std::vector<T>& section)
+{
+    const unsigned char* p = (const unsigned char*)section.data();
+    buf.insert(buf.end(), p, p + section.size() * sizeof(T));
+}
+
+// Write the file back with the current section sizes, and a payload hash matching the modified contents
+static void WriteCacheFile(const char* filename, const CacheFile& file)
+{
+    std::vector<unsigned char> payload;
+    AppendSection(payload, file.Fonts);
+    AppendSection(payload, file.Glyphs);
+    AppendSection(payload, file.KerningPairs);
+    AppendSection(payload, file.CustomRects);
+    AppendSection(payload, file.Pixels);
+    CacheHeader header = file.Header;
+    header.PayloadSize = (ImU64)payload.size();
+    header.PayloadHash = ImHashData(payload.data(), payload.size());
+
+    FILE* f = fopen(filename, "wb");
+    fwrite(&header, sizeof(header), 1, f);
+    fwrite(payload.data(), 1, payload.size(), f);
+    fclose(f);
+}
+
+// Load a crafted file in a fresh atlas with the same fonts: it must be rejected and leave the atlas as it was
+static void CheckRejected(const CacheFile& file, const char* what)
+{
+    WriteCacheFile(CRAFTED_FILENAME, file);
+    ImFontAtlas atlas;
+    AddFonts(&atlas);
+    const bool loaded = atlas.LoadCache(CRAFTED_FILENAME);
+    Check(!loaded && !atlas.IsBuilt() && atlas.TexPixelsAlpha8 == NULL && atlas.Fonts[0]->Glyphs.Size == 0, what);
+}
+
+int main()
+{
+    // Round trip
+    ImFontAtlas built;
+    AddFonts(&built);
+    built.Build();
+    Check(built.SaveCache(CACHE_FILENAME), "SaveCache()");
+
+    ImFontAtlas loaded;
+    AddFonts(&loaded);
+    Check(loaded.LoadCache(CACHE_FILENAME), "LoadCache() of the saved file");
+    bool same = loaded.TexWidth == built.TexWidth && loaded.TexHeight == built.TexHeight && memcmp(loaded.TexPixelsAlpha8, built.TexPixelsAlpha8, (size_t)built.TexWidth * built.TexHeight) == 0;
+    for (int font_n = 0; font_n < built.Fonts.Size && same; font_n++)
+    {
+        const ImFont* a = built.Fonts[font_n];
+        const ImFont* b = loaded.Fonts[font_n];
+        same = a->Glyphs.Size == b->Glyphs.Size && memcmp(a->Glyphs.Data, b->Glyphs.Data, (size_t)a->Glyphs.size_in_bytes()) == 0 && a->FallbackChar == b->FallbackChar && a->FontSize == b->FontSize;
+    }
+    Check(same, "loaded atlas matches the built one (pixels, glyphs)");
+
+    CacheFile original;
+    if (!ReadCacheFile(CACHE_FILENAME, original) || original.Header.FontsCount != 2 || original.Header.KerningPairsCount != 0)
+    {
+        Check(false, "unexpected cache file layout");
+        return 1;
+    }
+    CacheFile file = original;
+    WriteCacheFile(CRAFTED_FILENAME, file);
+    {
+        ImFontAtlas atlas;
+        AddFonts(&atlas);
+        Check(atlas.LoadCache(CRAFTED_FILENAME), "LoadCache() of an unmodified file written back by the test");
+    }
+
+    // Counts
+    file = original;
+    file.Fonts[0].KerningPairsCount = INT_MIN;
+    file.Fonts[1].KerningPairsCount = INT_MIN; // Sum wraps around to 0 in 32-bit
+    CheckRejected(file, "rejected: negative KerningPairsCount (INT_MIN, power of two in two's complement)");
+    file = original;
+    file.Fonts[0].GlyphsCount = -5;
+    file.Fonts[1].GlyphsCount += original.Fonts[0].GlyphsCount + 5;
+    CheckRejected(file, "rejected: negative GlyphsCount, same total");
+    file = original;
+    file.Fonts[0].GlyphsCount = INT_MIN;
+    file.Fonts[1].GlyphsCount = INT_MIN + original.Header.GlyphsCount; // Sum wraps around to the header total in 32-bit
+    CheckRejected(file, "rejected: GlyphsCount INT_MIN, 32-bit sum equal to the total");
+    file = original;
+    file.Fonts[0].ConfigDataCount = 1000;
+    CheckRejected(file, "rejected: ConfigDataCount");
+    file = original;
+    file.Fonts[0].ConfigDataCount = 0;
+    CheckRejected(file, "rejected: ConfigDataCount 0");
+
+    // Characters
+    file = original;
+    file.Fonts[0].FallbackChar = 0x7FFFFFFF;
+    CheckRejected(file, "rejected: FallbackChar out of range");
+    file = original;
+    file.Fonts[1].EllipsisChar = -2;
+    CheckRejected(file, "rejected: EllipsisChar out of range");
+    file = original;
+    file.Glyphs[10].Codepoint = IM_UNICODE_CODEPOINT_MAX + 1;
+    CheckRejected(file, "rejected: glyph codepoint out of range");
+
+    // Texture coordinates
+    file = original;
+    file.Glyphs[3].U1 = 2.0f;
+    CheckRejected(file, "rejected: glyph U1 > 1");
+    file = original;
+    file.Glyphs[3].V0 = NAN;
+    CheckRejected(file, "rejected: glyph V0 NaN");
+    file = original;
+    file.Header.TexUvWhitePixel.x = -1.0f;
+    CheckRejected(file, "rejected: TexUvWhitePixel out of the texture");
+    file = original;
+    file.Header.TexUvLines[5].w = 1.5f;
+    CheckRejected(file, "rejected: TexUvLines out of the texture");
+
+    // Custom rectangles
+    file = original;
+    file.CustomRects[0] = (ImU16)(original.Header.TexWidth - 1);
+    CheckRejected(file, "rejected: custom rect X + Width > TexWidth");
+    file = original;
+    file.CustomRects[1] = (ImU16)0xFFFF;
+    CheckRejected(file, "rejected: custom rect Y + Height > TexHeight");
+
+    // Kerning table without an empty slot: lookups would never end
+    file = original;
+    file.Fonts[0].KerningPairsCount = 4;
+    file.Header.KerningPairsCount = 4;
+    for (int n = 0; n < 4; n++)
+    {
+        ImFontKerningPair pair = { (ImWchar)('A' + n), (ImWchar)'V', -1.0f };
+        file.KerningPairs.push_back(pair);
+    }
+    CheckRejected(file, "rejected: full kerning hash table");
+    file.KerningPairs[2].Left = 0;
+    WriteCacheFile(CRAFTED_FILENAME, file);
+    {
+        ImFontAtlas atlas;
+        AddFonts(&atlas);
+        Check(atlas.LoadCache(CRAFTED_FILENAME) && atlas.Fonts[0]->GetKerning('Z', 'V') == 0.0f, "accepted: kerning hash table with an empty slot, lookup of a missing pair ends");
+    }
+
+    remove(CACHE_FILENAME);
+    remove(CRAFTED_FILENAME);
+    return g_Failures ? 1 : 0;
+}
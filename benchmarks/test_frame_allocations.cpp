@@ -0,0 +1,150 @@
+// Allocations per frame: a static UI must not call MemAlloc() once warmed up, and io.MetricsFrameAllocations/MetricsFrameFrees must
+// match the calls seen by the allocator (ImGui::SetAllocatorFunctions()).
+// The UI covers the transient per-frame buffers: 21 windows (WindowsTempSortBuffer), child windows, tables with frozen rows, sorting
+// and nested tables (table temp data, ImDrawListSplitter channels), legacy Columns(), ChannelsSplit() and tree nodes.
+// Run with and without io.ConfigTextLayoutCache, with static text, then with a frame counter in every window and a window appearing
+// every 10 frames. Frames 0 to 199 are warmup, frames 200 to 999 must not allocate. (The counter reaches 3 digits at frame 100: the
+// recycled text layout cache entries grow their buffers once over the next frames.)
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+
+static const int WARMUP_FRAMES = 200;
+static const int FRAMES_COUNT = 1000;
+
+static int g_AllocCount = 0;
+static int g_FreeCount = 0;
+static void* CountingAlloc(size_t size, void*)  { g_AllocCount++; return malloc(size); }
+static void CountingFree(void* ptr, void*)      { g_FreeCount += (ptr != NULL); free(ptr); }
+
+static void ShowUI(int frame, bool dynamic)
+{
+    for (int n = 0; n < 20; n++)
+    {
+        char name[32];
+        ImFormatString(name, IM_ARRAYSIZE(name), "Window %d", n);
+        ImGui::SetNextWindowPos(ImVec2((float)(n * 30), (float)(n * 20)), ImGuiCond_Once);
+        ImGui::SetNextWindowSize(ImVec2(400, 300), ImGuiCond_Once);
+        ImGui::Begin(name);
+        ImGui::Text("Label %d", n);
+        if (dynamic)
+            ImGui::Text("Frame %d", frame);
+        ImGui::Button("OK");
+        ImGui::SameLine();
+        ImGui::Button("Cancel");
+        static float value = 0.5f;
+        ImGui::SliderFloat("Slider", &value, 0.0f, 1.0f);
+        if (ImGui::TreeNodeEx("Tree", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            ImGui::Text("Leaf");
+            ImGui::TreePop();
+        }
+        if (ImGui::BeginTable("Table", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_Sortable | ImGuiTableFlags_ScrollY, ImVec2(0, 120)))
+        {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("A");
+            ImGui::TableSetupColumn("B");
+            ImGui::TableSetupColumn("C");
+            ImGui::TableSetupColumn("D");
+            ImGui::TableHeadersRow();
+            for (int row = 0; row < 10; row++)
+            {
+                ImGui::TableNextRow();
+                for (int column = 0; column < 4; column++)
+                {
+                    ImGui::TableSetColumnIndex(column);
+                    ImGui::Text("%d,%d", row, column);
+                }
+            }
+            if (ImGui::BeginTable("Inner", 2))
+            {
+                ImGui::TableNextColumn();
+                ImGui::Text("a");
+                ImGui::TableNextColumn();
+                ImGui::Text("b");
+                ImGui::EndTable();
+            }
+            ImGui::EndTable();
+        }
+        ImGui::Columns(3);
+        ImGui::Text("1");
+        ImGui::NextColumn();
+        ImGui::Text("2");
+        ImGui::NextColumn();
+        ImGui::Text("3");
+        ImGui::Columns(1);
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        const ImVec2 p = ImGui::GetCursorScreenPos();
+        draw_list->ChannelsSplit(2);
+        draw_list->ChannelsSetCurrent(1);
+        draw_list->AddRect(p, ImVec2(p.x + 10, p.y + 10), IM_COL32_WHITE);
+        draw_list->ChannelsSetCurrent(0);
+        draw_list->AddRectFilled(p, ImVec2(p.x + 10, p.y + 10), IM_COL32(255, 0, 0, 255));
+        draw_list->ChannelsMerge();
+        ImGui::BeginChild("Child", ImVec2(0, 50), true);
+        ImGui::Text("Child");
+        ImGui::EndChild();
+        ImGui::End();
+    }
+    if (dynamic && (frame / 10) % 2)
+    {
+        ImGui::Begin("Blinking");
+        ImGui::Text("Visible every other 10 frames");
+        ImGui::End();
+    }
+}
+
+int main()
+{
+    ImGui::SetAllocatorFunctions(CountingAlloc, CountingFree, NULL);
+    int failures = 0;
+    printf("%-22s %14s %14s %12s\n", "", "warmup allocs", "steady allocs", "steady frees");
+    for (int mode = 0; mode < 4; mode++)
+    {
+        const bool dynamic = (mode & 1) != 0;
+        const bool layout_cache = (mode & 2) != 0;
+        ImGui::CreateContext();
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = NULL;
+        io.DisplaySize = ImVec2(1920, 1080);
+        io.DeltaTime = 1.0f / 60.0f;
+        io.ConfigTextLayoutCache = layout_cache;
+        unsigned char* pixels;
+        int width, height;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+        // The counters published by NewFrame() cover the previous frame, from the same point of NewFrame() to the next.
+        // Summed over the run, plus the calls of the current frame, they must match the allocator.
+        const int alloc_count_start = g_AllocCount, free_count_start = g_FreeCount;
+        int alloc_count_io = 0, free_count_io = 0;
+        int alloc_count_warmup = 0, alloc_count_steady = 0, free_count_steady = 0;
+        for (int frame = 0; frame < FRAMES_COUNT; frame++)
+        {
+            if (frame == WARMUP_FRAMES)
+            {
+                alloc_count_warmup = g_AllocCount - alloc_count_start;
+                alloc_count_steady = g_AllocCount;
+                free_count_steady = g_FreeCount;
+            }
+            ImGui::NewFrame();
+            if (frame > 0)
+            {
+                alloc_count_io += io.MetricsFrameAllocations;
+                free_count_io += io.MetricsFrameFrees;
+            }
+            ShowUI(frame, dynamic);
+            ImGui::Render();
+        }
+        alloc_count_steady = g_AllocCount - alloc_count_steady;
+        free_count_steady = g_FreeCount - free_count_steady;
+        const bool counters_match = (alloc_count_io + GImGui->FrameAllocCount == g_AllocCount - alloc_count_start) && (free_count_io + GImGui->FrameFreeCount == g_FreeCount - free_count_start);
+        const bool ok = counters_match && alloc_count_steady == 0 && free_count_steady == 0;
+        char name[64];
+        ImFormatString(name, IM_ARRAYSIZE(name), "%s, %s", dynamic ? "dynamic" : "static", layout_cache ? "layout cache" : "no cache");
+        printf("%-4s %-22s %14d %14d %12d%s\n", ok ? "OK" : "FAIL", name, alloc_count_warmup, alloc_count_steady, free_count_steady, counters_match ? "" : " (io.MetricsFrameAllocations/Frees mismatch)");
+        failures += !ok;
+        ImGui::DestroyContext();
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,58 @@
+// ImHashData()/ImHashStr(): IDs must stay those of 1.84 (reference/hash_1_84.h) with the default CRC32 backend, so that settings saved
+// in .ini files keep matching. 200,000 random strings of 0 to 40 bytes from an alphabet heavy in '#' (to exercise ###), random seeds,
+// known length and zero-terminated forms, plus int and pointer keys as hashed by PushID().
+// With IMGUI_USE_FAST_HASH (test_hash_fast) IDs differ by design: only the ### semantics and the agreement of both string forms are checked.
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+#include "reference/hash_1_84.h"
+
+static const int STRINGS_COUNT = 200000;
+
+int main()
+{
+    static const char alphabet[] = "###abcdefgh ABC012_-.";
+    BenchRng rng;
+    char buf[48];
+    int failures = 0;
+    for (int n = 0; n < STRINGS_COUNT; n++)
+    {
+        const int len = rng.Int(0, 40);
+        for (int i = 0; i < len; i++)
+            buf[i] = alphabet[rng.Int(0, IM_ARRAYSIZE(alphabet) - 2)];
+        buf[len] = 0;
+        const ImU32 seed = (n & 1) ? rng.Next() : 0;
+
+        const ImGuiID id_str = ImHashStr(buf, 0, seed);
+        const ImGuiID id_str_len = ImHashStr(buf, (size_t)len, seed);
+        const ImGuiID id_data = ImHashData(buf, (size_t)len, seed);
+#ifdef IMGUI_USE_FAST_HASH
+        // Hashing from the last ### is the same as hashing only that part
+        const char* last = buf;
+        for (const char* p = buf; p + 3 <= buf + len; p++)
+            if (p[0] == '#' && p[1] == '#' && p[2] == '#')
+                last = p;
+        failures += (id_str != id_str_len) || (id_str != ImHashData(last, (size_t)(buf + len - last), seed)) || (len == 0 && id_str != seed);
+        (void)id_data;
+#else
+        failures += (id_str != ReferenceHashStr(buf, 0, seed)) || (id_str_len != ReferenceHashStr(buf, (size_t)len, seed)) || (id_data != ReferenceHashData(buf, (size_t)len, seed));
+#endif
+    }
+    printf("%-4s %d strings, ImHashStr() zero-terminated and known length, ImHashData()\n", failures ? "FAIL" : "OK", STRINGS_COUNT);
+
+#ifndef IMGUI_USE_FAST_HASH
+    int key_failures = 0;
+    for (int n = 0; n < STRINGS_COUNT; n++)
+    {
+        const int key_int = (n < 1000) ? n : (int)rng.Next();
+        const void* key_ptr = (const void*)(size_t)((((ImU64)rng.Next() << 32) | rng.Next()) & ~(ImU64)7);
+        const ImU32 seed = rng.Next();
+        key_failures += (ImHashData(&key_int, sizeof(key_int), seed) != ReferenceHashData(&key_int, sizeof(key_int), seed));
+        key_failures += (ImHashData(&key_ptr, sizeof(key_ptr), seed) != ReferenceHashData(&key_ptr, sizeof(key_ptr), seed));
+    }
+    printf("%-4s %d int and pointer keys\n", key_failures ? "FAIL" : "OK", STRINGS_COUNT);
+    failures += key_failures;
+#endif
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,88 @@
+// Parity test of ImDrawList::AddPolyline() (SSE normal and miter kernels of imgui_draw.cpp) against the scalar 1.84 version (reference/polyline_1_84.h).
+// Random polylines, open and closed, in every stroke path: anti-aliased textured (thickness 1), anti-aliased thin and thick, and not anti-aliased,
+// at thicknesses 1, 1.5, 3 and 6, with some repeated (degenerate) points. The vertex and index buffers must be bit-identical.
+// Without IMGUI_ENABLE_SSE both sides run the same scalar code and the test trivially passes.
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+#include "reference/polyline_1_84.h"
+#include <string.h>
+
+static const int    POLYLINES_PER_CASE = 500;
+static int          g_Failures = 0;
+
+static void ResetDrawList(ImDrawList* draw_list, ImDrawListFlags flags)
+{
+    draw_list->_ResetForNewFrame();
+    draw_list->PushClipRectFullScreen();
+    draw_list->PushTextureID(ImGui::GetIO().Fonts->TexID);
+    draw_list->Flags = flags;
+}
+
+static void GeneratePolyline(BenchRng& rng, ImVector<ImVec2>& points)
+{
+    points.resize(rng.Int(2, 200));
+    for (int n = 0; n < points.Size; n++)
+    {
+        if (n > 0 && rng.Int(0, 15) == 0)
+            points[n] = points[n - 1]; // Degenerate segment
+        else
+            points[n] = ImVec2(rng.Float(-100.0f, 1100.0f), rng.Float(-100.0f, 900.0f));
+    }
+}
+
+static bool SameBuffers(const ImDrawList* a, const ImDrawList* b)
+{
+    return a->VtxBuffer.Size == b->VtxBuffer.Size && a->IdxBuffer.Size == b->IdxBuffer.Size
+        && memcmp(a->VtxBuffer.Data, b->VtxBuffer.Data, (size_t)a->VtxBuffer.size_in_bytes()) == 0
+        && memcmp(a->IdxBuffer.Data, b->IdxBuffer.Data, (size_t)a->IdxBuffer.size_in_bytes()) == 0;
+}
+
+static void RunCase(ImDrawList* draw_list, ImDrawList* reference, const char* name, ImDrawListFlags flags, float thickness)
+{
+    BenchRng rng;
+    ImVector<ImVec2> points;
+    int mismatches = 0, vertices = 0;
+    for (int n = 0; n < POLYLINES_PER_CASE; n++)
+    {
+        GeneratePolyline(rng, points);
+        const ImDrawFlags closed = (n & 1) ? ImDrawFlags_Closed : ImDrawFlags_None;
+        ResetDrawList(draw_list, flags);
+        ResetDrawList(reference, flags);
+        draw_list->AddPolyline(points.Data, points.Size, IM_COL32(255, 128, 64, 200), closed, thickness);
+        ReferenceAddPolyline(reference, points.Data, points.Size, IM_COL32(255, 128, 64, 200), closed, thickness);
+        vertices += draw_list->VtxBuffer.Size;
+        if (!SameBuffers(draw_list, reference))
+            mismatches++;
+    }
+    printf("%-4s %-28s thickness %.1f: %d/%d polylines differ (%d vertices)\n", mismatches ? "FAIL" : "OK", name, thickness, mismatches, POLYLINES_PER_CASE, vertices);
+    if (mismatches)
+        g_Failures++;
+}
+
+int main()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    unsigned char* pixels = NULL;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height); // Builds the atlas: TexUvWhitePixel and TexUvLines
+    ImGui::GetDrawListSharedData()->TexUvWhitePixel = io.Fonts->TexUvWhitePixel;
+    ImGui::GetDrawListSharedData()->TexUvLines = io.Fonts->TexUvLines;
+
+    ImDrawList draw_list(ImGui::GetDrawListSharedData());
+    ImDrawList reference(ImGui::GetDrawListSharedData());
+    const float thicknesses[] = { 1.0f, 1.5f, 3.0f, 6.0f };
+    for (float thickness : thicknesses)
+    {
+        RunCase(&draw_list, &reference, "anti-aliased, textured", ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex, thickness);
+        RunCase(&draw_list, &reference, "anti-aliased", ImDrawListFlags_AntiAliasedLines, thickness);
+        RunCase(&draw_list, &reference, "not anti-aliased", ImDrawListFlags_None, thickness);
+    }
+
+    ImGui::DestroyContext();
+    return g_Failures ? 1 : 0;
+}
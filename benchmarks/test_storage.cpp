@@ -0,0 +1,102 @@
+// ImGuiStorage: the hash index must return the same values as the sorted 1.84 storage (reference/storage_1_84.h) for every key.
+// Random sequences of SetInt()/GetIntRef()/SetVoidPtr()/GetInt()/GetVoidPtr() on storages of 1 to 20,000 keys, around the size where the
+// hash index starts (IM_STORAGE_LINEAR_MAX), with random keys, sequential keys and keys which only differ in their high bits.
+// Also checks storages filled through Data directly followed by BuildSortByKey(), Clear() and SetAllInt().
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+#include "reference/storage_1_84.h"
+
+static const int ROUNDS_COUNT = 400;
+
+enum KeyPattern { KeyPattern_Random, KeyPattern_Sequential, KeyPattern_HighBits, KeyPattern_COUNT };
+
+static ImGuiID MakeKey(BenchRng& rng, KeyPattern pattern, int keys_count)
+{
+    const ImU32 n = (ImU32)rng.Int(0, keys_count - 1);
+    switch (pattern)
+    {
+    case KeyPattern_Random:     return n * 0x9E3779B1u ^ 0xA5A5A5A5u;
+    case KeyPattern_Sequential: return n + 1;
+    case KeyPattern_HighBits:   return n << 20;
+    default:                    return 0;
+    }
+}
+
+// Compare every key which may be present, and absent ones.
+static bool CompareAll(const ImGuiStorage& storage, ReferenceStorage& ref, BenchRng& rng, KeyPattern pattern, int keys_count)
+{
+    for (int n = 0; n < keys_count * 2; n++)
+    {
+        const ImGuiID key = MakeKey(rng, pattern, keys_count * 2);
+        if (storage.GetInt(key, -12345) != ReferenceStorageGetInt(&ref, key, -12345))
+            return false;
+    }
+    return storage.Data.Size == ref.Data.Size;
+}
+
+int main()
+{
+    BenchRng rng;
+    int failures = 0;
+    int ops_count = 0;
+    for (int round = 0; round < ROUNDS_COUNT; round++)
+    {
+        const KeyPattern pattern = (KeyPattern)(round % KeyPattern_COUNT);
+        const int keys_count = (round % 4 == 0) ? rng.Int(1, 20) : (round % 4 == 1) ? rng.Int(1, 200) : (round % 4 == 2) ? rng.Int(1, 2000) : rng.Int(1, 20000);
+        const int ops = ImMin(keys_count * 4, 20000);
+        ImGuiStorage storage;
+        ReferenceStorage ref;
+
+        // Optionally start from a bulk fill of Data, sorted once
+        if (round % 5 == 0)
+        {
+            const int fill_count = rng.Int(0, keys_count);
+            for (int n = 0; n < fill_count; n++)
+            {
+                const ImGuiID key = MakeKey(rng, pattern, keys_count);
+                if (ReferenceStorageGetInt(&ref, key, -1) != -1)
+                    continue;
+                const int val = rng.Int(0, 1 << 20);
+                storage.Data.push_back(ImGuiStorage::ImGuiStoragePair(key, val));
+                ReferenceStorageSetInt(&ref, key, val);
+            }
+            storage.BuildSortByKey();
+        }
+
+        for (int n = 0; n < ops; n++, ops_count++)
+        {
+            const ImGuiID key = MakeKey(rng, pattern, keys_count);
+            const int val = rng.Int(0, 1 << 20);
+            switch (rng.Int(0, 5))
+            {
+            case 0: storage.SetInt(key, val); ReferenceStorageSetInt(&ref, key, val); break;
+            case 1: { int* p = storage.GetIntRef(key, val); int* p_ref = ReferenceStorageGetIntRef(&ref, key, val); failures += (*p != *p_ref); *p = *p_ref = val ^ 1; break; }
+            case 2: storage.SetVoidPtr(key, (void*)(intptr_t)val); ReferenceStorageSetVoidPtr(&ref, key, (void*)(intptr_t)val); break;
+            case 3: failures += ((ImU32)(intptr_t)storage.GetVoidPtr(key) != (ImU32)(intptr_t)ReferenceStorageGetVoidPtr(&ref, key)); break; // Upper bits are undefined after SetInt()
+            default: failures += (storage.GetInt(key, -1) != ReferenceStorageGetInt(&ref, key, -1)); break;
+            }
+        }
+        failures += !CompareAll(storage, ref, rng, pattern, keys_count);
+
+        // Sorting keeps the index valid
+        storage.BuildSortByKey();
+        failures += !CompareAll(storage, ref, rng, pattern, keys_count);
+        for (int n = 1; n < storage.Data.Size; n++)
+            failures += (storage.Data[n - 1].key >= storage.Data[n].key);
+
+        storage.SetAllInt(7);
+        for (ImGuiStorage::ImGuiStoragePair& pair : ref.Data)
+            pair.val_i = 7;
+        failures += !CompareAll(storage, ref, rng, pattern, keys_count);
+
+        storage.Clear();
+        ref.Clear();
+        failures += !CompareAll(storage, ref, rng, pattern, keys_count);
+        storage.SetInt(1, 1);
+        failures += (storage.GetInt(1) != 1);
+    }
+    printf("%-4s %d rounds, %d operations, random, sequential and high bit keys\n", failures ? "FAIL" : "OK", ROUNDS_COUNT, ops_count);
+    return failures ? 1 : 0;
+}
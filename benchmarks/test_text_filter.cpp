@@ -0,0 +1,115 @@
+// ImStristr() and ImGuiTextFilter::PassFilter() must give the same results as 1.84 (reference/text_filter_1_84.h).
+// - ImStristr(): 1,000,000 random haystacks of 0 to 100 bytes (mixed case letters, digits, punctuation, bytes >= 0x80) and needles of
+//   1 to 8 bytes, half of them taken from the haystack with their case flipped. Zero-terminated and with haystack_end.
+// - PassFilter(): 300,000 random filters of 1 to 16 terms, some excluded ("-term") or padded with blanks, so that both the per-term
+//   search and the automaton (IM_TEXT_FILTER_MATCHER_MIN_TERMS terms or more) are used. Filters are also copied, and the copy checked.
+// Ranges are followed by a zero in these checks: ImStristr() no longer matches a needle running past haystack_end, which 1.84 did
+// (it compared bytes past the end). That change is checked separately.
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "common/bench.h"
+#include "reference/text_filter_1_84.h"
+
+static const int STRISTR_COUNT = 1000000;
+static const int FILTERS_COUNT = 300000;
+static const char g_Alphabet[] = "abcdeABCDE xyzXYZ019_-.:[]\xC3\xA9\xE4\xB8\xAD";
+
+static char RandomChar(BenchRng& rng)
+{
+    return g_Alphabet[rng.Int(0, IM_ARRAYSIZE(g_Alphabet) - 2)];
+}
+
+static char FlipCase(char c)
+{
+    return (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+}
+
+int main()
+{
+    BenchRng rng;
+    int failures = 0;
+
+    // ImStristr()
+    char haystack[128];
+    char needle[16];
+    for (int n = 0; n < STRISTR_COUNT; n++)
+    {
+        const int haystack_len = rng.Int(0, 100);
+        for (int i = 0; i < haystack_len; i++)
+            haystack[i] = RandomChar(rng);
+        haystack[haystack_len] = 0;
+        const int needle_len = rng.Int(1, 8);
+        const bool from_haystack = (n & 1) && haystack_len >= needle_len;
+        const int needle_offset = from_haystack ? rng.Int(0, haystack_len - needle_len) : 0;
+        for (int i = 0; i < needle_len; i++)
+            needle[i] = from_haystack ? ((rng.Next() & 1) ? FlipCase(haystack[needle_offset + i]) : haystack[needle_offset + i]) : RandomChar(rng);
+        needle[needle_len] = 0;
+
+        failures += (ImStristr(haystack, NULL, needle, NULL) != ReferenceStristr(haystack, NULL, needle, NULL));
+        failures += (ImStristr(haystack, haystack + haystack_len, needle, needle + needle_len) != ReferenceStristr(haystack, haystack + haystack_len, needle, needle + needle_len));
+    }
+    printf("%-4s %d ImStristr() searches\n", failures ? "FAIL" : "OK", STRISTR_COUNT);
+
+    // PassFilter()
+    int filter_failures = 0;
+    int automaton_count = 0;
+    char text[128];
+    for (int n = 0; n < FILTERS_COUNT; n++)
+    {
+        const int text_len = rng.Int(0, 100);
+        for (int i = 0; i < text_len; i++)
+            text[i] = RandomChar(rng);
+        text[text_len] = 0;
+
+        ImGuiTextFilter filter;
+        char* p = filter.InputBuf;
+        const int terms_count = rng.Int(1, 16);
+        for (int term_n = 0; term_n < terms_count; term_n++)
+        {
+            if (term_n > 0)
+                *p++ = ',';
+            if (rng.Int(0, 3) == 0)
+                *p++ = ' ';
+            if (rng.Int(0, 3) == 0)
+                *p++ = '-';
+            // Terms from the text half of the time. Excluded terms are never empty: 1.84 read the byte after a lone "-" as a needle.
+            const int term_len = rng.Int(1, 6);
+            const int term_offset = (text_len >= term_len && (rng.Next() & 1)) ? rng.Int(0, text_len - term_len) : -1;
+            for (int i = 0; i < term_len; i++)
+            {
+                const char c = (term_offset >= 0) ? text[term_offset + i] : RandomChar(rng);
+                *p++ = (c == ',' || c == ' ') ? 'x' : (rng.Next() & 1) ? FlipCase(c) : c;
+            }
+        }
+        *p = 0;
+        filter.Build();
+        automaton_count += (filter.MatcherClassCount > 0);
+
+        const bool expected = ReferencePassFilter(&filter, text);
+        filter_failures += (filter.PassFilter(text) != expected) || (filter.PassFilter(text, text + text_len) != expected);
+
+        // The matcher is copied along with the filter (the terms still point into the first filter's InputBuf)
+        if (n % 16 == 0)
+        {
+            ImGuiTextFilter filter_copy = filter;
+            filter_failures += (filter_copy.PassFilter(text) != expected);
+        }
+    }
+    printf("%-4s %d PassFilter() filters (%d with the automaton)\n", filter_failures ? "FAIL" : "OK", FILTERS_COUNT, automaton_count);
+    failures += filter_failures;
+
+    // Ranges: a needle running past haystack_end is not found anymore, with either matcher
+    {
+        const char* line = "texture atlas uploaded";
+        const char* line_end = line + 9; // "texture a"
+        const bool ok_stristr = ImStristr(line, line_end, "ATLAS", NULL) == NULL && ImStristr(line, line_end, "ture A", NULL) == line + 3;
+        ImGuiTextFilter filter_one("atlas");
+        ImGuiTextFilter filter_many("atlas,bb,cc,dd,ff,gg,hh,jj");
+        const bool ok_filter = !filter_one.PassFilter(line, line_end) && !filter_many.PassFilter(line, line_end) && filter_many.MatcherClassCount > 0;
+        printf("%-4s ImStristr() and PassFilter() stop at haystack_end (1.84: %s)\n", (ok_stristr && ok_filter) ? "OK" : "FAIL",
+            ReferenceStristr(line, line_end, "ATLAS", NULL) ? "found past the end" : "not found");
+        failures += !(ok_stristr && ok_filter);
+    }
+    return failures ? 1 : 0;
+}
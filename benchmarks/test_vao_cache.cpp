@@ -0,0 +1,99 @@
+// Regression test for the per-context VAO cache of the OpenGL3 backend.
+// - test_vao_cache: the backend identifies the current context (EGL through dlsym() on Linux). 1,000 frames must create a single VAO,
+//   a second context gets its own, and each one is deleted once, from its own context.
+// - test_vao_cache_unknown_context: IMGUI_IMPL_OPENGL_GET_CURRENT_CONTEXT() returns NULL (config/unknown_gl_context.h).
+//   Every frame must create and delete a temporary VAO, and nothing may be cached under a NULL context.
+// glGenVertexArrays() and glDeleteVertexArrays() are counted by replacing the GLEW function pointers.
+
+#include "imgui.h"
+#include "impls/imgui_impl_opengl3.h"
+#include "common/bench.h"
+#include "common/gl_context.h"
+
+static const int                    FRAMES = 1000;
+static int                          g_GenCount = 0, g_DeleteCount = 0;
+static PFNGLGENVERTEXARRAYSPROC     g_RealGenVertexArrays = NULL;
+static PFNGLDELETEVERTEXARRAYSPROC  g_RealDeleteVertexArrays = NULL;
+static int                          g_Failures = 0;
+
+static void GLAPIENTRY CountingGenVertexArrays(GLsizei n, GLuint* arrays)           { g_GenCount += n; g_RealGenVertexArrays(n, arrays); }
+static void GLAPIENTRY CountingDeleteVertexArrays(GLsizei n, const GLuint* arrays)  { g_DeleteCount += n; g_RealDeleteVertexArrays(n, arrays); }
+
+static void CheckEq(const char* what, int value, int expected)
+{
+    const bool ok = (value == expected);
+    printf("%-4s %-52s %6d (expected %d)\n", ok ? "OK" : "FAIL", what, value, expected);
+    if (!ok)
+        g_Failures++;
+}
+
+static void RenderFrames(int frames)
+{
+    for (int n = 0; n < frames; n++)
+    {
+        ImGui_ImplOpenGL3_NewFrame();
+        ImGui::NewFrame();
+        ImGui::Begin("Window");
+        ImGui::Text("Frame %d", n);
+        ImGui::End();
+        ImGui::Render();
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }
+}
+
+int main()
+{
+    if (!BenchGL_CreateContext(3, 3, 800, 600))
+    {
+        printf("No OpenGL 3.3 context available, skipped.\n");
+        return BENCH_EXIT_SKIPPED;
+    }
+    g_RealGenVertexArrays = glGenVertexArrays;
+    g_RealDeleteVertexArrays = glDeleteVertexArrays;
+    glGenVertexArrays = CountingGenVertexArrays;
+    glDeleteVertexArrays = CountingDeleteVertexArrays;
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(800.0f, 600.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui_ImplOpenGL3_Init("#version 330 core");
+
+#ifdef BENCH_UNKNOWN_CONTEXT
+    const bool cached = false;
+#else
+    const bool cached = true;
+#endif
+
+    RenderFrames(FRAMES);
+    CheckEq("glGenVertexArrays, 1000 frames", g_GenCount, cached ? 1 : FRAMES);
+    CheckEq("glDeleteVertexArrays, 1000 frames", g_DeleteCount, cached ? 0 : FRAMES);
+
+    // A second context, sharing objects with the first one: VAO aren't shared, so it needs its own.
+    void* shared_context = BenchGL_CreateSharedContext(3, 3);
+    if (shared_context != NULL)
+    {
+        const int gen_before = g_GenCount, delete_before = g_DeleteCount;
+        BenchGL_MakeCurrent(shared_context);
+        RenderFrames(10);
+        CheckEq("glGenVertexArrays, 10 frames on a second context", g_GenCount - gen_before, cached ? 1 : 10);
+        ImGui_ImplOpenGL3_DestroyContextObjects();
+        CheckEq("glDeleteVertexArrays, second context", g_DeleteCount - delete_before, cached ? 1 : 10);
+        BenchGL_MakeCurrent(NULL);
+        BenchGL_DestroySharedContext(shared_context);
+    }
+
+    // Back on the first context: its VAO is still cached.
+    const int gen_before = g_GenCount;
+    RenderFrames(10);
+    CheckEq("glGenVertexArrays, 10 more frames on the first context", g_GenCount - gen_before, cached ? 0 : 10);
+
+    ImGui_ImplOpenGL3_Shutdown();
+    CheckEq("VAO leaked after shutdown", g_GenCount - g_DeleteCount, 0);
+    CheckEq("glGetError()", (int)glGetError(), 0);
+
+    ImGui::DestroyContext();
+    BenchGL_DestroyContext();
+    return g_Failures ? 1 : 0;
+}
@@ -0,0 +1,107 @@
+// X11 platform backend: ImGui_ImplX11_SetEventDriven() must remove the per-frame server round-trips of ImGui_ImplX11_NewFrame()
+// while keeping the mouse position and display size up to date from the events.
+// Needs an X server: CTest runs it under 'xvfb-run -a' when available, otherwise on $DISPLAY. Skipped (exit code 77) when neither works.
+// - Requests sent to the server by NewFrame() are counted with XNextRequest(): 3 per frame when polling
+//   (XGetGeometry, XQueryKeymap, XQueryPointer), none in event-driven mode.
+// - The pointer is moved with XWarpPointer() and the window resized with XResizeWindow(): the resulting MotionNotify and ConfigureNotify
+//   events are forwarded to ImGui_ImplX11_EventHandler() and must show up in io.MousePos and io.DisplaySize.
+// - Also prints the average NewFrame() latency in both modes (not checked: it depends on the server and the connection).
+
+#include "imgui.h"
+#include "impls/linux/imgui_impl_x11.h"
+#include "common/bench.h"
+#include <X11/Xlib.h>
+
+IMGUI_IMPL_API int ImGui_ImplX11_EventHandler(XEvent& event);
+
+static const int    FRAMES = 1000;
+static int          g_Failures = 0;
+
+static void Check(bool ok, const char* what)
+{
+    printf("%-4s %s\n", ok ? "OK" : "FAIL", what);
+    if (!ok)
+        g_Failures++;
+}
+
+static void ProcessEvents(Display* display)
+{
+    XSync(display, False);
+    while (XPending(display))
+    {
+        XEvent event;
+        XNextEvent(display, &event);
+        ImGui_ImplX11_EventHandler(event);
+    }
+}
+
+// Returns the average number of requests sent to the server per NewFrame() call, and the average NewFrame() wall time in 'out_us'.
+static double RunFrames(Display* display, double* out_us)
+{
+    // The first frame may fetch and cache the keyboard mapping: not counted.
+    ImGui_ImplX11_NewFrame();
+    ImGui::NewFrame();
+    ImGui::Render();
+
+    const unsigned long first_request = XNextRequest(display);
+    double total = 0.0;
+    for (int n = 0; n < FRAMES; n++)
+    {
+        const double t0 = BenchGetWallTime();
+        ImGui_ImplX11_NewFrame();
+        total += BenchGetWallTime() - t0;
+        ImGui::NewFrame();
+        ImGui::Render();
+    }
+    *out_us = total * 1e6 / FRAMES;
+    return (double)(XNextRequest(display) - first_request) / FRAMES;
+}
+
+int main()
+{
+    Display* display = XOpenDisplay(NULL);
+    if (display == NULL)
+    {
+        printf("No X server available, skipped.\n");
+        return BENCH_EXIT_SKIPPED;
+    }
+    Window window = XCreateSimpleWindow(display, DefaultRootWindow(display), 0, 0, 640, 480, 0, 0, 0);
+    XSelectInput(display, window, ExposureMask);
+    XMapWindow(display, window);
+    XSync(display, False);
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.Fonts->Build();
+    ImGui_ImplX11_Init(display, (void*)window);
+
+    // Polling mode
+    double polling_us = 0.0;
+    const double polling_requests = RunFrames(display, &polling_us);
+    printf("polling:      %.2f requests/frame, NewFrame() %.1f us\n", polling_requests, polling_us);
+    Check(polling_requests >= 3.0, "polling mode: XGetGeometry, XQueryKeymap and XQueryPointer in NewFrame()");
+
+    // Event-driven mode
+    ImGui_ImplX11_SetEventDriven(true);
+    ProcessEvents(display);
+    double event_driven_us = 0.0;
+    const double event_driven_requests = RunFrames(display, &event_driven_us);
+    printf("event-driven: %.2f requests/frame, NewFrame() %.1f us\n", event_driven_requests, event_driven_us);
+    Check(event_driven_requests == 0.0, "event-driven mode: no request in NewFrame()");
+
+    XWarpPointer(display, None, window, 0, 0, 0, 0, 123, 45);
+    ProcessEvents(display);
+    Check(io.MousePos.x == 123.0f && io.MousePos.y == 45.0f, "event-driven mode: mouse position from MotionNotify");
+
+    XResizeWindow(display, window, 800, 600);
+    ProcessEvents(display);
+    ImGui_ImplX11_NewFrame();
+    Check(io.DisplaySize.x == 800.0f && io.DisplaySize.y == 600.0f, "event-driven mode: display size from ConfigureNotify");
+
+    ImGui_ImplX11_Shutdown();
+    ImGui::DestroyContext();
+    XDestroyWindow(display, window);
+    XCloseDisplay(display);
+    return g_Failures ? 1 : 0;
+}